@@ -4,26 +4,77 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/Aggregation.cpp \
 ../src/Column.cpp \
+../src/CsvLoader.cpp \
 ../src/Database.cpp \
-../src/Table.cpp 
+../src/Filter.cpp \
+../src/Index.cpp \
+../src/Join.cpp \
+../src/Lexer.cpp \
+../src/MappedFile.cpp \
+../src/Output.cpp \
+../src/Parser.cpp \
+../src/Predicate.cpp \
+../src/ResultSink.cpp \
+../src/RowCursor.cpp \
+../src/Server.cpp \
+../src/Sorter.cpp \
+../src/StatementReader.cpp \
+../src/Table.cpp \
+../src/Transaction.cpp \
+../src/WriteAheadLog.cpp 
 
 OBJS += \
+./src/Aggregation.o \
 ./src/Column.o \
+./src/CsvLoader.o \
 ./src/Database.o \
-./src/Table.o 
+./src/Filter.o \
+./src/Index.o \
+./src/Join.o \
+./src/Lexer.o \
+./src/MappedFile.o \
+./src/Output.o \
+./src/Parser.o \
+./src/Predicate.o \
+./src/ResultSink.o \
+./src/RowCursor.o \
+./src/Server.o \
+./src/Sorter.o \
+./src/StatementReader.o \
+./src/Table.o \
+./src/Transaction.o \
+./src/WriteAheadLog.o 
 
 CPP_DEPS += \
+./src/Aggregation.d \
 ./src/Column.d \
+./src/CsvLoader.d \
 ./src/Database.d \
-./src/Table.d 
+./src/Filter.d \
+./src/Index.d \
+./src/Join.d \
+./src/Lexer.d \
+./src/MappedFile.d \
+./src/Output.d \
+./src/Parser.d \
+./src/Predicate.d \
+./src/ResultSink.d \
+./src/RowCursor.d \
+./src/Server.d \
+./src/Sorter.d \
+./src/StatementReader.d \
+./src/Table.d \
+./src/Transaction.d \
+./src/WriteAheadLog.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 src/%.o: ../src/%.cpp
 	@echo 'Building file: $<'
 	@echo 'Invoking: GCC C++ Compiler'
-	g++ -std=c++1y -O0 -g3 -Wall -c -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
+	g++ -std=c++1y -O0 -g3 -Wall -c -pthread -fmessage-length=0 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -0,0 +1,88 @@
+/*!
+ * \file Aggregation.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Aggregation Class
+ *
+ */
+
+#ifndef AGGREGATION_H
+#define AGGREGATION_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Column.h"
+#include "ResultSink.h"
+#include "Statement.h"
+
+/*!
+ * \class Aggregation
+ *
+ * \brief This class computes the aggregates of a select by group
+ *
+ * This class runs COUNT, SUM, AVG, MIN and MAX over the columns of a table,
+ * one result row per distinct value of the GROUP BY columns. The rows are
+ * first given a group number through a hash table keyed by the grouped
+ * values, then each aggregate is computed in one pass over its column
+ * straight from the typed arrays. Without a GROUP BY clause every row is
+ * in one group and the passes need no group numbers at all.
+ *
+ * The results are kept in columns named after the aggregates so they can
+ * be written through a ResultSink like any other result. SUM of an int
+ * column is a float so that it cannot overflow, and the aggregates other
+ * than COUNT are empty when no row was aggregated. The groups are written
+ * in the order they were found unless ORDER BY names selected columns or
+ * aggregates, which are then ordered like the columns of a table.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Aggregation {
+public:
+    Aggregation(const std::vector<Column> &newColumns); ///Default constructor
+    virtual ~Aggregation(); ///Default deconstructor
+
+    bool bind(const std::vector<SelectItem> &items, const std::vector<std::string> &groupBy,
+        const std::vector<OrderItem> &orderBy); ///Function to find the aggregated columns
+    void run(const std::vector<size_t> *rows, size_t rowNum); ///Function to aggregate the rows
+    void write(ResultSink &sink, size_t limit) const; ///Function to write the result rows
+protected:
+    /** Kinds of result columns **/
+    enum Function { GROUP, COUNT, SUM, AVG, MIN, MAX };
+
+    /*!
+     * \struct Output
+     *
+     * \brief Column of the result
+     */
+    struct Output {
+        Function function; ///Aggregate giving the column
+        int col; ///Position of the aggregated column, -1 for COUNT(*)
+    };
+
+    int findColumn(const std::string &name) const; ///Function to get the position of a column
+    void assignGroups(const std::vector<size_t> *rows, size_t count); ///Function to number the groups of the rows
+    void sum(const Output &output, const std::vector<size_t> *rows, size_t count,
+        std::vector<double> &sums) const; ///Function to sum a column by group
+    void extreme(const Output &output, const std::vector<size_t> *rows, size_t count,
+        std::vector<size_t> &best) const; ///Function to find the lowest or highest row of each group
+
+    const std::vector<Column> &columns; ///Columns of the table
+    std::vector<size_t> groupCols; ///Positions of the GROUP BY columns
+    std::vector<Output> outputs; ///Columns of the result in order
+    std::vector<std::pair<size_t, bool>> orderCols; ///Result columns the groups are ordered by and if descending
+    std::vector<Column> results; ///Values of the result columns, one row per group
+    std::vector<uint32_t> groupOf; ///Group of each aggregated row
+    std::vector<size_t> firstRows; ///First row of each group
+    std::vector<size_t> groupSizes; ///Number of rows in each group
+    bool empty; ///Bool if no row was aggregated without a GROUP BY clause
+};
+
+#endif // AGGREGATION_H
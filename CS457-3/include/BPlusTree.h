@@ -0,0 +1,307 @@
+/*!
+ * \file BPlusTree.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for BPlusTree Class
+ *
+ */
+
+#ifndef BPLUSTREE_H
+#define BPLUSTREE_H
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*!
+ * \class BPlusTree
+ *
+ * \brief This class maps ordered keys to values in a B+-tree
+ *
+ * This class keeps its keys sorted in wide nodes so a lookup touches only
+ * a few nodes. Values are held in the leaves and the leaves are chained in
+ * key order, so a range is read by finding its first key and following the
+ * chain. Keys are never removed one by one, a tree that shrinks is rebuilt
+ * with bulkLoad instead.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+template <typename Key, typename Mapped>
+class BPlusTree {
+protected:
+    static const size_t ORDER = 64; ///Most keys held in a node
+
+    /*!
+     * \struct Node
+     *
+     * \brief Inner node or leaf of the tree
+     *
+     * An inner node holds one more child than keys, where key i is the
+     * first key of child i + 1. A leaf holds a value for each key.
+     */
+    struct Node {
+        bool leaf = true; ///Bool if the node is a leaf
+        std::vector<Key> keys; ///Sorted keys of the node
+        std::vector<std::unique_ptr<Node>> children; ///Children of an inner node
+        std::vector<Mapped> values; ///Values of a leaf
+        Node *next = nullptr; ///Next leaf in key order
+    };
+
+public:
+    /*!
+     * \class Iterator
+     *
+     * \brief Position of a key in the chain of leaves
+     */
+    class Iterator {
+    public:
+        Iterator(Node *newNode = nullptr, size_t newSlot = 0) : node(newNode), slot(newSlot) {
+            skipEmpty();
+        }
+        bool valid() const { return node != nullptr; } ///True until the last key is passed
+        const Key &key() const { return node->keys[slot]; } ///Key at the position
+        Mapped &value() const { return node->values[slot]; } ///Value at the position
+        void advance() { ///Move to the next key
+            slot++;
+            skipEmpty();
+        }
+    protected:
+        void skipEmpty() { ///Move past the end of a leaf
+            while (node != nullptr && slot >= node->keys.size()) {
+                node = node->next;
+                slot = 0;
+            }
+        }
+        Node *node; ///Leaf holding the position
+        size_t slot; ///Position in the leaf
+    };
+
+    BPlusTree() : root(new Node()), count(0) {} ///Default constructor
+
+    size_t size() const { return count; } ///Number of keys in the tree
+
+    /*!
+     * \brief Remove every key
+     */
+    void clear() {
+        root.reset(new Node());
+        count = 0;
+    }
+    /*!
+     * \brief Value of a key
+     *
+     * \param[in] Key key
+     *            Key to look up
+     * \return Mapped pointer to the value, or nullptr if the key is missing
+     */
+    Mapped *find(const Key &key) const {
+        Node *leaf = findLeaf(key);
+        auto found = std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key);
+        if (found == leaf->keys.end() || key < *found)
+            return nullptr;
+        return &leaf->values[found - leaf->keys.begin()];
+    }
+    /*!
+     * \brief Value of a key, adding the key if it is missing
+     *
+     * \param[in] Key key
+     *            Key to look up
+     * \param[in] Mapped value
+     *            Value given to a key that is added
+     * \return Mapped reference to the value of the key
+     */
+    Mapped &insert(const Key &key, const Mapped &value) {
+        Key splitKey; ///First key of a node split off the root
+        std::unique_ptr<Node> split; ///Node split off the root
+        Mapped *stored = insertInto(root.get(), key, value, splitKey, split);
+
+        /** Grow a new root over a split root **/
+        if (split) {
+            std::unique_ptr<Node> newRoot(new Node());
+            newRoot->leaf = false;
+            newRoot->keys.push_back(splitKey);
+            newRoot->children.push_back(std::move(root));
+            newRoot->children.push_back(std::move(split));
+            root = std::move(newRoot);
+        }
+        return *stored;
+    }
+    /*!
+     * \brief Replace the tree with sorted entries
+     *
+     * This function will build the tree bottom up from entries sorted by
+     * key with no key repeated, filling every node.
+     *
+     * \param[in] vector<pair<Key, Mapped>> entries
+     *            Sorted keys and their values
+     */
+    void bulkLoad(std::vector<std::pair<Key, Mapped>> &entries) {
+        std::vector<std::pair<Key, std::unique_ptr<Node>>> level; ///Nodes of the level being built
+        Node *previous = nullptr; ///Last leaf built
+
+        clear();
+        if (entries.empty())
+            return;
+
+        /** Fill the leaves and chain them **/
+        for (size_t i = 0; i < entries.size(); i += ORDER) {
+            std::unique_ptr<Node> leaf(new Node());
+            for (size_t j = i; j < entries.size() && j < i + ORDER; j++) {
+                leaf->keys.push_back(std::move(entries[j].first));
+                leaf->values.push_back(std::move(entries[j].second));
+            }
+            if (previous != nullptr)
+                previous->next = leaf.get();
+            previous = leaf.get();
+            Key first = leaf->keys.front(); ///First key under the leaf
+            level.push_back(std::make_pair(std::move(first), std::move(leaf)));
+        }
+        count = entries.size();
+
+        /** Build inner levels until a single root is left **/
+        while (level.size() > 1) {
+            std::vector<std::pair<Key, std::unique_ptr<Node>>> parents; ///Nodes of the next level
+            for (size_t i = 0; i < level.size(); i += ORDER + 1) {
+                std::unique_ptr<Node> parent(new Node());
+                parent->leaf = false;
+                for (size_t j = i; j < level.size() && j < i + ORDER + 1; j++) {
+                    if (j != i)
+                        parent->keys.push_back(level[j].first);
+                    parent->children.push_back(std::move(level[j].second));
+                }
+                parents.push_back(std::make_pair(std::move(level[i].first), std::move(parent)));
+            }
+            level.swap(parents);
+        }
+        root = std::move(level.front().second);
+    }
+    /*!
+     * \brief Position of the smallest key
+     *
+     * \return Iterator at the first key
+     */
+    Iterator begin() const {
+        Node *node = root.get();
+        while (!node->leaf)
+            node = node->children.front().get();
+        return Iterator(node, 0);
+    }
+    /*!
+     * \brief Position of the first key not less than a key
+     *
+     * \param[in] Key key
+     *            Key to search for
+     * \return Iterator at the first key at or after key
+     */
+    Iterator lowerBound(const Key &key) const {
+        Node *leaf = findLeaf(key);
+        return Iterator(leaf, std::lower_bound(leaf->keys.begin(), leaf->keys.end(), key) - leaf->keys.begin());
+    }
+    /*!
+     * \brief Position of the first key greater than a key
+     *
+     * \param[in] Key key
+     *            Key to search for
+     * \return Iterator at the first key after key
+     */
+    Iterator upperBound(const Key &key) const {
+        Node *leaf = findLeaf(key);
+        return Iterator(leaf, std::upper_bound(leaf->keys.begin(), leaf->keys.end(), key) - leaf->keys.begin());
+    }
+
+protected:
+    /*!
+     * \brief Leaf a key belongs in
+     *
+     * \param[in] Key key
+     *            Key to search for
+     * \return Node pointer to the leaf
+     */
+    Node *findLeaf(const Key &key) const {
+        Node *node = root.get();
+        while (!node->leaf)
+            node = node->children[std::upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin()].get();
+        return node;
+    }
+    /*!
+     * \brief Insert below a node, splitting it if it overflows
+     *
+     * \param[in] Node node
+     *            Node to insert below
+     * \param[in] Key key
+     *            Key to insert
+     * \param[in] Mapped value
+     *            Value given to a key that is added
+     * \param[out] Key splitKey
+     *             First key of the split off node
+     * \param[out] unique_ptr<Node> split
+     *             Node split off the right half, left empty if no split
+     * \return Mapped pointer to the value of the key
+     */
+    Mapped *insertInto(Node *node, const Key &key, const Mapped &value, Key &splitKey,
+        std::unique_ptr<Node> &split) {
+        Mapped *stored; ///Value of the key
+        size_t slot; ///Position of the key or child in the node
+
+        if (node->leaf) {
+            slot = std::lower_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+            if (slot < node->keys.size() && !(key < node->keys[slot]))
+                return &node->values[slot];
+            node->keys.insert(node->keys.begin() + slot, key);
+            node->values.insert(node->values.begin() + slot, value);
+            count++;
+            if (node->keys.size() <= ORDER)
+                return &node->values[slot];
+
+            /** Move the right half of a full leaf to a new leaf **/
+            size_t half = node->keys.size() / 2; ///First key moved
+            split.reset(new Node());
+            split->keys.assign(std::make_move_iterator(node->keys.begin() + half),
+                std::make_move_iterator(node->keys.end()));
+            split->values.assign(std::make_move_iterator(node->values.begin() + half),
+                std::make_move_iterator(node->values.end()));
+            node->keys.resize(half);
+            node->values.resize(half);
+            split->next = node->next;
+            node->next = split.get();
+            splitKey = split->keys.front();
+            return slot < half ? &node->values[slot] : &split->values[slot - half];
+        }
+
+        /** Insert below the child covering the key **/
+        Key childKey; ///First key of a split child
+        std::unique_ptr<Node> childSplit; ///Node split off the child
+        slot = std::upper_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+        stored = insertInto(node->children[slot].get(), key, value, childKey, childSplit);
+        if (!childSplit)
+            return stored;
+        node->keys.insert(node->keys.begin() + slot, childKey);
+        node->children.insert(node->children.begin() + slot + 1, std::move(childSplit));
+        if (node->keys.size() <= ORDER)
+            return stored;
+
+        /** Move the right half of a full inner node, promoting its middle key **/
+        size_t half = node->keys.size() / 2; ///Key promoted to the parent
+        split.reset(new Node());
+        split->leaf = false;
+        splitKey = node->keys[half];
+        split->keys.assign(std::make_move_iterator(node->keys.begin() + half + 1),
+            std::make_move_iterator(node->keys.end()));
+        split->children.assign(std::make_move_iterator(node->children.begin() + half + 1),
+            std::make_move_iterator(node->children.end()));
+        node->keys.resize(half);
+        node->children.resize(half + 1);
+        return stored;
+    }
+
+    std::unique_ptr<Node> root; ///Root node of the tree
+    size_t count; ///Number of keys in the tree
+};
+
+#endif // BPLUSTREE_H
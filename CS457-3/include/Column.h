@@ -13,9 +13,33 @@
 #ifndef COLUMN_H
 #define COLUMN_H
 
+#include <cstdint>
+#include <experimental/string_view>
+#include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
+#include "MappedFile.h"
+
+/*!
+ * \struct Value
+ *
+ * \brief A literal parsed once against a column type
+ *
+ * Holds a user supplied literal in its native form so that comparisons
+ * against a column do not need to reparse the text for every row. Numeric
+ * literals keep both an integer and a floating point form so an int column
+ * can be compared with a float literal and the other way around.
+ */
+struct Value {
+	bool valid = false; ///Bool if the literal could be parsed for the column
+	bool integral = false; ///Bool if the literal is a whole number
+	int64_t intValue = 0; ///Integer form of a numeric literal
+	double floatValue = 0; ///Floating point form of a numeric literal
+	std::string charValue; ///Unquoted form of a char literal
+};
+
 /*!
  * \class Column
  *
@@ -25,19 +49,112 @@
  * This virtual column will allow for easier data manipulation as
  * the data will be already loaded in the program.
  *
+ * The data is stored by type. Int columns use a contiguous array of
+ * int32 values, float columns a contiguous array of doubles, and char or
+ * varchar columns an offsets array into a single byte buffer. Char values
+ * are kept without their surrounding quotes.
+ *
+ * A column read from a table file points straight into the mapped file
+ * and only copies its data into owned storage once it is changed.
+ *
+ * Owned storage is shared by the snapshots of the column, which read the
+ * rows it held when they were taken. Rows appended within the capacity of
+ * the storage lie past every snapshot and are written in place. Any other
+ * change to shared storage is made to a copy, so a snapshot never sees a
+ * row move or change under it.
+ *
  * \author Christopher Mollise
  * \date 5/6/20
  */
 class Column {
 	public:
+		/** Storage layouts picked from the column type **/
+		enum Layout { INT_LAYOUT, FLOAT_LAYOUT, CHAR_LAYOUT };
+
 		/** Default Constructor **/
 		Column(std::string newColName, std::string newColType, int newColSize);
 		virtual ~Column();///Default deconstructor
 
-		std::vector<std::string> colData; ///Vector of strings for data
+		size_t size() const; ///Number of rows held in the column
+		bool isChar() const; ///True for char and varchar columns
+		bool parse(const std::string &literal, Value &value) const; ///Parse literal for the column
+		bool fits(const Value &value) const; ///Check a parsed value can be stored
+		bool append(const Value &value); ///Append a parsed value as a new row
+		bool appendLiteral(const std::string &literal); ///Parse and append a literal
+		bool appendField(const char *field, size_t length); ///Parse and append a data file field
+		void appendColumn(const Column &other); ///Append every row of another column
+		void appendRow(const Column &other, size_t row); ///Append one row of another column
+		void assign(const std::vector<size_t> &rows, const Value &value); ///Set value at rows
+		void popBack(); ///Remove the last row
+		void compact(const std::vector<bool> &erased); ///Remove the marked rows
+		int compare(size_t row, const Value &value) const; ///Compare a row to a value
+		bool equalRows(size_t row, const Column &other, size_t otherRow) const; ///Compare two rows
+		int compareRows(size_t row, const Column &other, size_t otherRow) const; ///Order two rows
+
+		void encode(size_t row, std::string &record) const; ///Append the row to a log record
+		bool decode(const char *&cursor, const char *end); ///Append a row read from a log record
+
+		void map(std::shared_ptr<MappedFile> file, const char *segment, size_t rows); ///Read from a mapping
+		void materialize(); ///Copy mapped rows into owned storage
+		Column snapshot() const; ///Read only copy of the rows held now
+		size_t segmentLength() const; ///Bytes of the column in a table file
+		void writeSegment(std::ostream &out) const; ///Write the column to a table file
+		static size_t segmentLength(Layout layout, const char *segment, size_t rows); ///Bytes of a stored segment
+
+		/** Raw access to the typed data, valid until the column changes **/
+		const int32_t *intValues() const {
+			return mapping ? reinterpret_cast<const int32_t *>(mappedSegment) : storage->intData.data();
+		}
+		const double *floatValues() const {
+			return mapping ? reinterpret_cast<const double *>(mappedSegment) : storage->floatData.data();
+		}
+		const uint32_t *charOffsetValues() const {
+			return mapping ? reinterpret_cast<const uint32_t *>(mappedSegment) : storage->charOffsets.data();
+		}
+		const char *charByteValues() const {
+			return mapping ? mappedBytes : storage->charBytes.data();
+		}
+
+		int32_t getInt(size_t row) const { return intValues()[row]; } ///Int value at row
+		double getFloat(size_t row) const { return floatValues()[row]; } ///Float value at row
+		std::experimental::string_view getChars(size_t row) const { ///Char value at row
+			const uint32_t *offsets = charOffsetValues();
+			return std::experimental::string_view(charByteValues() + offsets[row],
+				offsets[row + 1] - offsets[row]);
+		}
+		std::string toString(size_t row) const; ///Printable form of the row
+		std::string toLiteral(size_t row) const; ///Literal form of the row for files
+		std::experimental::string_view format(size_t row, char *buffer) const; ///Printable view of the row
+
+		static std::string formatFloat(double value); ///Shortest text for a float
+		static size_t formatFloat(double value, char *buffer); ///Shortest text for a float into a buffer
+
+		Layout layout; ///Storage layout picked from colType
 		std::string colName; ///String of the column name
 		std::string colType; ///String of the column type
 		int colSize; ///Int of the column size
+	protected:
+		/*!
+		 * \struct Storage
+		 *
+		 * \brief Owned data of a column, shared with its snapshots
+		 */
+		struct Storage {
+			std::vector<int32_t> intData; ///Contiguous data of an int column
+			std::vector<double> floatData; ///Contiguous data of a float column
+			std::vector<uint32_t> charOffsets; ///Row offsets into charBytes, one past the rows
+			std::string charBytes; ///Concatenated data of a char column
+		};
+
+		static const size_t IN_PLACE = (size_t)-1; ///Rows passed to own for a change to the rows held
+
+		void own(size_t rows, size_t bytes); ///Make the storage safe to change
+
+		std::shared_ptr<Storage> storage; ///Owned data, null while the column is mapped
+		std::shared_ptr<const void> mapping; ///Mapped file or storage of another column the data is read from
+		const char *mappedSegment = nullptr; ///Start of the numbers or char offsets in the mapping
+		const char *mappedBytes = nullptr; ///Start of the char bytes in the mapping
+		size_t mappedRows = 0; ///Number of rows in the mapping
 };
 
 #endif // COLUMN_H
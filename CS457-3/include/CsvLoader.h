@@ -0,0 +1,76 @@
+/*!
+ * \file CsvLoader.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for CsvLoader Class
+ *
+ */
+
+#ifndef CSVLOADER_H
+#define CSVLOADER_H
+
+#include <string>
+#include <vector>
+
+#include "Column.h"
+
+/*!
+ * \class CsvLoader
+ *
+ * \brief This class parses delimited text into columns
+ *
+ * This class reads the rows of a CSV or TSV file for COPY FROM. The text
+ * is split into chunks at line ends and every chunk is parsed on its own
+ * thread into columns shaped like the table, with each field parsed
+ * straight from the text into the column storage. The chunks are appended
+ * to the table in order once all of them parsed, so the table is only
+ * changed if every row is valid.
+ *
+ * A field may be quoted with " to hold the delimiter, with "" standing for
+ * a quote inside it. Quoted fields may not span lines.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class CsvLoader {
+public:
+    static const size_t CHUNK_BYTES = 1 << 22; ///Least amount of text given to a thread
+
+    CsvLoader(const std::vector<Column> &newSchema, char newDelimiter); ///Default constructor
+    virtual ~CsvLoader(); ///Default deconstructor
+
+    bool parse(const char *data, size_t size); ///Function to parse the text
+    void appendTo(std::vector<Column> &columns) const; ///Function to append the parsed rows
+    size_t rowCount() const; ///Function to get the number of parsed rows
+
+    size_t failedLine; ///Line of the first invalid row
+    int failedColumn; ///Column of the invalid field, -1 if the row had the wrong number of fields
+    std::string failedField; ///Text of the invalid field
+protected:
+    /*!
+     * \struct Chunk
+     *
+     * \brief A run of whole lines parsed by one thread
+     */
+    struct Chunk {
+        const char *begin; ///Start of the text
+        const char *end; ///End of the text
+        std::vector<Column> columns; ///Rows parsed from the text
+        size_t lines = 0; ///Number of lines read
+        bool failed = false; ///Bool if a row was invalid
+        int failedColumn = -1; ///Column of the invalid field
+        std::string failedField; ///Text of the invalid field
+    };
+
+    void parseChunk(Chunk &chunk) const; ///Function to parse the lines of a chunk
+
+    const std::vector<Column> &schema; ///Columns of the table being loaded
+    char delimiter; ///Character separating the fields
+    std::vector<Chunk> chunks; ///Chunks of the text in order
+};
+
+#endif // CSVLOADER_H
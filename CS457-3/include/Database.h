@@ -13,10 +13,18 @@
 #ifndef DATABASE_H
 #define DATABASE_H
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "Join.h"
+#include "Predicate.h"
+#include "Statement.h"
 #include "Table.h"
+#include "Transaction.h"
+#include "WriteAheadLog.h"
 
 /*!
  * \class Database
@@ -27,6 +35,15 @@
  * This virtual database will allow for easier data manipulation as
  * the data will be already loaded in the program.
  *
+ * The changes to the tables of a database go to its write-ahead log, which
+ * is replayed over the table files when the database is opened and emptied
+ * by a checkpoint. Statements between BEGIN and COMMIT form a transaction
+ * whose changes are logged together at COMMIT.
+ *
+ * A database may be shared by the sessions of the server. Each statement
+ * changing the database holds its latch while it runs, while queries read
+ * snapshots of the tables without it.
+ *
  * \author Christopher Mollise
  * \date 5/6/20
  */
@@ -35,22 +52,45 @@ public:
     Database(std::string path); ///Default Constructor
     virtual ~Database(); ///Default Deconstructor
 
-    std::string dataBaseParser(); ///Function to act as secondary parser
+    bool execute(const Statement &statement,
+        std::shared_ptr<Transaction> &transaction); ///Function to run a statement on the tables
+    void rollback(std::shared_ptr<Transaction> &transaction); ///Function to undo a transaction left open
+    void commit(); ///Function to make the logged changes durable
+    void checkpoint(); ///Function to write the changed tables and empty the log
 
     std::string actualName; ///String containing the actual database name
     std::string dataBaseName; ///String containing the usuable database name
 protected:
-    bool createTable(); ///Function to create table
-    bool dropTable(); ///Function to drop table
-    bool selectTable(); ///Function to select table
-    bool innerJoin(std::string firstTable);///Function to inner join table
-    bool outerJoin(std::string firstTable);///Function to outer join table
-    bool alterTable(); ///Function to alter table
-    bool insertTable(); ///Function to insert into table
-    bool updateTable(); ///Function to update table
-    bool deleteFromTable(); ///Function to delete from table
-
-    std::vector <Table> tables; ///Vector containing Table objects
+    std::shared_ptr<Table> findTable(std::string name, bool matchCase = false); ///Function to find table by name
+    std::shared_ptr<Table> readTable(const std::shared_ptr<Table> &inputTable,
+        Transaction *transaction); ///Function to get the rows a query reads
+    bool createTable(const CreateTableStatement &statement); ///Function to create table
+    bool dropTable(const NameStatement &statement); ///Function to drop table
+    bool createIndex(const CreateIndexStatement &statement); ///Function to create index
+    bool dropIndex(const NameStatement &statement); ///Function to drop index
+    bool selectTable(const SelectStatement &statement, Transaction *transaction); ///Function to select table
+    bool explainSelect(const SelectStatement &statement,
+        Transaction *transaction); ///Function to print the plan of a select
+    bool planJoin(const SelectStatement &statement, Transaction *transaction,
+        std::vector<std::shared_ptr<Table>> &handles, std::vector<Join::Step> &steps,
+        Predicate &filter); ///Function to order the tables of a join and pick their algorithms
+    bool joinRows(const SelectStatement &statement, Transaction *transaction,
+        std::vector<std::shared_ptr<Table>> &handles, Join::Tuples &tuples); ///Function to find the joined rows
+    bool joinTables(const SelectStatement &statement, Transaction *transaction); ///Function to list the joined rows
+    bool alterTable(const AlterTableStatement &statement); ///Function to alter table
+    bool insertTable(const InsertStatement &statement, Transaction *transaction); ///Function to insert into table
+    bool copyTable(const CopyStatement &statement,
+        Transaction *transaction); ///Function to copy a data file into or out of table
+    bool updateTable(const UpdateStatement &statement, Transaction *transaction); ///Function to update table
+    bool deleteFromTable(const DeleteStatement &statement,
+        Transaction *transaction); ///Function to delete from table
+    bool lockTable(Table &table, Transaction *transaction, const char *action); ///Function to lock a table for a change
+    bool locked() const; ///Function to check for tables locked by a transaction
+
+    std::unordered_map<std::string, std::shared_ptr<Table>> tables; ///Map of lowercase table names to Table objects
+    std::shared_ptr<WriteAheadLog> wal; ///Write-ahead log shared by the tables
+    std::mutex latch; ///Latch held while a statement changes the database
+    std::mutex tablesLatch; ///Latch held while the table map is read by a query or changed
 };
 
 #endif // DATABASE_H
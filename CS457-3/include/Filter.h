@@ -0,0 +1,53 @@
+/*!
+ * \file Filter.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Filter Class
+ *
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Column.h"
+#include "Predicate.h"
+
+/*!
+ * \class Filter
+ *
+ * \brief This class compares a batch of column rows at a time
+ *
+ * This class holds the comparison kernels used to scan a column. A kernel
+ * compares a batch of up to BATCH_ROWS rows and writes one bit per row to a
+ * bitmap, so the comparisons of an expression can be combined with bitwise
+ * operations and turned into row numbers once per batch.
+ *
+ * Int and float columns are compared with SIMD instructions straight from
+ * the typed arrays, using AVX2 when the processor has it and SSE2
+ * otherwise on x86, and a scalar loop on other processors. Char columns
+ * and comparisons of two columns are compared a row at a time.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Filter {
+public:
+    static const size_t BATCH_ROWS = 1024; ///Number of rows compared at a time
+    static const size_t BATCH_WORDS = BATCH_ROWS / 64; ///Number of bitmap words of a batch
+
+    static void compare(const Column &column, size_t first, size_t count, Predicate::Op op,
+        const Value &value, uint64_t *bits); ///Function to compare a batch of rows with a value
+    static void compareRows(const Column &column, const Column &other, size_t first, size_t count,
+        Predicate::Op op, uint64_t *bits); ///Function to compare a batch of rows of two columns
+    static void appendRows(const uint64_t *bits, size_t first, size_t count,
+        std::vector<size_t> &rows); ///Function to append the rows set in a bitmap
+};
+
+#endif // FILTER_H
@@ -0,0 +1,113 @@
+/*!
+ * \file Index.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Index Class
+ *
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <experimental/string_view>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "BPlusTree.h"
+#include "Column.h"
+
+/*!
+ * \class Index
+ *
+ * \brief This class finds the rows of a column holding a value
+ *
+ * This class holds a secondary index over one column of a table. Each
+ * distinct value of the column has a posting list, the rows holding the
+ * value in ascending order. A hash index finds the posting list of a value
+ * through a hash table and only answers equality. A tree index keeps the
+ * values in a B+-tree and also answers ranges.
+ *
+ * Values are indexed by a key whose byte order matches the order of the
+ * column, so one key type serves every column type. Numbers are keyed by
+ * their floating point form with the sign flipped for byte order and char
+ * values by their bytes.
+ *
+ * The keys are stored packed: the sorted keys, the offset of the posting
+ * list of each key and the rows of every posting list, each in one flat
+ * array. The packed keys are read in place from a mapped index file or a
+ * buffer built by build, and a lookup is a binary search over them. Rows
+ * changed since the keys were packed are kept apart, added rows under their
+ * key in the hash table or B+-tree and stored rows whose key was erased in
+ * a bitmap, until the index is packed again.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Index {
+public:
+    /** Structures the posting lists can be found through **/
+    enum Kind { HASH_INDEX, TREE_INDEX };
+
+    Index(std::string newName, std::string newColName, Kind newKind); ///Default constructor
+    Index(const Index &other); ///Copy constructor, sharing the packed keys
+    virtual ~Index(); ///Default deconstructor
+
+    static std::string key(const Column &column, size_t row); ///Key of a row
+    static std::string key(const Column &column, const Value &value); ///Key of a parsed value
+
+    void build(const Column &column); ///Index every row of the column
+    bool map(std::shared_ptr<const void> owner, const char *segment, size_t length, size_t rows); ///Read packed keys
+    std::shared_ptr<const void> pack(const char *&segment, size_t &length) const; ///Packed form of every key
+    void insert(const std::string &key, size_t row); ///Add a row under a key
+    void erase(const std::string &key, size_t row); ///Remove a row from a key
+    void eraseRows(const std::vector<bool> &erased); ///Renumber rows after a delete
+    void equal(const std::string &key, std::vector<size_t> &rows) const; ///Rows holding a key
+    void greater(const std::string &key, std::vector<size_t> &rows) const; ///Rows above a key
+    void less(const std::string &key, std::vector<size_t> &rows) const; ///Rows below a key
+    void ordered(std::vector<size_t> &rows) const; ///Every row in key order
+
+    std::string indexName; ///String of the index name
+    std::string colName; ///String of the indexed column name
+    Kind kind; ///Structure used to find the posting lists
+protected:
+    typedef std::experimental::string_view KeyView; ///Key read in place
+    typedef std::function<void(KeyView key, const std::vector<size_t> &rows)> Visitor; ///Called for each key
+
+    static const size_t NO_POSTING = (size_t)-1; ///Posting list of a missing key
+
+    size_t findPosting(const std::string &key) const; ///Posting list of a key
+    size_t addPosting(const std::string &key); ///Posting list of a key, added if missing
+    void appendPosting(size_t posting, std::vector<size_t> &rows) const; ///Append a posting list
+    KeyView packedKey(size_t position) const; ///Packed key at a position
+    size_t boundPacked(KeyView key, bool after) const; ///First packed key at or after a key
+    void appendPacked(size_t position, std::vector<size_t> &rows) const; ///Append the rows of a packed key
+    void scan(const std::string *above, const std::string *below, const Visitor &visit) const; ///Visit keys in order
+    void clearChanges(); ///Forget the rows changed since packing
+
+    std::shared_ptr<const void> packedOwner; ///Mapped file or buffer holding the packed keys
+    const char *packedSegment = nullptr; ///Start of the packed keys
+    size_t packedLength = 0; ///Bytes of the packed keys
+    const uint32_t *keyOffsets = nullptr; ///Offset of each key in keyBytes and one past them, null for fixed width keys
+    const uint32_t *postingOffsets = nullptr; ///Offset of the posting list of each key in packedRows and one past them
+    const uint32_t *packedRows = nullptr; ///Rows of every posting list
+    const char *keyBytes = nullptr; ///Bytes of every key
+    size_t keyNum = 0; ///Number of packed keys
+    size_t packedRowNum = 0; ///Number of packed rows
+    size_t keyByteNum = 0; ///Number of key bytes
+    size_t keyWidth = 0; ///Bytes of each key if all have the same, else zero
+
+    std::vector<bool> erasedPacked; ///Bool for each packed row if it left its key, empty if none did
+    std::vector<std::vector<size_t>> postings; ///Posting list of each added key
+    std::unordered_map<std::string, size_t> hashed; ///Posting list of each added key in a hash index
+    BPlusTree<std::string, size_t> tree; ///Posting list of each added key in a tree index
+};
+
+#endif // INDEX_H
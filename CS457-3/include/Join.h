@@ -0,0 +1,106 @@
+/*!
+ * \file Join.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Join Class
+ *
+ */
+
+#ifndef JOIN_H
+#define JOIN_H
+
+#include <utility>
+#include <vector>
+
+#include "Column.h"
+#include "Index.h"
+#include "Predicate.h"
+
+/*!
+ * \class Join
+ *
+ * \brief This class finds the matching rows of joined tables
+ *
+ * This class holds the join algorithms used by the database. A join takes
+ * the join column of each side and gives back the pairs of row indices
+ * whose values are equal, leaving the printing of the rows to the caller.
+ *
+ * Two tables are joined by a nested loop when they are small or have no
+ * equality to join on, by a merge join when both join columns can be read
+ * in order without sorting, through a tree index or because the rows are
+ * already stored in order, and by a hash join otherwise. A hash table that
+ * would not fit in the sort memory is replaced by a merge join that sorts
+ * its inputs, since the sort can spill to temporary files.
+ *
+ * More tables are joined one step at a time. The joined rows are kept as
+ * tuples holding the row of every table, and each step joins one more
+ * table to them, keeping the unmatched rows of either side for an outer
+ * join with no row for the tables they did not match.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Join {
+public:
+    typedef std::vector<std::pair<size_t, size_t>> RowPairs; ///Pairs of left and right rows
+    typedef std::vector<size_t> Tuples; ///Row of every table for each joined row, one table after another
+
+    static const size_t NO_ROW = (size_t)-1; ///Row of a table a joined row has no match in
+
+    /** Algorithms joining two tables **/
+    enum Method { NESTED_LOOP, HASH_JOIN, MERGE_JOIN };
+    /** Ways the rows of a merge join input are put in key order **/
+    enum Order { UNSORTED, SORTED, INDEXED };
+
+    /*!
+     * \struct Input
+     *
+     * \brief Rows on one side of a join
+     */
+    struct Input {
+        const Column *column = nullptr; ///Join column, null without an equality
+        size_t rows = 0; ///Number of rows read, an estimate for joined rows until they are read
+        const size_t *rowIds = nullptr; ///Row of the column for each row read, null if they are the same
+        bool joined = false; ///Bool if the rows are the joined rows of earlier tables
+        const Index *index = nullptr; ///Tree index on the join column, null if none
+        Order order = UNSORTED; ///How the rows are read in key order
+
+        size_t row(size_t i) const { return rowIds == nullptr ? i : rowIds[i]; } ///Row of the column for a row read
+    };
+
+    /*!
+     * \struct Step
+     *
+     * \brief Table joined to the rows of the tables before it
+     */
+    struct Step {
+        size_t slot = 0; ///Slot of the table joined
+        TableRef::JoinType type = TableRef::CROSS_JOIN; ///Way the table is joined
+        Predicate predicate; ///Conditions a joined row must hold, none when empty
+        size_t keySlot = 0; ///Slot of the table holding the join column of the joined rows
+        Input left; ///Joined rows and their join column
+        Input right; ///Table and its join column
+        Method method = NESTED_LOOP; ///Algorithm joining the table
+    };
+
+    static const size_t NESTED_LOOP_PAIRS = 1024; ///Most pairs of rows joined by a nested loop
+    static const size_t HASH_ROW_BYTES = 48; ///Bytes a build row takes in a hash table
+
+    static Method choose(Input &left, Input &right); ///Function to pick the join algorithm
+    static const char *methodName(Method method); ///Function to name a join algorithm
+    static RowPairs hashJoin(const Input &left, const Input &right); ///Function to hash join two columns
+    static bool mergeJoin(const Input &left, const Input &right,
+        RowPairs &matches); ///Function to merge join two columns
+    static void start(size_t slots, size_t slot, size_t rows, Tuples &tuples); ///Function to start from every row of a table
+    static void extend(Step &step, size_t slots, Tuples &tuples); ///Function to join a table to the joined rows
+    static void orderTuples(const std::vector<size_t> &rowCounts, Tuples &tuples); ///Function to order joined rows by table
+protected:
+    static bool sorted(const Column &column); ///Function to check if the rows are in key order
+    static bool keyOrder(const Input &input, std::vector<size_t> &rows); ///Function to list the rows in key order
+};
+
+#endif // JOIN_H
@@ -0,0 +1,56 @@
+/*!
+ * \file Lexer.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Lexer Class
+ *
+ */
+
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <string>
+
+/*!
+ * \struct Token
+ *
+ * \brief A word, number, string or symbol of a statement
+ */
+struct Token {
+    /** Kinds of tokens the lexer produces **/
+    enum Type { IDENTIFIER, NUMBER, STRING, SYMBOL, END, INVALID };
+
+    Type type = END; ///Kind of the token
+    std::string text; ///Text of the token, strings keep their quotes
+};
+
+/*!
+ * \class Lexer
+ *
+ * \brief This class splits a statement into tokens
+ *
+ * This class reads a statement held in a buffer in a single pass. Words
+ * are identifiers or keywords, numbers may have a fraction and exponent,
+ * strings are quoted with ' or " and symbols are punctuation and the
+ * comparison operators. Whitespace separates tokens but is never needed,
+ * so values(1,'a') and values (1, 'a') give the same tokens.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Lexer {
+public:
+    Lexer(const std::string &newText); ///Default constructor
+    virtual ~Lexer(); ///Default deconstructor
+
+    Token next(); ///Function to read the next token
+protected:
+    const std::string &text; ///Statement being read
+    size_t position; ///Position of the next character
+};
+
+#endif // LEXER_H
@@ -0,0 +1,47 @@
+/*!
+ * \file MappedFile.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for MappedFile Class
+ *
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+
+/*!
+ * \class MappedFile
+ *
+ * \brief This class maps a table file into memory
+ *
+ * This class maps a whole file read only into the address space of the
+ * program. Mapping is constant time and the pages of the file are only
+ * read from disk once they are touched. The mapping is removed when the
+ * object is destroyed, so columns reading from it share ownership of it.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class MappedFile {
+public:
+    MappedFile(std::string path); ///Default constructor
+    virtual ~MappedFile(); ///Default deconstructor
+
+    MappedFile(const MappedFile &) = delete; ///Mappings are not copied
+    MappedFile &operator=(const MappedFile &) = delete; ///Mappings are not copied
+
+    bool isOpen() const; ///Function to check if the file is mapped
+    const char *data() const; ///Function to get the start of the mapping
+    size_t size() const; ///Function to get the length of the mapping
+protected:
+    void *address; ///Pointer to the start of the mapping
+    size_t length; ///Holds the length of the mapping
+};
+
+#endif // MAPPEDFILE_H
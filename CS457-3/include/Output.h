@@ -0,0 +1,39 @@
+/*!
+ * \file Output.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Output Class
+ *
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <ostream>
+
+/*!
+ * \class Output
+ *
+ * \brief This class picks the stream the results of a statement go to
+ *
+ * Every message and result printed while running a statement is written
+ * to the stream of the running thread. The stream is standard output
+ * unless the thread serves a client of the server, in which case it is
+ * the connection of that client.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Output {
+public:
+    static std::ostream &stream(); ///Function to get the stream of the running thread
+    static void redirect(std::ostream *newStream); ///Function to set the stream of the running thread
+protected:
+    static thread_local std::ostream *current; ///Stream of the running thread, null for standard output
+};
+
+#endif // OUTPUT_H
@@ -0,0 +1,72 @@
+/*!
+ * \file Parser.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Parser Class
+ *
+ */
+
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <memory>
+#include <string>
+
+#include "Lexer.h"
+#include "Statement.h"
+
+/*!
+ * \class Parser
+ *
+ * \brief This class turns the text of a statement into a syntax tree
+ *
+ * This class is a recursive descent parser over the tokens of a single
+ * statement. Keywords are matched regardless of case. A statement that
+ * does not follow the grammar gives no tree, which the caller reports as
+ * an unknown command.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Parser {
+public:
+    Parser(const std::string &newText); ///Default constructor
+    virtual ~Parser(); ///Default deconstructor
+
+    std::unique_ptr<Statement> parse(); ///Function to parse the statement
+protected:
+    void advance(); ///Function to move to the next token
+    bool keyword(const char *word); ///Function to accept a keyword
+    bool symbol(const char *text); ///Function to accept a symbol
+    bool identifier(std::string &name); ///Function to accept a name
+    bool literal(std::string &value); ///Function to accept a literal
+    bool columnDef(ColumnDef &column); ///Function to accept a column definition
+    bool operand(Operand &side); ///Function to accept a column or literal
+    bool condition(Condition &where); ///Function to accept a comparison
+    std::unique_ptr<Expression> expression(); ///Function to accept expressions joined by OR
+    std::unique_ptr<Expression> conjunction(); ///Function to accept expressions joined by AND
+    std::unique_ptr<Expression> factor(); ///Function to accept a comparison, NOT or parentheses
+    bool selectItem(SelectItem &item); ///Function to accept a column or aggregate
+    bool tableRef(TableRef &table); ///Function to accept a table and alias
+    bool joinType(TableRef::JoinType &join); ///Function to accept the keywords joining a table
+    bool fileOptions(FileOptions &file); ///Function to accept a data file and its format
+    bool end(); ///Function to accept the end of the statement
+
+    std::unique_ptr<Statement> parseCreate(); ///Function to parse CREATE
+    std::unique_ptr<Statement> parseDrop(); ///Function to parse DROP
+    std::unique_ptr<Statement> parseAlter(); ///Function to parse ALTER
+    std::unique_ptr<Statement> parseInsert(); ///Function to parse INSERT
+    std::unique_ptr<Statement> parseCopy(); ///Function to parse COPY
+    std::unique_ptr<Statement> parseUpdate(); ///Function to parse UPDATE
+    std::unique_ptr<Statement> parseDelete(); ///Function to parse DELETE
+    std::unique_ptr<Statement> parseSelect(); ///Function to parse SELECT
+
+    Lexer lexer; ///Lexer reading the statement
+    Token current; ///Token being looked at
+};
+
+#endif // PARSER_H
@@ -0,0 +1,110 @@
+/*!
+ * \file Predicate.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Predicate Class
+ *
+ */
+
+#ifndef PREDICATE_H
+#define PREDICATE_H
+
+#include <string>
+#include <vector>
+
+#include "Column.h"
+#include "Statement.h"
+
+/*!
+ * \class Predicate
+ *
+ * \brief This class evaluates a WHERE or ON expression against rows
+ *
+ * This class binds the syntax tree of an expression to the columns of the
+ * tables it reads before any row is looked at. Each column name is found
+ * once, giving the slot of its table and its position in the table, and
+ * each literal is parsed once for the column it is compared with. Testing
+ * a row then only compares stored values.
+ *
+ * The tables are given as slots in FROM order, and a row is tested by
+ * giving the current row of every slot. Comparisons use the order of the
+ * column types, numbers as numbers and char values by their bytes.
+ *
+ * An expression over a single table can also be evaluated a batch of rows
+ * at a time, with every node giving a bitmap of the rows it holds for.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Predicate {
+public:
+    /** Comparison operators **/
+    enum Op { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+
+    /*!
+     * \struct Source
+     *
+     * \brief Table whose columns an expression may name
+     */
+    struct Source {
+        std::string name; ///String of the table name
+        std::string alias; ///String of the alias, empty if none was given
+        const std::vector<Column> *columns; ///Columns of the table
+    };
+
+    Predicate(); ///Default constructor
+    virtual ~Predicate(); ///Default deconstructor
+
+    static bool parseOp(const std::string &text, Op &op); ///Function to read an operator
+    static bool holds(Op op, int compared); ///Function to check an operator against an order
+    static const char *opName(Op op); ///Function to write an operator
+
+    bool bind(const Expression &expression, const std::vector<Source> &sources); ///Function to bind an expression
+    bool bind(const std::vector<const Expression *> &expressions,
+        const std::vector<Source> &sources); ///Function to bind the AND of expressions
+    bool test(const size_t *rows) const; ///Function to test the current row of every slot
+    bool test(size_t row) const { return test(&row); } ///Function to test a row of a single table
+    void select(size_t rowCount, std::vector<size_t> &rows,
+        size_t limit = SelectStatement::NO_LIMIT) const; ///Function to find the matching rows of a single table
+    bool single() const; ///Function to check if the expression is one comparison
+    bool empty() const; ///Function to check if there is no expression
+    std::vector<size_t> slots() const; ///Function to list the slots the expression reads
+    bool keyCondition(size_t &col, Op &op, const Value *&value) const; ///Function to find a column to look up
+    bool joinKey(size_t slot, size_t &col, size_t &otherSlot,
+        size_t &otherCol) const; ///Function to find an equality between a slot and another
+protected:
+    /*!
+     * \struct Node
+     *
+     * \brief Bound node of the expression
+     */
+    struct Node {
+        Expression::Kind kind = Expression::COMPARE; ///Kind of the node
+        size_t left = 0; ///Position of the first operand of AND, OR and NOT
+        size_t right = 0; ///Position of the second operand of AND and OR
+        Op op = EQUAL; ///Operator of a comparison
+        size_t slot = 0; ///Slot of the compared column
+        size_t col = 0; ///Position of the compared column in its table
+        const Column *column = nullptr; ///Compared column
+        bool againstColumn = false; ///Bool if the column is compared with another column
+        size_t otherSlot = 0; ///Slot of the other column
+        size_t otherCol = 0; ///Position of the other column in its table
+        const Column *other = nullptr; ///Other column
+        Value value; ///Literal parsed for the column
+    };
+
+    bool bindNode(const Expression &expression, const std::vector<Source> &sources, size_t &position); ///Function to bind a node
+    bool resolve(const Operand &side, const std::vector<Source> &sources, size_t &slot, size_t &col,
+        size_t from = 0) const; ///Function to find a column
+    bool evaluate(size_t position, const size_t *rows) const; ///Function to evaluate a node
+    void conjuncts(size_t position, std::vector<size_t> &found) const; ///Function to list the comparisons joined by AND
+
+    std::vector<Node> nodes; ///Bound nodes, each after its operands
+    size_t root; ///Position of the top node
+};
+
+#endif // PREDICATE_H
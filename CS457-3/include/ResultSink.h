@@ -0,0 +1,120 @@
+/*!
+ * \file ResultSink.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for ResultSink Class
+ *
+ */
+
+#ifndef RESULTSINK_H
+#define RESULTSINK_H
+
+#include <ostream>
+#include <string>
+
+#include "RowCursor.h"
+
+/*!
+ * \class ResultSink
+ *
+ * \brief This class writes the result of a query
+ *
+ * This class is the base for the output formats of a query result. A sink
+ * is given the cursor of a query once for the header and then once per
+ * row. The formatted output is gathered in a reusable buffer that is
+ * written to the stream when it fills and when the result is finished, so
+ * a large result costs a few large writes instead of a flush per row.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class ResultSink {
+public:
+    static const size_t FLUSH_BYTES = 1 << 16; ///Size the buffer may reach before it is written
+    static const size_t FILE_FLUSH_BYTES = 1 << 20; ///Size the buffer of a file export may reach
+
+    ResultSink(std::ostream &out, size_t newFlushBytes = FLUSH_BYTES); ///Default constructor
+    virtual ~ResultSink(); ///Default deconstructor
+
+    virtual void writeHeader(const RowCursor &cursor) = 0; ///Function to write the projected columns
+    virtual void writeRow(RowCursor &cursor) = 0; ///Function to write the current row
+    void finish(); ///Function to write out the buffer at the end of a result
+
+    size_t rowNum; ///Number of rows written
+protected:
+    void spill(); ///Function to write out a full buffer
+
+    std::ostream &output; ///Stream the result is written to
+    std::string buffer; ///Formatted output not yet written
+    size_t flushBytes; ///Size the buffer may reach before it is written
+};
+
+/*!
+ * \class TextSink
+ *
+ * \brief This class writes a result as pipe separated text
+ *
+ * The header lists each column as its name and type, with the size of
+ * char columns, and each row lists its values. Values and columns are
+ * separated by a '|' and every line ends with a newline.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class TextSink : public ResultSink {
+public:
+    TextSink(std::ostream &out); ///Default constructor
+
+    void writeHeader(const RowCursor &cursor); ///Function to write the projected columns
+    void writeRow(RowCursor &cursor); ///Function to write the current row
+};
+
+/*!
+ * \class CsvSink
+ *
+ * \brief This class writes a result as delimited text
+ *
+ * Each row is written as one line with its values separated by the
+ * delimiter and no header, so the file can be read back by COPY FROM. A
+ * char value holding the delimiter, a quote or a line end is quoted with
+ * " and its quotes are doubled.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class CsvSink : public ResultSink {
+public:
+    CsvSink(std::ostream &out, char newDelimiter); ///Default constructor
+
+    void writeHeader(const RowCursor &cursor); ///Function to write the projected columns
+    void writeRow(RowCursor &cursor); ///Function to write the current row
+protected:
+    char delimiter; ///Character separating the values
+};
+
+/*!
+ * \class BinarySink
+ *
+ * \brief This class writes a result in the binary row encoding
+ *
+ * The file starts with the magic bytes CS457ROW, a version, the number of
+ * columns and the name, type and size of each column. Each row follows
+ * with its values encoded as in the write-ahead log, ints and floats in their
+ * native form and char values as a length and their bytes.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class BinarySink : public ResultSink {
+public:
+    BinarySink(std::ostream &out); ///Default constructor
+
+    void writeHeader(const RowCursor &cursor); ///Function to write the projected columns
+    void writeRow(RowCursor &cursor); ///Function to write the current row
+};
+
+#endif // RESULTSINK_H
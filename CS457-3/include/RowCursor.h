@@ -0,0 +1,57 @@
+/*!
+ * \file RowCursor.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for RowCursor Class
+ *
+ */
+
+#ifndef ROWCURSOR_H
+#define ROWCURSOR_H
+
+#include <experimental/string_view>
+#include <vector>
+
+#include "Column.h"
+
+/*!
+ * \class RowCursor
+ *
+ * \brief This class hands out the projected values of a result row
+ *
+ * This class holds a projection, the list of columns that make up a
+ * result row, and the current row of each table the columns come from.
+ * Tables are numbered by slot so a join can position each table on its
+ * own row. Values are handed out as views into the column data, or into
+ * a small buffer for numbers, so emitting a row never copies a column or
+ * allocates.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class RowCursor {
+public:
+    static const size_t NO_ROW = (size_t)-1; ///Row of a table with no matching row
+
+    RowCursor(size_t slots = 1); ///Default constructor
+    virtual ~RowCursor(); ///Default deconstructor
+
+    void project(const Column &column, size_t slot = 0); ///Function to add a column to the projection
+    void projectAll(const std::vector<Column> &tableColumns, size_t slot = 0); ///Function to add every column
+    void seek(size_t slot, size_t row); ///Function to move a table to a row
+    size_t width() const; ///Function to get the number of projected columns
+    const Column &column(size_t index) const; ///Function to get a projected column
+    size_t row(size_t index) const; ///Function to get the current row of a projected column
+    std::experimental::string_view value(size_t index); ///Function to get a projected value
+protected:
+    std::vector<const Column *> columns; ///Projected columns
+    std::vector<size_t> slotOf; ///Table slot of each projected column
+    std::vector<size_t> rows; ///Current row of each table slot
+    char buffer[32]; ///Buffer holding a formatted number
+};
+
+#endif // ROWCURSOR_H
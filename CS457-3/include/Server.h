@@ -0,0 +1,97 @@
+/*!
+ * \file Server.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Server Class
+ *
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+ * \class Server
+ *
+ * \brief This class serves sessions to clients over a Unix domain socket
+ *
+ * The server listens on a socket path and hands each client that connects
+ * to a pool of worker threads. A worker runs one session at a time,
+ * reading the statements of the client from the connection and writing
+ * the results back to it, until the client closes its side. Clients wait
+ * in a queue while every worker is busy.
+ *
+ * The server runs until it receives SIGINT or SIGTERM. It then stops
+ * reading from the clients, lets the running statements finish and
+ * returns, leaving the databases to be closed by the caller.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Server {
+public:
+    typedef std::function<void(std::istream &, std::ostream &)> Session; ///Function running the session of a client
+
+    Server(std::string newPath, size_t newThreads, Session newSession); ///Default constructor
+    virtual ~Server(); ///Default deconstructor
+
+    Server(const Server &) = delete; ///Servers are not copied
+    Server &operator=(const Server &) = delete; ///Servers are not copied
+
+    int run(); ///Function to serve clients until the server is stopped
+    static int connect(const std::string &path); ///Function to run as a client of a server
+protected:
+    /*!
+     * \class Connection
+     *
+     * \brief Stream buffer reading from and writing to a socket
+     */
+    class Connection : public std::streambuf {
+    public:
+        static const size_t BUFFER_BYTES = 64 * 1024; ///Bytes buffered each way
+
+        Connection(int newSocket); ///Default constructor
+    protected:
+        int_type underflow() override; ///Function to receive more input
+        int_type overflow(int_type c) override; ///Function to send a full output buffer
+        int sync() override; ///Function to send the buffered output
+        std::streamsize showmanyc() override; ///Function to count the input waiting on the socket
+
+        int socket; ///Holds the connected socket
+        std::vector<char> input; ///Buffer of received bytes
+        std::vector<char> output; ///Buffer of bytes to send
+    };
+
+    void work(); ///Function run by each worker thread
+    static bool sendAll(int socket, const char *data, size_t length); ///Function to send a whole buffer
+    static void stop(int signal); ///Function handling the signals stopping the server
+
+    std::string path; ///String containing the path of the socket
+    size_t threads; ///Number of worker threads
+    Session session; ///Function running each session
+    int listener; ///Holds the listening socket, negative if it is not open
+    std::vector<std::thread> workers; ///Threads running the sessions
+    std::mutex latch; ///Latch held while the queue or the open sessions are used
+    std::condition_variable waiting; ///Signaled when a client is queued or the server stops
+    std::deque<int> queue; ///Connected clients waiting for a worker
+    std::set<int> sessions; ///Sockets of the running sessions
+    bool stopping; ///Bool if the server is stopping
+    static int wakeup[2]; ///Pipe written by the signal handler to wake the server
+};
+
+#endif // SERVER_H
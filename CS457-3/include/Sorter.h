@@ -0,0 +1,71 @@
+/*!
+ * \file Sorter.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Sorter Class
+ *
+ */
+
+#ifndef SORTER_H
+#define SORTER_H
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Column.h"
+
+/*!
+ * \class Sorter
+ *
+ * \brief This class orders the rows of a select by one or more columns
+ *
+ * This class sorts pairs of a row number and a key instead of the rows
+ * themselves. The key of a row is the values of the ordered columns encoded
+ * so that comparing the bytes of two keys gives the order of the rows, with
+ * the bytes of a descending column inverted. Rows with equal keys keep the
+ * order of their row numbers.
+ *
+ * The keys are kept in memory up to memoryBytes. Past that the pairs held
+ * are sorted and spilled to a temporary file as a run, and the runs are
+ * merged at the end by reading the next pair of every run. With a limit
+ * small enough to fit in memory only the lowest rows are kept in a heap.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Sorter {
+public:
+    static size_t memoryBytes; ///Bytes the keys may use before a run is spilled
+
+    Sorter(); ///Default constructor
+    virtual ~Sorter(); ///Default deconstructor
+
+    static bool bounded(size_t limit); ///Function to check if a limit is kept in a heap
+
+    void addKey(const Column &column, bool descending); ///Function to order by a column
+    bool sort(const std::vector<size_t> *rows, size_t count, size_t limit,
+        const std::function<void(size_t)> &emit); ///Function to hand out the rows in order
+protected:
+    typedef std::pair<std::string, size_t> Entry; ///Key and row number of a row
+
+    void encode(size_t row, std::string &key) const; ///Function to build the key of a row
+    void top(const std::vector<size_t> *rows, size_t count, size_t limit,
+        const std::function<void(size_t)> &emit) const; ///Function to hand out the lowest rows
+    bool spill(std::vector<Entry> &entries); ///Function to write a sorted run
+    bool merge(size_t limit, const std::function<void(size_t)> &emit); ///Function to merge the runs
+    static bool readEntry(std::FILE *run, Entry &entry); ///Function to read the next pair of a run
+    void closeRuns(); ///Function to remove the runs
+
+    std::vector<const Column *> columns; ///Ordered columns
+    std::vector<bool> descending; ///Bool for each ordered column if it is descending
+    std::vector<std::FILE *> runs; ///Temporary files holding the spilled runs
+};
+
+#endif // SORTER_H
@@ -0,0 +1,279 @@
+/*!
+ * \file Statement.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for the Statement syntax tree
+ *
+ */
+
+#ifndef STATEMENT_H
+#define STATEMENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ * \struct ColumnDef
+ *
+ * \brief Definition of a column in CREATE TABLE or ALTER TABLE
+ */
+struct ColumnDef {
+    std::string name; ///String of the column name
+    std::string type; ///String of the column type, int, float, char or varchar
+    int size = 0; ///Int of the size of a char or varchar column
+};
+
+/*!
+ * \struct Operand
+ *
+ * \brief One side of a condition
+ *
+ * An operand is either a column, optionally qualified by a table name or
+ * alias, or a literal kept as it was written with the quotes of a string.
+ */
+struct Operand {
+    bool isColumn = false; ///Bool if the operand names a column
+    std::string table; ///String of the table or alias qualifying a column
+    std::string text; ///String of the column name or the literal
+};
+
+/*!
+ * \struct Condition
+ *
+ * \brief Comparison of two operands in a WHERE or ON clause
+ */
+struct Condition {
+    Operand left; ///Left side of the comparison
+    std::string op; ///String of the operator, "=", "!=", "<", ">", "<=" or ">="
+    Operand right; ///Right side of the comparison
+};
+
+/*!
+ * \struct Expression
+ *
+ * \brief Boolean expression of a WHERE or ON clause
+ *
+ * A leaf compares two operands, the other nodes combine the expressions
+ * below them with AND, OR or NOT.
+ */
+struct Expression {
+    /** Kinds of expression nodes **/
+    enum Kind { COMPARE, AND, OR, NOT };
+
+    Kind kind = COMPARE; ///Kind of the node
+    Condition compare; ///Comparison of a COMPARE node
+    std::unique_ptr<Expression> left; ///Operand of a NOT node or first operand of AND and OR
+    std::unique_ptr<Expression> right; ///Second operand of AND and OR
+};
+
+/*!
+ * \struct TableRef
+ *
+ * \brief Table named in a FROM clause with its optional alias
+ *
+ * Every table after the first is joined to the tables before it. A table
+ * listed with a comma or CROSS JOIN has no ON clause and is matched by the
+ * WHERE clause.
+ */
+struct TableRef {
+    /** Ways a table is joined to the tables before it **/
+    enum JoinType { CROSS_JOIN, INNER_JOIN, LEFT_OUTER_JOIN, RIGHT_OUTER_JOIN, FULL_OUTER_JOIN };
+
+    std::string name; ///String of the table name
+    std::string alias; ///String of the alias, empty if none was given
+    JoinType join = CROSS_JOIN; ///Way the table is joined, CROSS_JOIN for the first table
+    std::unique_ptr<Expression> on; ///Expression of the ON clause, empty if none was given
+};
+
+/*!
+ * \struct FileOptions
+ *
+ * \brief Data file read by COPY FROM or written by COPY TO and INTO OUTFILE
+ */
+struct FileOptions {
+    std::string path; ///String of the path of the data file
+    char delimiter = ','; ///Character separating the fields
+    bool binary = false; ///Bool if the binary row format was asked for instead of text
+};
+
+/*!
+ * \struct SelectItem
+ *
+ * \brief Column or aggregate in the list of a SELECT
+ */
+struct SelectItem {
+    std::string function; ///String of the aggregate in upper case, empty for a plain column
+    std::string column; ///String of the column name, * for COUNT(*)
+};
+
+/*!
+ * \struct OrderItem
+ *
+ * \brief Column or aggregate of an ORDER BY clause
+ */
+struct OrderItem {
+    SelectItem item; ///Column or aggregate the rows are ordered by
+    bool descending = false; ///Bool if the rows are ordered from the highest value
+};
+
+/*!
+ * \struct Statement
+ *
+ * \brief Root of the syntax tree of a statement
+ *
+ * Every statement is parsed into one of the structures below, picked by
+ * its kind. The executors check the kind and read the matching structure.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+struct Statement {
+    /** Kinds of statements the parser produces **/
+    enum Kind {
+        CREATE_DATABASE, DROP_DATABASE, USE_DATABASE,
+        CREATE_TABLE, DROP_TABLE, ALTER_TABLE,
+        CREATE_INDEX, DROP_INDEX,
+        INSERT, COPY, UPDATE, DELETE, SELECT,
+        CHECKPOINT, BEGIN, COMMIT, ROLLBACK, EXIT
+    };
+
+    Statement(Kind newKind) : kind(newKind) {} ///Default constructor
+    virtual ~Statement() {} ///Default deconstructor
+
+    Kind kind; ///Kind of the statement
+};
+
+/*!
+ * \struct NameStatement
+ *
+ * \brief Statement naming a single object
+ *
+ * Used for CREATE DATABASE, DROP DATABASE, USE, DROP TABLE and DROP INDEX.
+ */
+struct NameStatement : Statement {
+    NameStatement(Kind newKind) : Statement(newKind) {} ///Default constructor
+
+    std::string name; ///String of the database, table or index name
+};
+
+/*!
+ * \struct CreateTableStatement
+ *
+ * \brief CREATE TABLE name (column type, ...)
+ */
+struct CreateTableStatement : Statement {
+    CreateTableStatement() : Statement(CREATE_TABLE) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    std::vector<ColumnDef> columns; ///Definitions of the columns in order
+};
+
+/*!
+ * \struct AlterTableStatement
+ *
+ * \brief ALTER TABLE name ADD column type
+ */
+struct AlterTableStatement : Statement {
+    AlterTableStatement() : Statement(ALTER_TABLE) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    ColumnDef column; ///Definition of the added column
+};
+
+/*!
+ * \struct CreateIndexStatement
+ *
+ * \brief CREATE INDEX name ON table (column) [USING HASH | BTREE]
+ */
+struct CreateIndexStatement : Statement {
+    CreateIndexStatement() : Statement(CREATE_INDEX) {} ///Default constructor
+
+    std::string index; ///String of the index name
+    std::string table; ///String of the table name
+    std::string column; ///String of the indexed column name
+    bool hash = false; ///Bool if a hash index was asked for
+};
+
+/*!
+ * \struct InsertStatement
+ *
+ * \brief INSERT INTO name VALUES (literal, ...), ...
+ */
+struct InsertStatement : Statement {
+    InsertStatement() : Statement(INSERT) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    std::vector<std::vector<std::string>> rows; ///Literals of each row in column order
+};
+
+/*!
+ * \struct CopyStatement
+ *
+ * \brief COPY name FROM|TO 'path' [DELIMITER 'character'] [FORMAT CSV|BINARY]
+ */
+struct CopyStatement : Statement {
+    CopyStatement() : Statement(COPY) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    bool toFile = false; ///Bool if the table is written to the file instead of loaded from it
+    FileOptions file; ///Data file and its format
+};
+
+/*!
+ * \struct UpdateStatement
+ *
+ * \brief UPDATE name SET column = literal WHERE expression
+ */
+struct UpdateStatement : Statement {
+    UpdateStatement() : Statement(UPDATE) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    std::string setColumn; ///String of the changed column
+    std::string setValue; ///Literal the column is set to
+    std::unique_ptr<Expression> where; ///Expression selecting the changed rows
+};
+
+/*!
+ * \struct DeleteStatement
+ *
+ * \brief DELETE FROM name WHERE expression
+ */
+struct DeleteStatement : Statement {
+    DeleteStatement() : Statement(DELETE) {} ///Default constructor
+
+    std::string table; ///String of the table name
+    std::unique_ptr<Expression> where; ///Expression selecting the removed rows
+};
+
+/*!
+ * \struct SelectStatement
+ *
+ * \brief [EXPLAIN] SELECT items FROM table [joins] [WHERE expression] [GROUP BY columns] [ORDER BY items] [LIMIT n] [INTO OUTFILE 'path' ...]
+ *
+ * Any number of tables may be joined, each listed with a comma or joined
+ * with [CROSS | INNER | LEFT [OUTER] | RIGHT [OUTER] | FULL [OUTER]] JOIN
+ * and its ON clause. The WHERE clause filters the joined rows. A result
+ * with an outfile is written to the file instead of being printed. A list
+ * holding an aggregate or a GROUP BY clause gives one row per group.
+ */
+struct SelectStatement : Statement {
+    static const size_t NO_LIMIT = (size_t)-1; ///Limit of a select without a LIMIT clause
+
+    SelectStatement() : Statement(SELECT) {} ///Default constructor
+
+    std::vector<SelectItem> columns; ///Selected columns and aggregates, empty for *
+    std::vector<TableRef> tables; ///Tables in the FROM clause and the way each is joined
+    std::unique_ptr<Expression> where; ///Expression of the WHERE clause, empty if none was given
+    std::vector<std::string> groupBy; ///Strings of the GROUP BY columns
+    std::vector<OrderItem> orderBy; ///Columns and aggregates of the ORDER BY clause
+    size_t limit = NO_LIMIT; ///Most rows listed
+    FileOptions outfile; ///File the result is written to, no path to print it
+    bool explain = false; ///Bool if the plan is printed instead of the rows
+};
+
+#endif // STATEMENT_H
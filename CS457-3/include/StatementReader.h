@@ -0,0 +1,45 @@
+/*!
+ * \file StatementReader.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for StatementReader Class
+ *
+ */
+
+#ifndef STATEMENTREADER_H
+#define STATEMENTREADER_H
+
+#include <istream>
+#include <string>
+
+/*!
+ * \class StatementReader
+ *
+ * \brief This class splits the input into whole statements
+ *
+ * This class reads the input a line at a time and hands out the text of
+ * one statement at a time. A statement ends at a ';' outside of quotes,
+ * so a statement may span several lines and a line may hold several
+ * statements. Comments starting with -- run to the end of the line and
+ * commands starting with a '.' such as .exit end at the end of the line.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class StatementReader {
+public:
+    StatementReader(std::istream &newIn); ///Default constructor
+    virtual ~StatementReader(); ///Default deconstructor
+
+    bool next(std::string &statement); ///Function to read the next statement
+    bool ready() const; ///Function to check if another statement can be read without waiting
+protected:
+    std::istream &in; ///Stream the statements are read from
+    std::string pending; ///Text read after the end of the last statement
+};
+
+#endif // STATEMENTREADER_H
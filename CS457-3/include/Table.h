@@ -14,10 +14,19 @@
 #ifndef TABLE_H
 #define TABLE_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "Column.h"
+#include "Index.h"
+#include "Predicate.h"
+#include "ResultSink.h"
+#include "Statement.h"
+#include "Transaction.h"
+#include "WriteAheadLog.h"
 
 /*!
  * \class Table
@@ -28,30 +37,109 @@
  * This virtual table will allow for easier data manipulation as
  * the data will be already loaded in the program.
  *
+ * A table read from its file starts with only its schema. The rows are
+ * mapped when a statement first uses the table, which reads the whole file
+ * once to verify its checksum.
+ *
+ * Changes to the rows are written to the write-ahead log of the database
+ * rather than the table file, which is only rewritten by a checkpoint. The
+ * records logged since the file was written are applied by load. Inside a
+ * transaction the records are held by the transaction until it commits.
+ *
+ * A table may hold secondary indexes on its columns. The indexes are kept
+ * up to date by every change to the rows and are stored in an index file
+ * next to the table file.
+ *
+ * Queries read a snapshot of the table rather than the table itself. The
+ * snapshot is a table of its own holding read only copies of the columns,
+ * each with the row count of its table when it was taken, and the indexes
+ * as they were. Each change publishes a new snapshot once it is done, or
+ * at COMMIT inside a transaction, so a query never waits for a change and
+ * never sees one half made. Columns copy their storage before changing
+ * rows a snapshot reads, and an index read by a snapshot is copied before
+ * it is changed. The last snapshot stays published until the next one
+ * replaces it, so queries starting during a change read the rows as they
+ * were before it. A table is loaded under a latch of its own, so a query
+ * reading a table for the first time never waits for a change to another.
+ *
  * \author Christopher Mollise
  * \date 5/6/20
  */
 class Table {
 public:
     Table(std::string path); ///Default constructor
+    Table(); ///Constructor of an empty table without a file
     virtual ~Table(); ///Default deconstructor
-    void writeTable(std::string path); ///Function to write table to file
-    bool alter(); ///Function to alter table columns
-    void select(); ///Function to list table columns
-    bool insert(); ///Function to insert into table columns
-    bool insertLine(std::string input); ///Function if no spaces in insert command
-    bool update(); ///Function to update table columns
-    bool deleteFrom(); ///Function to delete input from tables
-    void reInput(); ///Function to reload database after delete changes
-    bool selectTypes(std::vector <std::string> types); ///Seperate select for different types
+    void readSchema(std::string path); ///Function to read the schema from binary file
+    void load(); ///Function to load the rows on first use
+    void revert(const Table &image); ///Function to put back the rows as last committed
+    std::shared_ptr<Table> snapshot(); ///Function to get the rows as last published
+    void publish(); ///Function to let queries read the rows as they are now
+    std::shared_ptr<Table> makeView(bool withIndexes) const; ///Function to make a snapshot of the rows held now
+    void ownIndexes(); ///Function to make the indexes safe to change
+    void readFile(std::string path); ///Function to map table from binary file
+    void readText(std::string path); ///Function to read table from text file
+    static std::string convertText(std::string textPath); ///Function to convert text file to binary
+    void replayRecords(uint64_t indexLsn, size_t indexRows); ///Function to apply the records of the write-ahead log
+    bool replayInsert(const char *cursor, const char *end); ///Function to apply logged rows
+    bool replayUpdate(const char *cursor, const char *end); ///Function to apply a logged update
+    bool replayDelete(const char *cursor, const char *end); ///Function to apply a logged delete
+    void appendRows(size_t first, size_t count); ///Function to log inserted rows
+    void appendUpdate(size_t col, const std::string &literal, const std::vector<size_t> &rows); ///Function to log an update
+    void appendDelete(const std::vector<size_t> &rows); ///Function to log a delete
+    void appendRecord(WriteAheadLog::Kind kind, const std::string &payload); ///Function to append a record to the write-ahead log
+    bool writeTable(std::string path); ///Function to write table to file
+    void readIndexes(uint64_t &indexLsn, size_t &indexRows); ///Function to read the indexes from the index file
+    void buildIndexes(); ///Function to build every index from its column
+    void writeIndexes(); ///Function to write the indexes to the index file
+    void readIndexNames(); ///Function to read the index names from the index file
+    int findColumn(const std::string &name) const; ///Function to get the position of a column
+    bool createIndex(std::string indexName, std::string colName, Index::Kind kind); ///Function to add an index
+    bool dropIndex(std::string indexName); ///Function to remove an index
+    bool holdsIndex(const std::string &indexName) const; ///Function to check the table holds an index
+    const Index *findIndex(size_t col, Predicate::Op op) const; ///Function to find an index answering a comparison
+    void matchRows(size_t col, Predicate::Op op, const Value &value,
+        std::vector<size_t> &rows) const; ///Function to find the rows matching a comparison
+    bool findRows(const Expression *where, const std::string &alias, std::vector<size_t> &rows,
+        size_t limit = SelectStatement::NO_LIMIT) const; ///Function to find the rows matching an expression
+    bool describeAccess(const Expression *where, const std::string &alias,
+        std::string &access) const; ///Function to describe how findRows reads the table
+    bool alter(const ColumnDef &column); ///Function to alter table columns
+    void select(ResultSink &sink); ///Function to list table columns
+    bool insertRows(const std::vector<std::vector<std::string>> &rows); ///Function to store inserted rows
+    bool copyFrom(const std::string &path, char delimiter); ///Function to load rows from a data file
+    bool update(const std::string &setName, const std::string &setValue,
+        const Expression &where); ///Function to update table columns
+    bool deleteFrom(const Expression &where); ///Function to delete input from tables
+    void indexRows(size_t first); ///Function to index appended rows
+    void assignRows(size_t col, const std::vector<size_t> &rows, const Value &value); ///Function to set rows of a column
+    void eraseRows(const std::vector<bool> &erased); ///Function to remove the marked rows
+    bool selectTypes(const std::vector <std::string> &types, const Expression *where,
+        const std::string &alias, const std::vector<OrderItem> &orderBy, size_t limit,
+        ResultSink &sink); ///Seperate select for different types
+    bool aggregate(const std::vector<SelectItem> &items, const std::vector<std::string> &groupBy,
+        const Expression *where, const std::string &alias, const std::vector<OrderItem> &orderBy,
+        size_t limit, ResultSink &sink); ///Function to list aggregates by group
 
     std::vector<Column> columns; ///Vector of Column Objects
     std:: string lowerName; ///String containing lowercase tableName
     std:: string tableName; ///String containing tableName
     std::string tablePath; ///String containing tablePath
+    std::string indexPath; ///String containing the path of the index file
+    std::vector<std::shared_ptr<Index>> indexes; ///Secondary indexes on the columns
+    std::vector<std::string> indexNames; ///Names of the indexes in the index file, read with the schema
+    std::shared_ptr<WriteAheadLog> wal; ///Write-ahead log of the database, null for a table outside one
+    std::atomic<Transaction *> transaction; ///Transaction locking the table and holding back its records, null if unlocked
+    std::vector<WriteAheadLog::Record> pending; ///Records logged since the file was written, applied by load
+    uint64_t fileLsn; ///Sequence number of the last record held by the table file
+    uint64_t lastLsn; ///Sequence number of the last record applied to the table
+    size_t fileBytes; ///Holds the size of the table file
+    uint32_t fileChecksum; ///Holds the checksum of the table file
     size_t rowNum; ///Holds the number of rows in the column
-    int rowAdjust; ///Holds an adjustment amount for reloading the file after delete
+    std::atomic<bool> loaded; ///Holds if the rows have been loaded
 protected:
+    std::shared_ptr<Table> published; ///Snapshot read by queries, null until the rows are loaded
+    std::mutex loadLatch; ///Latch held while the rows are loaded
 };
 
 #endif // TABLE_H
@@ -0,0 +1,73 @@
+/*!
+ * \file Transaction.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for Transaction Class
+ *
+ */
+
+#ifndef TRANSACTION_H
+#define TRANSACTION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "WriteAheadLog.h"
+
+class Table;
+
+/*!
+ * \class Transaction
+ *
+ * \brief This class holds the changes of a transaction until it ends
+ *
+ * Statements run between BEGIN and COMMIT change the tables in memory as
+ * usual, so the transaction reads its own changes, but the records of the
+ * changes are held here instead of being written to the write-ahead log.
+ * Each table the transaction changes is locked by it until it ends.
+ * The held records are the delta of the transaction: the rows inserted,
+ * the cells updated and the rows deleted, in the order they were made.
+ *
+ * COMMIT writes the held records to the log and syncs it once, so the whole
+ * transaction becomes durable at once or not at all, and only then makes
+ * the changes visible to other sessions. ROLLBACK drops them and puts
+ * back the image of each table taken when the transaction locked it, a
+ * snapshot sharing the columns and indexes as last committed, so undoing
+ * the changes costs the number of columns rather than the size of the
+ * table.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class Transaction {
+public:
+    /*!
+     * \struct Change
+     *
+     * \brief Record held back until commit
+     */
+    struct Change {
+        Table *table; ///Changed table
+        WriteAheadLog::Kind kind; ///Change held by the record
+        std::string payload; ///Encoded change
+    };
+
+    Transaction(); ///Default constructor
+    virtual ~Transaction(); ///Default deconstructor
+
+    void log(Table &table, WriteAheadLog::Kind kind, const std::string &payload); ///Function to hold back a record
+    void lock(Table &table); ///Function to lock a table for the transaction
+    bool commit(WriteAheadLog &wal); ///Function to make the changes durable
+    void rollback(); ///Function to undo the changes
+
+    std::vector<Change> changes; ///Records held back in the order they were made
+    std::vector<Table *> tables; ///Tables locked by the transaction
+    std::vector<std::shared_ptr<Table>> images; ///Rows of each locked table as last committed, put back by a rollback
+};
+
+#endif // TRANSACTION_H
@@ -0,0 +1,91 @@
+/*!
+ * \file WriteAheadLog.h
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * Header for WriteAheadLog Class
+ *
+ */
+
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \class WriteAheadLog
+ *
+ * \brief This class logs the changes made to the tables of a database
+ *
+ * Every change to the rows of a table is appended to the log of its
+ * database as a redo record before the statement finishes, and the table
+ * files only hold the rows as of their last checkpoint. Each record has a
+ * log sequence number, and a table file holds the number of the last
+ * record it includes, so the records a table still needs are the ones
+ * past it. The records of a transaction are written between a begin
+ * record and a commit record naming it, and are only read back once the
+ * commit record is, so a transaction is replayed whole or not at all.
+ *
+ * Records are written as they are made but only synced to disk by commit.
+ * The caller commits when it runs out of statements to run or after a
+ * statement leaves enough bytes unsynced, so a batch of statements shares
+ * a single sync and no sync lands inside one statement or transaction. Once every table
+ * file has been checkpointed the log is emptied by reset.
+ *
+ * \author Christopher Mollise
+ * \date 5/6/20
+ */
+class WriteAheadLog {
+public:
+    /** Changes a record can hold **/
+    enum Kind { INSERT_ROWS, UPDATE_ROWS, DELETE_ROWS, BEGIN_TRANSACTION, COMMIT_TRANSACTION };
+
+    /*!
+     * \struct Record
+     *
+     * \brief Change read back from the log
+     */
+    struct Record {
+        uint64_t lsn; ///Sequence number of the record
+        Kind kind; ///Change held by the record
+        std::string table; ///Lowercase name of the changed table
+        std::string payload; ///Encoded change, in the format of its kind
+    };
+
+    static const size_t GROUP_COMMIT_BYTES = 1 << 20; ///Unsynced bytes after which the log is synced between statements
+    static const size_t CHECKPOINT_BYTES = 16 << 20; ///Size of the log past which the tables are checkpointed
+
+    WriteAheadLog(std::string newPath); ///Default constructor
+    virtual ~WriteAheadLog(); ///Default deconstructor
+
+    WriteAheadLog(const WriteAheadLog &) = delete; ///Logs are not copied
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete; ///Logs are not copied
+
+    bool open(uint64_t after, std::vector<Record> &records); ///Function to read back the records and open the log
+    uint64_t append(Kind kind, const std::string &table, const std::string &payload); ///Function to append a record
+    bool commit(); ///Function to sync the appended records
+    bool truncate(size_t length, uint64_t lastKept); ///Function to take back the records past a length
+    bool reset(); ///Function to empty the log after a checkpoint
+    uint64_t lastLsn() const; ///Function to get the number of the last record
+    size_t size() const; ///Function to get the length of the log
+    size_t unsyncedSize() const; ///Function to get the bytes written since the last sync
+    static uint32_t checksum(const char *data, size_t length); ///Function to compute the checksum of a record
+    static bool syncFile(const std::string &path); ///Function to flush a written file to disk
+protected:
+    size_t scan(std::vector<Record> &records, uint64_t &lastLsn,
+        size_t &logBytes) const; ///Function to read the records of the log
+    bool writeAll(const std::string &data); ///Function to write bytes at the end of the log
+
+    std::string path; ///String containing the path of the log
+    int fileDescriptor; ///Holds the open log, negative if it is not open
+    uint64_t nextLsn; ///Number given to the next record
+    size_t bytes; ///Holds the length of the log
+    size_t unsynced; ///Holds the bytes written since the last sync
+};
+
+#endif // WRITEAHEADLOG_H
@@ -22,20 +22,31 @@
  *
  * This file is the main line of execution. From this file the database is
  * read into the program to act as a starting point for other manipulations.
- * This file also contains the main parser and handles the main database
- * commands. Commands that are not executed by this parse are sent to
- * individual parsers in the Database class and beyond. If a command cannot
- * be executed from any parser it will return to the main parser function to
+ * This file also contains the main parser, which reads whole statements,
+ * parses them into syntax trees and handles the main database commands.
+ * Statements that are not executed here are sent to the used Database and
+ * beyond. If a statement cannot be parsed or executed the main parser will
  * state an error and end the program.
  *
+ * The program can also run as a server, serving sessions to clients over
+ * a Unix domain socket. Each session has its own used database and
+ * transaction and shares the loaded databases with the other sessions.
+ *
  */
 
 #include <experimental/filesystem>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "include/Database.h"
+#include "include/Output.h"
+#include "include/Parser.h"
+#include "include/Server.h"
+#include "include/Sorter.h"
+#include "include/StatementReader.h"
 
 /// Std name space for general use
 using namespace std;
@@ -44,6 +55,9 @@ using namespace std;
 /// Not using whole name space as it is not needed
 namespace fs = std::experimental::filesystem;
 
+/// Latch held while the list of databases is read or changed
+static mutex listLatch;
+
  /*!
  * \brief Initial configuration system for database
  *
@@ -54,236 +68,253 @@ namespace fs = std::experimental::filesystem;
  * and the actual database. Will construct the individual databases from
  * the directory and then add the name of the database to a public variable.
  *
- * \param[out] vector<Database> &dataBases
+ * \param[out] vector<shared_ptr<Database>> &dataBases
  *             Vector of the Database class used for containing all data
  * \note Makes use of the default class constructors of Database.
  */
-void updateDataBase(vector<Database> &dataBases) {
+void updateDataBase(vector<shared_ptr<Database>> &dataBases) {
 	string name; ///String containing database name
 
 	/** Directory Reader **/
 	for(auto &p: fs::directory_iterator("Databases")){
         /// Push new database to vector for each directory found
-		dataBases.push_back(Database(p.path()));
+		dataBases.push_back(make_shared<Database>(p.path()));
         /// Get the name of the directory from the path and add to class
 		name = p.path().string();
 		name = name.substr(name.find('/') + 1);
-		dataBases.back().dataBaseName = name;
+		dataBases.back()->dataBaseName = name;
 	}
 }
+/*!
+ * \brief Function for finding a database by name
+ *
+ * \param[in] vector<shared_ptr<Database>> &dataBases
+ *            Vector of the Database class used for containing all data
+ * \param[in] string name
+ *            String containing the database name
+ * \return Database pointer to the database, or null if it does not exist
+ */
+shared_ptr<Database> findDataBase(vector<shared_ptr<Database>> &dataBases, const string &name) {
+	lock_guard<mutex> guard(listLatch); /// Latch held while the list is read
+
+	for (auto &inputDataBase: dataBases){
+		if (inputDataBase->dataBaseName == name)
+			return inputDataBase;
+	}
+	return nullptr;
+}
+/*!
+ * \brief Function for copying the list of databases
+ *
+ * \param[in] vector<shared_ptr<Database>> &dataBases
+ *            Vector of the Database class used for containing all data
+ * \return vector holding every database, safe to walk while the list changes
+ */
+vector<shared_ptr<Database>> listDataBases(vector<shared_ptr<Database>> &dataBases) {
+	lock_guard<mutex> guard(listLatch); /// Latch held while the list is read
+
+	return dataBases;
+}
 /*!
  * \brief Function for the create database function
  *
  * This function will add a database to the internal Database list and then
- * replicate this database on a file level. When the main parser detects the
- * CREATE command and no database has been used it will direct to this
- * function. The function will then create a directory based on the name and
- * accept or deny it from the database if the directory does or does not
- * exist. It will then output the appropriate error messages.
+ * replicate this database on a file level. When the main parser reads a
+ * CREATE DATABASE statement it will direct to this function. The function
+ * will then create a directory based on the name and accept or deny it from
+ * the database if the directory does or does not exist. It will then output
+ * the appropriate error messages.
  *
- * \param[out] vector<Database> &dataBases
+ * \param[out] vector<shared_ptr<Database>> &dataBases
  *             Vector of the Database class used for containing all data
- * \return  boolean true/false
- *          True or false value depending on state of function. False only
- *          sent if the parser cannot interpret the error and will send true
- *          in case of a processed create command if it is created or not.
+ * \param[in] NameStatement statement
+ *            Syntax tree of the statement
  */
-bool createDataBase(vector<Database> &dataBases) {
-    string input; /// String containing input from user
+void createDataBase(vector<shared_ptr<Database>> &dataBases, const NameStatement &statement) {
     fs::path dataPath = "Databases/"; /// Directory path for created database
-
-    /** Receive and Check Input From User **/
-    cin >> input;
-    if (input != "DATABASE") /// Unknown command if DATABASE not specified
-        return false;
-    cin >> input;
-    if (input.back() != ';') /// Unknown command if no ";" at end of function
-        return false;
+    lock_guard<mutex> guard(listLatch); /// Latch held while the list is changed
 
     /** Process path for creating directory **/
-    input.pop_back();
-    dataPath += input;
+    dataPath += statement.name;
 
     /** Attempt to create directory at path **/
     if(!fs::create_directory(dataPath)) /// Create and output error if fails
     {
-        cout << "!Failed to create database "
-             << input
+        Output::stream() << "!Failed to create database "
+             << statement.name
              << " because it already exists." << endl;
     }
     else /// Output message if success and add database to internal list
     {
-    	dataBases.push_back(Database(dataPath));
-    	dataBases.back().dataBaseName = input;
-        cout << "Database "
-             << input
+    	dataBases.push_back(make_shared<Database>(dataPath));
+    	dataBases.back()->dataBaseName = statement.name;
+        Output::stream() << "Database "
+             << statement.name
              << " created." << endl;
     }
-    return true; /// Return true for end of processing
 }
 /*!
  * \brief Function for the drop database function
  *
  * This function will drop a database from the internal Database list and then
- * replicate this deletion on a file level. When the main parser detects the
- * DROP command and no database has been used it will direct to this
- * function. The function will then drop a directory based on the name and
- * drop or deny it from the database if the directory does or does not
- * exist. It will then output the appropriate error messages.
+ * replicate this deletion on a file level. When the main parser reads a
+ * DROP DATABASE statement it will direct to this function. The function will
+ * then drop a directory based on the name and drop or deny it from the
+ * database if the directory does or does not exist. It will then output the
+ * appropriate error messages.
  *
- * \param[out] vector<Database> &dataBases
+ * \param[out] vector<shared_ptr<Database>> &dataBases
  *             Vector of the Database class used for containing all data
- * \return boolean true/false
- *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not.
+ * \param[in] NameStatement statement
+ *            Syntax tree of the statement
  */
-bool dropDataBase(vector<Database> &dataBases) {
-	string input; /// String containing input from user
+void dropDataBase(vector<shared_ptr<Database>> &dataBases, const NameStatement &statement) {
     fs::path dataPath = "Databases/"; /// Directory path for deleted database
-
-    /** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "DATABASE") /// Unknown command if DATABASE not specified
-        return false;
-    cin >> input;
-    if (input.back() != ';') /// Unknown command if no ";" at end of function
-        return false;
+    lock_guard<mutex> guard(listLatch); /// Latch held while the list is changed
 
     /** Process path for deleting directory **/
-    input.pop_back();
-    dataPath += input;
+    dataPath += statement.name;
 
     /** Attempt to delete directory at path **/
     if(!fs::remove_all(dataPath)) /// Delete and output error if fails
     {
-        cout << "!Failed to delete "
-             << input
+        Output::stream() << "!Failed to delete "
+             << statement.name
              << " because it does not exist." << endl;
     }
     else /// Output message if success and add database to internal list
     {
         /** Locate internal database to also remove **/
         for (size_t i = 0; i < dataBases.size(); i++){
-            if (dataBases[i].dataBaseName == input)
+            if (dataBases[i]->dataBaseName == statement.name)
             	dataBases.erase(dataBases.begin() + i);
         }
 
-        cout << "Database "
-             << input
+        Output::stream() << "Database "
+             << statement.name
              << " deleted." << endl;
     }
-    return true; /// Return true for end of processing
 }
 /*!
  * \brief Function for the use database command
  *
  * This function will use a database from the internal Database list for use
- * in table manipulation. When the main parser detects the USE command
- * it will direct to this function. The function will use the database if it
- * exists or give an error message if it does not. It will then call the
- * parser for the individual database for use of their parser.
+ * in table manipulation. When the main parser reads a USE statement it will
+ * direct to this function. The function will use the database if it exists
+ * or give an error message if it does not.
  *
- * \param[out] vector<Database> &dataBases
+ * \param[out] vector<shared_ptr<Database>> &dataBases
  *             Vector of the Database class used for containing all data
- * \return string containing "END" or last used command
- *         When a command is not recognized in the secondary parser it is
- *         brought back to the main parser to interpret. If the secondary
- *         parser encounters an error it will send END signaling to close the
- *         program.
- * \note Directs flow of program to the parser in the Database class.
+ * \param[in] NameStatement statement
+ *            Syntax tree of the statement
+ * \return boolean true/false
+ *         False if the database does not exist, signaling to end the program.
  */
-string useDataBase(vector<Database> &dataBases) {
-	string input; /// String containing input from user
-
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input.back() != ';')
-		return "END";
-
-    /** Process input before selecting internal database **/
-	input.pop_back();
-
+bool useDataBase(vector<shared_ptr<Database>> &dataBases, const NameStatement &statement) {
 	/** Locate internal database use **/
-	for (auto inputDataBase: dataBases){
-		if (inputDataBase.dataBaseName == input) {
-			cout << "Using database "
-			     << input
-				 << '.' << endl;
-             /** Return function call to the database parser command **/
-			return inputDataBase.dataBaseParser();
-		}
+	if (findDataBase(dataBases, statement.name) != nullptr) {
+		Output::stream() << "Using database "
+		     << statement.name
+			 << '.' << endl;
+		return true;
 	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to use database "
-	     << input
+	Output::stream() << "!Failed to use database "
+	     << statement.name
 	     << " because it does not exist." << endl;
 
-	return "END"; ///Return END to signal ending program
+	return false; ///Return false to signal ending program
 }
 /*!
- * \brief Function for the use database command
+ * \brief Function for the main parser
  *
- * This function will use a database from the internal Database list for use
- * in table manipulation. When the main parser detects the USE command
- * it will direct to this function. The function will use the database if it
- * exists or give an error message if it does not. It will then call the
- * parser for the individual database for use of their parser.
+ * This function will read the input one statement at a time and parse each
+ * statement into its syntax tree. Statements on the database list are
+ * handled here and the rest are sent to the used database. A statement that
+ * cannot be parsed or executed states an error and ends the program.
+ *
+ * The changes logged by the statements are synced together whenever no
+ * more input is waiting, so a script commits in a few large batches while
+ * a statement typed at the prompt is durable before the next one is read.
+ * They are synced again when the session ends, however it ends.
+ *
+ * Each call runs one session, keeping its own used database and open
+ * transaction. A transaction still open when the session ends is rolled
+ * back.
  *
- * \param[out] vector<Database> &dataBases
+ * \param[out] vector<shared_ptr<Database>> &dataBases
  *             Vector of the Database class used for containing all data
+ * \param[in] istream in
+ *            Stream the statements of the session are read from
  * \note Controls main flow of project with while loop controlling all parsing
  */
-void mainParser(vector<Database> &dataBases) {
-    string input; /// String containing input from user
+void mainParser(vector<shared_ptr<Database>> &dataBases, istream &in) {
+    StatementReader reader(in); /// Reader splitting the input into statements
+    string text; /// String containing the text of a statement
+    string usedName; /// String containing the name of the used database
+    shared_ptr<Transaction> transaction; /// Open transaction of the session, empty outside one
+    shared_ptr<Database> transactionDataBase; /// Database the open transaction runs on
     bool endInput = false; /// Boolean switch to end program
-    bool returnedInput = false; /// Boolean switch to use secondary parse input
+    bool exitInput = false; /// Boolean switch set by the exit command
 
     /** Main Control Loop **/
-    while (!endInput) {
-        if (returnedInput) /// Check if input was passed from secondary parser
-            returnedInput = false;
-        else /// Receive an input token from user
-            cin >> input;
-        /** Exit and Ignore Commands **/
-        if (input[0] == '-') /// Ignore inputs starting with - and remove line
-        {
-            cin.ignore();
-            getline (cin, input);
-        }
-        else if (input == ".EXIT" || input == ".exit") /// EXIT command
+    while (!endInput && !exitInput && reader.next(text)) {
+        unique_ptr<Statement> statement = Parser(text).parse(); /// Syntax tree of the statement
+        shared_ptr<Database> usedDataBase = findDataBase(dataBases, usedName); /// Database in use
+
+        if (!statement) /// Statement does not follow the grammar
         {
-        	cout << "All done." << endl;
-        	return;
+            endInput = true;
+            break;
         }
+        switch (statement->kind) {
+        /** Exit Command **/
+        case Statement::EXIT:
+        	Output::stream() << "All done." << endl;
+        	exitInput = true;
+        	break;
 
         /** Database Creation/Deletion/Use Commands **/
-        else if (input == "CREATE") /// CREATE command
-        {
-            if (!createDataBase(dataBases)) /// Call create function for failure
+        case Statement::CREATE_DATABASE:
+            createDataBase(dataBases, static_cast<const NameStatement &>(*statement));
+            break;
+        case Statement::DROP_DATABASE:
+            dropDataBase(dataBases, static_cast<const NameStatement &>(*statement));
+            break;
+        case Statement::USE_DATABASE:
+            if (transaction) /// Keep the transaction on its own database
+                Output::stream() << "!Failed to use database "
+                     << static_cast<const NameStatement &>(*statement).name
+                     << " because a transaction is open." << endl;
+            else if (useDataBase(dataBases, static_cast<const NameStatement &>(*statement)))
+                usedName = static_cast<const NameStatement &>(*statement).name;
+            else /// Check if the database could not be used
                 endInput = true;
+            break;
+
+        /** Table Commands Run on the Used Database **/
+        default:
+            if (usedDataBase == nullptr || !usedDataBase->execute(*statement, transaction))
+                endInput = true;
+            transactionDataBase = transaction ? usedDataBase : nullptr;
+            break;
         }
-        else if (input == "DROP") /// DROP command
-        {
-            if (!dropDataBase(dataBases)) /// Call drop function for failure
-            	endInput = true;
-        }
-        else if (input == "USE") /// USE command
-        {
-        	input = useDataBase(dataBases); /// Call use function for input
-        	if (input == "END") /// Check if secondary parser failed
-        		endInput = true;
-        	else /// Tell main parser to not receive a new input for secondary
-        		returnedInput = true;
+        /** Commit the logged changes as a group before waiting for input **/
+        if (!reader.ready()) {
+            for (auto &inputDataBase: listDataBases(dataBases))
+                inputDataBase->commit();
         }
-
-        /** No Acceptable Command **/
-        else
-            endInput = true;
     }
     /** Send Unknown Error if parser fails **/
-    cout << "!Unknown Command." << endl;
+    if (endInput)
+        Output::stream() << "!Unknown Command." << endl;
+    /** Undo a transaction the session left open **/
+    if (transaction)
+        transactionDataBase->rollback(transaction);
+    /** Sync the changes the session logged before it ends **/
+    for (auto &inputDataBase: listDataBases(dataBases))
+        inputDataBase->commit();
 }
 /*!
  * \brief Function for the main program execution
@@ -293,16 +324,65 @@ void mainParser(vector<Database> &dataBases) {
  * the "Databases" folder that contains all database info if it does not exist.
  * The program will then call the main parser and run the project.
  *
+ * The option --sort-memory followed by a number of megabytes sets how much
+ * memory ORDER BY may hold before it spills sorted runs to temporary files.
+ *
+ * The option --listen followed by a socket path runs the program as a
+ * server, with --threads setting how many sessions are served at once.
+ * The option --connect followed by a socket path runs the program as a
+ * client of such a server, sending it the input and printing the results.
+ *
+ * \param[in] int argc
+ *            Number of command line arguments
+ * \param[in] char *argv[]
+ *            Command line arguments
+ *
  * \note Main function
  */
-int main() {
-	vector <Database> dataBases; /// List object containing all databases
+int main(int argc, char *argv[]) {
+	vector<shared_ptr<Database>> dataBases; /// List object containing all databases
+	string listenPath; /// Socket path the server listens on, empty outside server mode
+	string connectPath; /// Socket path of the server to connect to, empty outside client mode
+	size_t threads = 8; /// Number of sessions the server serves at once
+	/** Let the input buffer report how much of it is waiting **/
+	ios::sync_with_stdio(false);
+	/** Read the command line options **/
+	for (int i = 1; i < argc; i++) {
+		string option = argv[i]; /// Option being read
+		bool number = i + 1 < argc && string(argv[i + 1]).find_first_not_of("0123456789") == string::npos
+			&& stoul(argv[i + 1]) > 0; /// Bool if the option is followed by a positive number
+		if (option == "--sort-memory" && number)
+			Sorter::memoryBytes = stoul(argv[++i]) * 1024 * 1024;
+		else if (option == "--threads" && number)
+			threads = stoul(argv[++i]);
+		else if (option == "--listen" && i + 1 < argc)
+			listenPath = argv[++i];
+		else if (option == "--connect" && i + 1 < argc)
+			connectPath = argv[++i];
+		else {
+			cerr << "Usage: " << argv[0] << " [--sort-memory megabytes]"
+				 << " [--listen socket [--threads count] | --connect socket]" << endl;
+			return 1;
+		}
+	}
+	/** Send the input to a server instead **/
+	if (!connectPath.empty())
+		return Server::connect(connectPath);
 	/** Create Directory for project use **/
 	fs::create_directory("Databases");
 	/** Update the virtual database to match the physical database **/
 	updateDataBase(dataBases);
+	/** Serve sessions over the socket **/
+	if (!listenPath.empty()) {
+		Server server(listenPath, threads, [&dataBases](istream &in, ostream &out) {
+			Output::redirect(&out);
+			mainParser(dataBases, in);
+			Output::redirect(nullptr);
+		});
+		return server.run();
+	}
 	/** Call the main parser **/
-    mainParser(dataBases);
+    mainParser(dataBases, cin);
     /** End the Program **/
     return 0;
 }
@@ -0,0 +1,363 @@
+/*!
+ * \file Aggregation.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Aggregation class. The aggregated
+ * rows are either every row of the table or a list of rows matching a
+ * where clause, and the ith aggregated row is rows[i] or i respectively.
+ * Each pass is written once for each case so that a whole table is read
+ * without the list.
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+#include "../include/Aggregation.h"
+#include "../include/Output.h"
+#include "../include/RowCursor.h"
+#include "../include/Sorter.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the Aggregation class
+ *
+ * \param[in] vector<Column> newColumns
+ *            Columns of the table, which must outlive the aggregation
+ */
+Aggregation::Aggregation(const vector<Column> &newColumns) : columns(newColumns) {
+	empty = false;
+}
+/*!
+ * \brief Deconstructor of the Aggregation class
+ *
+ * This function will deconstruct the Aggregation class. This currently has
+ * no effect on the class.
+ *
+ */
+Aggregation::~Aggregation() {
+
+}
+/*!
+ * \brief Position of a column
+ *
+ * \param[in] string name
+ *            Name of the column
+ * \return int position of the column, -1 if the table has none by the name
+ */
+int Aggregation::findColumn(const string &name) const {
+	for (size_t i = 0; i < columns.size(); i++) {
+		if (columns[i].colName == name)
+			return i;
+	}
+	return -1;
+}
+/*!
+ * \brief Find the aggregated columns
+ *
+ * This function will find the column of every item and GROUP BY column,
+ * name the result columns and find the result column of every ORDER BY
+ * item.
+ *
+ * \param[in] vector<SelectItem> items
+ *            Selected columns and aggregates in order
+ * \param[in] vector<string> groupBy
+ *            Names of the GROUP BY columns
+ * \param[in] vector<OrderItem> orderBy
+ *            Selected columns and aggregates the groups are ordered by
+ * \return boolean false if a column is unknown, a plain column is not
+ *         grouped, a char column is summed or averaged or an ORDER BY
+ *         item is not selected
+ */
+bool Aggregation::bind(const vector<SelectItem> &items, const vector<string> &groupBy,
+	const vector<OrderItem> &orderBy) {
+	for (const string &name: groupBy) {
+		int col = findColumn(name); ///Position of the grouped column
+		if (col == -1)
+			return false;
+		groupCols.push_back(col);
+	}
+	for (const SelectItem &item: items) {
+		Output output; ///Result column of the item
+		output.col = item.column == "*" ? -1 : findColumn(item.column);
+		if (output.col == -1 && item.column != "*")
+			return false;
+		const Column *source = output.col == -1 ? nullptr : &columns[output.col]; ///Aggregated column
+		string name = item.function + "(" + item.column + ")"; ///Name of the result column
+
+		if (item.function.empty()) {
+			/** A plain column must be one of the grouped columns **/
+			if (find(groupCols.begin(), groupCols.end(), (size_t)output.col) == groupCols.end())
+				return false;
+			output.function = GROUP;
+			results.push_back(Column(source->colName, source->colType, source->colSize));
+		}
+		else if (item.function == "COUNT") {
+			output.function = COUNT;
+			results.push_back(Column(name, "int", 0));
+		}
+		else if (item.function == "SUM" || item.function == "AVG") {
+			if (source == nullptr || source->isChar())
+				return false;
+			output.function = item.function == "SUM" ? SUM : AVG;
+			results.push_back(Column(name, "float", 0));
+		}
+		else if (item.function == "MIN" || item.function == "MAX") {
+			if (source == nullptr)
+				return false;
+			output.function = item.function == "MIN" ? MIN : MAX;
+			results.push_back(Column(name, source->colType, source->colSize));
+		}
+		else
+			return false;
+		outputs.push_back(output);
+	}
+	for (const OrderItem &order: orderBy) {
+		size_t o = 0; ///Position of the ordered item in the select
+		while (o < items.size() && (items[o].function != order.item.function || items[o].column != order.item.column))
+			o++;
+		if (o == items.size())
+			return false;
+		orderCols.emplace_back(o, order.descending);
+	}
+	return true;
+}
+/*!
+ * \brief Number the groups of the rows
+ *
+ * This function will give every aggregated row the number of its group,
+ * numbering the groups in the order they are first found. A single int
+ * column is grouped by its value, other columns by the encoded bytes of
+ * the grouped values.
+ *
+ * \param[in] vector<size_t> *rows
+ *            Rows to aggregate, null for every row
+ * \param[in] size_t count
+ *            Number of rows to aggregate
+ */
+void Aggregation::assignGroups(const vector<size_t> *rows, size_t count) {
+	groupOf.resize(count);
+	if (groupCols.size() == 1 && columns[groupCols[0]].layout == Column::INT_LAYOUT) {
+		const int32_t *data = columns[groupCols[0]].intValues(); ///Values of the grouped column
+		unordered_map<int32_t, uint32_t> groups; ///Group of each value
+		for (size_t i = 0; i < count; i++) {
+			size_t row = rows != nullptr ? (*rows)[i] : i; ///Aggregated row
+			auto found = groups.emplace(data[row], (uint32_t)firstRows.size());
+			if (found.second) {
+				firstRows.push_back(row);
+				groupSizes.push_back(0);
+			}
+			groupOf[i] = found.first->second;
+			groupSizes[groupOf[i]]++;
+		}
+		return;
+	}
+
+	unordered_map<string, uint32_t> groups; ///Group of each encoded key
+	string key; ///Encoded values of the grouped columns
+	for (size_t i = 0; i < count; i++) {
+		size_t row = rows != nullptr ? (*rows)[i] : i; ///Aggregated row
+		key.clear();
+		for (size_t col: groupCols)
+			columns[col].encode(row, key);
+		auto found = groups.find(key);
+		if (found == groups.end()) {
+			found = groups.emplace(key, (uint32_t)firstRows.size()).first;
+			firstRows.push_back(row);
+			groupSizes.push_back(0);
+		}
+		groupOf[i] = found->second;
+		groupSizes[groupOf[i]]++;
+	}
+}
+/*!
+ * \brief Sum a column by group
+ *
+ * Int columns are summed as 64 bit integers so the sum is exact.
+ *
+ * \param[in] Output output
+ *            Result column of the sum
+ * \param[in] vector<size_t> *rows
+ *            Rows to aggregate, null for every row
+ * \param[in] size_t count
+ *            Number of rows to aggregate
+ * \param[out] vector<double> sums
+ *             Sum of each group
+ */
+void Aggregation::sum(const Output &output, const vector<size_t> *rows, size_t count, vector<double> &sums) const {
+	const Column &source = columns[output.col]; ///Summed column
+	bool grouped = !groupCols.empty(); ///Bool if the rows have group numbers
+
+	if (source.layout == Column::INT_LAYOUT) {
+		const int32_t *data = source.intValues(); ///Values of the column
+		vector<int64_t> totals(sums.size()); ///Exact sum of each group
+		if (!grouped && rows == nullptr) {
+			int64_t total = 0; ///Sum of the whole column
+			for (size_t i = 0; i < count; i++)
+				total += data[i];
+			totals[0] = total;
+		}
+		else {
+			for (size_t i = 0; i < count; i++)
+				totals[grouped ? groupOf[i] : 0] += data[rows != nullptr ? (*rows)[i] : i];
+		}
+		for (size_t g = 0; g < sums.size(); g++)
+			sums[g] = (double)totals[g];
+		return;
+	}
+
+	const double *data = source.floatValues(); ///Values of the column
+	if (!grouped && rows == nullptr) {
+		double total = 0; ///Sum of the whole column
+		for (size_t i = 0; i < count; i++)
+			total += data[i];
+		sums[0] = total;
+		return;
+	}
+	for (size_t i = 0; i < count; i++)
+		sums[grouped ? groupOf[i] : 0] += data[rows != nullptr ? (*rows)[i] : i];
+}
+/*!
+ * \brief Find the lowest or highest row of each group
+ *
+ * \param[in] Output output
+ *            Result column of the MIN or MAX
+ * \param[in] vector<size_t> *rows
+ *            Rows to aggregate, null for every row
+ * \param[in] size_t count
+ *            Number of rows to aggregate
+ * \param[out] vector<size_t> best
+ *             Row holding the lowest or highest value of each group
+ */
+void Aggregation::extreme(const Output &output, const vector<size_t> *rows, size_t count,
+	vector<size_t> &best) const {
+	const Column &source = columns[output.col]; ///Compared column
+	bool grouped = !groupCols.empty(); ///Bool if the rows have group numbers
+	int wanted = output.function == MIN ? -1 : 1; ///Order a better row has against the best so far
+
+	fill(best.begin(), best.end(), RowCursor::NO_ROW);
+	for (size_t i = 0; i < count; i++) {
+		size_t row = rows != nullptr ? (*rows)[i] : i; ///Aggregated row
+		size_t &group = best[grouped ? groupOf[i] : 0]; ///Best row of the group
+		int order; ///Order of the row against the best row so far
+		if (group == RowCursor::NO_ROW) {
+			group = row;
+			continue;
+		}
+		if (source.layout == Column::INT_LAYOUT)
+			order = (source.getInt(row) > source.getInt(group)) - (source.getInt(row) < source.getInt(group));
+		else if (source.layout == Column::FLOAT_LAYOUT)
+			order = (source.getFloat(row) > source.getFloat(group)) - (source.getFloat(row) < source.getFloat(group));
+		else {
+			int compared = source.getChars(row).compare(source.getChars(group)); ///Byte order of the values
+			order = (compared > 0) - (compared < 0);
+		}
+		if (order == wanted)
+			group = row;
+	}
+}
+/*!
+ * \brief Aggregate the rows
+ *
+ * This function will number the groups and fill every result column with
+ * one row per group.
+ *
+ * \param[in] vector<size_t> *rows
+ *            Rows to aggregate in ascending order, null for every row
+ * \param[in] size_t rowNum
+ *            Number of rows in the table
+ */
+void Aggregation::run(const vector<size_t> *rows, size_t rowNum) {
+	size_t count = rows != nullptr ? rows->size() : rowNum; ///Number of rows to aggregate
+	size_t groupNum; ///Number of groups
+
+	/** Number the groups, or put every row in one group **/
+	if (!groupCols.empty())
+		assignGroups(rows, count);
+	else {
+		firstRows.assign(1, count > 0 ? (rows != nullptr ? (*rows)[0] : 0) : RowCursor::NO_ROW);
+		groupSizes.assign(1, count);
+		empty = count == 0;
+	}
+	groupNum = firstRows.size();
+
+	/** Fill each result column in one pass over its column **/
+	for (size_t o = 0; o < outputs.size(); o++) {
+		const Output &output = outputs[o]; ///Result column being filled
+		Column &result = results[o]; ///Values of the result column
+		Value value; ///Value appended to the result
+		value.valid = true;
+		if (output.function == GROUP) {
+			for (size_t g = 0; g < groupNum; g++)
+				result.appendRow(columns[output.col], firstRows[g]);
+		}
+		else if (output.function == COUNT) {
+			value.integral = true;
+			for (size_t g = 0; g < groupNum; g++) {
+				value.intValue = groupSizes[g];
+				result.append(value);
+			}
+		}
+		else if (output.function == SUM || output.function == AVG) {
+			vector<double> sums(groupNum); ///Sum of each group
+			if (!empty)
+				sum(output, rows, count, sums);
+			for (size_t g = 0; g < groupNum; g++) {
+				value.floatValue = output.function == SUM ? sums[g] : sums[g] / groupSizes[g];
+				result.append(value);
+			}
+		}
+		else {
+			vector<size_t> best(groupNum); ///Lowest or highest row of each group
+			extreme(output, rows, count, best);
+			for (size_t g = 0; g < groupNum; g++) {
+				if (best[g] != RowCursor::NO_ROW)
+					result.appendRow(columns[output.col], best[g]);
+			}
+		}
+	}
+}
+/*!
+ * \brief Write the result rows
+ *
+ * Each result column has its own cursor slot so the aggregates of an
+ * empty input can be written as empty values next to its count. The
+ * groups are sorted by the result columns of the ORDER BY items, an empty
+ * input having only its one row.
+ *
+ * \param[in,out] ResultSink sink
+ *                Sink the rows are written to
+ * \param[in] size_t limit
+ *            Most groups written
+ */
+void Aggregation::write(ResultSink &sink, size_t limit) const {
+	RowCursor cursor(outputs.size()); ///Cursor handing out the result values
+	Sorter sorter; ///Order of the groups
+	auto writeGroup = [this, &cursor, &sink](size_t g) { ///Function writing the values of a group
+		for (size_t o = 0; o < outputs.size(); o++)
+			cursor.seek(o, empty && outputs[o].function != COUNT ? RowCursor::NO_ROW : g);
+		sink.writeRow(cursor);
+	};
+
+	for (size_t o = 0; o < outputs.size(); o++)
+		cursor.project(results[o], o);
+	sink.writeHeader(cursor);
+	if (orderCols.empty() || empty) {
+		for (size_t g = 0; g < firstRows.size() && g < limit; g++)
+			writeGroup(g);
+	}
+	else {
+		for (const pair<size_t, bool> &order: orderCols)
+			sorter.addKey(results[order.first], order.second);
+		if (!sorter.sort(nullptr, firstRows.size(), limit, writeGroup))
+			::Output::stream() << "!Failed to order the rows because a temporary file could not be written." << endl;
+	}
+	sink.finish();
+}
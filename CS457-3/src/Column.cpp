@@ -10,8 +10,17 @@
  * like a struct but can be expanded for additional functionality.
  * The class holds the needed information to form a table.
  *
+ * Column data is held in typed storage picked from the column type so
+ * that values are parsed once on the way in and compared natively.
+ *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include "../include/Column.h"
 
 ///std name space for general use
@@ -21,7 +30,8 @@ using namespace std;
  * \brief Constructor of the column class
  *
  * This function will construct the Column class by reading its
- * setting its individual attributes based on input.
+ * setting its individual attributes based on input. The storage layout
+ * of the column is picked from its type.
  *
  * \param[in] string newColName
  *            String corresponding to the column name
@@ -34,6 +44,16 @@ Column::Column(string newColName, string newColType, int newColSize) {
     colName = newColName;
     colType = newColType;
     colSize = newColSize;
+
+    /** Pick the storage layout from the type **/
+    if (colType == "int")
+        layout = INT_LAYOUT;
+    else if (colType == "float")
+        layout = FLOAT_LAYOUT;
+    else
+        layout = CHAR_LAYOUT;
+    storage = make_shared<Storage>();
+    storage->charOffsets.push_back(0);
 }
 /*!
  * \brief Deconstructor of the Column class
@@ -45,3 +65,740 @@ Column::Column(string newColName, string newColType, int newColSize) {
 Column::~Column() {
     //dtor
 }
+/*!
+ * \brief Row count of the column
+ *
+ * \return size_t number of rows stored in the column
+ */
+size_t Column::size() const {
+    if (mapping)
+        return mappedRows;
+    if (layout == INT_LAYOUT)
+        return storage->intData.size();
+    else if (layout == FLOAT_LAYOUT)
+        return storage->floatData.size();
+    return storage->charOffsets.size() - 1;
+}
+/*!
+ * \brief Check for a character column
+ *
+ * \return boolean true if the column is of type char or varchar
+ */
+bool Column::isChar() const {
+    return layout == CHAR_LAYOUT;
+}
+/*!
+ * \brief Literal parser for the column
+ *
+ * This function will parse a literal as typed by the user into its native
+ * form for this column. Numbers are read for int and float columns and
+ * quotes are removed for char columns. Numeric columns accept any number
+ * so that comparisons with the other numeric type stay possible, the
+ * stricter check for storing a value is done when appending.
+ *
+ * \param[in] string literal
+ *            String holding the literal as typed
+ * \param[out] Value value
+ *             Value receiving the parsed literal
+ * \return boolean true if the literal could be read for the column type
+ */
+bool Column::parse(const string &literal, Value &value) const {
+    char *end; ///Pointer to the end of the parsed number
+
+    value = Value();
+    /** Remove the quotes around a char literal **/
+    if (layout == CHAR_LAYOUT) {
+        if (literal.size() >= 2 && (literal.front() == '\'' || literal.front() == '"')
+            && literal.back() == literal.front())
+            value.charValue = literal.substr(1, literal.size() - 2);
+        else
+            value.charValue = literal;
+        value.valid = true;
+        return true;
+    }
+    if (literal.empty())
+        return false;
+
+    /** Read a whole number first and fall back to a decimal number **/
+    value.intValue = strtoll(literal.c_str(), &end, 10);
+    if (*end == '\0') {
+        value.integral = true;
+        value.floatValue = (double)value.intValue;
+    }
+    else {
+        value.floatValue = strtod(literal.c_str(), &end);
+        if (*end != '\0')
+            return false;
+    }
+    value.valid = true;
+    return true;
+}
+/*!
+ * \brief Storage check for the column
+ *
+ * This function will check if a parsed value can be stored in the column.
+ * Values such as a decimal number in an int column or a string longer than
+ * the column size are refused.
+ *
+ * \param[in] Value value
+ *            Value parsed for this column
+ * \return boolean true if the value can be stored
+ */
+bool Column::fits(const Value &value) const {
+    if (!value.valid)
+        return false;
+    if (layout == INT_LAYOUT)
+        return value.integral && value.intValue <= INT32_MAX && value.intValue >= INT32_MIN;
+    else if (layout == CHAR_LAYOUT)
+        return colSize <= 0 || value.charValue.size() <= (size_t)colSize;
+    return true;
+}
+/*!
+ * \brief Append method for the column
+ *
+ * This function will add a parsed value as a new row at the end of the
+ * column. Values that do not fit the column are refused.
+ *
+ * \param[in] Value value
+ *            Value parsed for this column
+ * \return boolean true if the value was stored
+ */
+bool Column::append(const Value &value) {
+    if (!fits(value))
+        return false;
+    own(1, value.charValue.size());
+    if (layout == INT_LAYOUT)
+        storage->intData.push_back((int32_t)value.intValue);
+    else if (layout == FLOAT_LAYOUT)
+        storage->floatData.push_back(value.floatValue);
+    else {
+        storage->charBytes += value.charValue;
+        storage->charOffsets.push_back(storage->charBytes.size());
+    }
+    return true;
+}
+/*!
+ * \brief Append method for literals read from a table file
+ *
+ * This function will parse and append a literal. If the literal does not
+ * fit the column a default value is stored instead so that every column of
+ * the table keeps the same number of rows.
+ *
+ * \param[in] string literal
+ *            String holding the literal as stored
+ * \return boolean true if the literal itself was stored
+ */
+bool Column::appendLiteral(const string &literal) {
+    Value value; ///Value parsed from the literal
+
+    if (parse(literal, value) && append(value))
+        return true;
+    own(1, 0);
+    /** Keep the rows aligned with a default value **/
+    if (layout == INT_LAYOUT)
+        storage->intData.push_back(0);
+    else if (layout == FLOAT_LAYOUT)
+        storage->floatData.push_back(0);
+    else
+        storage->charOffsets.push_back(storage->charBytes.size());
+    return false;
+}
+/*!
+ * \brief Append method for fields read from a data file
+ *
+ * This function will parse a field straight from the bytes of a data file
+ * and append it as a new row, without building a literal first. Char
+ * fields are stored as they are, numeric fields may be surrounded by
+ * spaces. Fields that do not fit the column are refused.
+ *
+ * \param[in] const char *field
+ *            Start of the field
+ * \param[in] size_t length
+ *            Number of bytes in the field
+ * \return boolean true if the field was stored
+ */
+bool Column::appendField(const char *field, size_t length) {
+    char buffer[64]; ///Null terminated copy of a numeric field
+    char *end; ///Pointer to the end of the parsed number
+
+    own(1, length);
+    if (layout == CHAR_LAYOUT) {
+        if (colSize > 0 && length > (size_t)colSize)
+            return false;
+        storage->charBytes.append(field, length);
+        storage->charOffsets.push_back(storage->charBytes.size());
+        return true;
+    }
+
+    /** Copy the number without its surrounding spaces **/
+    while (length > 0 && *field == ' ') {
+        field++;
+        length--;
+    }
+    while (length > 0 && field[length - 1] == ' ')
+        length--;
+    if (length == 0 || length >= sizeof(buffer))
+        return false;
+    memcpy(buffer, field, length);
+    buffer[length] = '\0';
+
+    if (layout == INT_LAYOUT) {
+        long long parsed = strtoll(buffer, &end, 10); ///Whole number read from the field
+        if (*end != '\0' || parsed > INT32_MAX || parsed < INT32_MIN)
+            return false;
+        storage->intData.push_back((int32_t)parsed);
+    }
+    else {
+        double parsed = strtod(buffer, &end); ///Decimal number read from the field
+        if (*end != '\0')
+            return false;
+        storage->floatData.push_back(parsed);
+    }
+    return true;
+}
+/*!
+ * \brief Append method for the rows of another column
+ *
+ * This function will append every row of a column with the same layout,
+ * copying its storage in bulk.
+ *
+ * \param[in] Column other
+ *            Column holding the rows to append
+ */
+void Column::appendColumn(const Column &other) {
+    size_t rows = other.size(); ///Number of appended rows
+
+    own(rows, isChar() ? other.charOffsetValues()[rows] : 0);
+    if (layout == INT_LAYOUT)
+        storage->intData.insert(storage->intData.end(), other.intValues(), other.intValues() + rows);
+    else if (layout == FLOAT_LAYOUT)
+        storage->floatData.insert(storage->floatData.end(), other.floatValues(), other.floatValues() + rows);
+    else {
+        const uint32_t *offsets = other.charOffsetValues(); ///Offsets of the appended rows
+        uint32_t base = storage->charBytes.size(); ///Offset of the appended bytes
+
+        storage->charBytes.append(other.charByteValues(), offsets[rows]);
+        for (size_t i = 1; i <= rows; i++)
+            storage->charOffsets.push_back(base + offsets[i]);
+    }
+}
+/*!
+ * \brief Append method for one row of another column
+ *
+ * \param[in] Column other
+ *            Column with the same layout holding the row
+ * \param[in] size_t row
+ *            Index of the row to append
+ */
+void Column::appendRow(const Column &other, size_t row) {
+    own(1, isChar() ? other.getChars(row).size() : 0);
+    if (layout == INT_LAYOUT)
+        storage->intData.push_back(other.getInt(row));
+    else if (layout == FLOAT_LAYOUT)
+        storage->floatData.push_back(other.getFloat(row));
+    else {
+        experimental::string_view chars = other.getChars(row); ///Bytes of the row
+        storage->charBytes.append(chars.data(), chars.size());
+        storage->charOffsets.push_back(storage->charBytes.size());
+    }
+}
+/*!
+ * \brief Assignment method for the column
+ *
+ * This function will set a value at each of the given rows. Numeric
+ * columns are written in place. Char columns rebuild their byte buffer
+ * once so that the whole statement costs a single pass.
+ *
+ * \param[in] vector<size_t> rows
+ *            Ascending list of the rows to change
+ * \param[in] Value value
+ *            Value parsed for this column
+ */
+void Column::assign(const vector<size_t> &rows, const Value &value) {
+    if (rows.empty())
+        return;
+    own(IN_PLACE, 0);
+    if (layout == INT_LAYOUT) {
+        for (size_t row: rows)
+            storage->intData[row] = (int32_t)value.intValue;
+    }
+    else if (layout == FLOAT_LAYOUT) {
+        for (size_t row: rows)
+            storage->floatData[row] = value.floatValue;
+    }
+    else {
+        string newBytes; ///Rebuilt byte buffer
+        size_t next = 0; ///Index of the next row to change
+
+        newBytes.reserve(storage->charBytes.size());
+        for (size_t i = 0; i < size(); i++) {
+            uint32_t start = newBytes.size(); ///New offset of the row
+            if (next < rows.size() && rows[next] == i) {
+                newBytes += value.charValue;
+                next++;
+            }
+            else
+                newBytes.append(storage->charBytes, storage->charOffsets[i], storage->charOffsets[i + 1] - storage->charOffsets[i]);
+            storage->charOffsets[i] = start;
+        }
+        storage->charOffsets[size()] = newBytes.size();
+        storage->charBytes.swap(newBytes);
+    }
+}
+/*!
+ * \brief Remove the last row of the column
+ *
+ * Used to take back a partially inserted row.
+ */
+void Column::popBack() {
+    own(0, 0);
+    if (layout == INT_LAYOUT)
+        storage->intData.pop_back();
+    else if (layout == FLOAT_LAYOUT)
+        storage->floatData.pop_back();
+    else {
+        storage->charOffsets.pop_back();
+        storage->charBytes.resize(storage->charOffsets.back());
+    }
+}
+/*!
+ * \brief Compaction method for the column
+ *
+ * This function will remove every row marked in the erased bitmap, moving
+ * the remaining rows down in a single pass.
+ *
+ * \param[in] vector<bool> erased
+ *            Bitmap holding true for each row to remove
+ */
+void Column::compact(const vector<bool> &erased) {
+    size_t kept = 0; ///Number of rows kept so far
+
+    own(IN_PLACE, 0);
+    if (layout == INT_LAYOUT) {
+        for (size_t i = 0; i < storage->intData.size(); i++)
+            if (!erased[i])
+                storage->intData[kept++] = storage->intData[i];
+        storage->intData.resize(kept);
+    }
+    else if (layout == FLOAT_LAYOUT) {
+        for (size_t i = 0; i < storage->floatData.size(); i++)
+            if (!erased[i])
+                storage->floatData[kept++] = storage->floatData[i];
+        storage->floatData.resize(kept);
+    }
+    else {
+        size_t rows = size(); ///Number of rows before compacting
+        size_t byteEnd = 0; ///End of the kept bytes
+        for (size_t i = 0; i < rows; i++) {
+            if (!erased[i]) {
+                uint32_t start = storage->charOffsets[i]; ///Start of the row bytes
+                uint32_t length = storage->charOffsets[i + 1] - start; ///Length of the row bytes
+                memmove(&storage->charBytes[0] + byteEnd, storage->charBytes.data() + start, length);
+                storage->charOffsets[kept++] = byteEnd;
+                byteEnd += length;
+            }
+        }
+        storage->charOffsets[kept] = byteEnd;
+        storage->charOffsets.resize(kept + 1);
+        storage->charBytes.resize(byteEnd);
+    }
+}
+/*!
+ * \brief Comparison method for the column
+ *
+ * This function will compare a row of the column to a parsed value using
+ * the native type of the column.
+ *
+ * \param[in] size_t row
+ *            Index of the row to compare
+ * \param[in] Value value
+ *            Value parsed for this column
+ * \return int less than, equal to, or greater than zero like strcmp
+ */
+int Column::compare(size_t row, const Value &value) const {
+    if (layout == INT_LAYOUT) {
+        int32_t data = getInt(row); ///Value stored at the row
+        if (value.integral)
+            return (data > value.intValue) - (data < value.intValue);
+        return (data > value.floatValue) - (data < value.floatValue);
+    }
+    else if (layout == FLOAT_LAYOUT)
+        return (getFloat(row) > value.floatValue) - (getFloat(row) < value.floatValue);
+    return getChars(row).compare(value.charValue);
+}
+/*!
+ * \brief Row equality between two columns
+ *
+ * This function will check if a row of this column holds the same value
+ * as a row of another column. Int and float columns are compared as
+ * numbers, other mixes are compared by their printed form.
+ *
+ * \param[in] size_t row
+ *            Index of the row in this column
+ * \param[in] Column other
+ *            Column to compare against
+ * \param[in] size_t otherRow
+ *            Index of the row in the other column
+ * \return boolean true if the values are equal
+ */
+bool Column::equalRows(size_t row, const Column &other, size_t otherRow) const {
+    if (layout == INT_LAYOUT && other.layout == INT_LAYOUT)
+        return getInt(row) == other.getInt(otherRow);
+    else if (layout == CHAR_LAYOUT && other.layout == CHAR_LAYOUT)
+        return getChars(row) == other.getChars(otherRow);
+    else if (layout != CHAR_LAYOUT && other.layout != CHAR_LAYOUT) {
+        double first = layout == INT_LAYOUT ? getInt(row) : getFloat(row);
+        double second = other.layout == INT_LAYOUT ? other.getInt(otherRow) : other.getFloat(otherRow);
+        return first == second;
+    }
+    return toString(row) == other.toString(otherRow);
+}
+/*!
+ * \brief Row order between two columns
+ *
+ * This function will order a row of this column against a row of another
+ * column. Numbers are compared as numbers and char values by their bytes,
+ * other mixes are compared by their printed form.
+ *
+ * \param[in] size_t row
+ *            Index of the row in this column
+ * \param[in] Column other
+ *            Column to compare against
+ * \param[in] size_t otherRow
+ *            Index of the row in the other column
+ * \return int negative, zero or positive as the row is below, equal to or above the other row
+ */
+int Column::compareRows(size_t row, const Column &other, size_t otherRow) const {
+    if (layout == INT_LAYOUT && other.layout == INT_LAYOUT)
+        return (getInt(row) > other.getInt(otherRow)) - (getInt(row) < other.getInt(otherRow));
+    else if (layout == CHAR_LAYOUT && other.layout == CHAR_LAYOUT)
+        return getChars(row).compare(other.getChars(otherRow));
+    else if (layout != CHAR_LAYOUT && other.layout != CHAR_LAYOUT) {
+        double first = layout == INT_LAYOUT ? getInt(row) : getFloat(row);
+        double second = other.layout == INT_LAYOUT ? other.getInt(otherRow) : other.getFloat(otherRow);
+        return (first > second) - (first < second);
+    }
+    return toString(row).compare(other.toString(otherRow));
+}
+/*!
+ * \brief Row encoder for the column
+ *
+ * This function will append the value of a row to a log record in its
+ * binary form. Int and float values are copied as they are and char values
+ * are written as a length followed by their bytes.
+ *
+ * \param[in] size_t row
+ *            Index of the row to encode
+ * \param[out] string record
+ *             String the encoded value is appended to
+ */
+void Column::encode(size_t row, string &record) const {
+    if (layout == INT_LAYOUT)
+        record.append(reinterpret_cast<const char *>(intValues() + row), sizeof(int32_t));
+    else if (layout == FLOAT_LAYOUT)
+        record.append(reinterpret_cast<const char *>(floatValues() + row), sizeof(double));
+    else {
+        experimental::string_view chars = getChars(row); ///Bytes of the row
+        uint32_t length = chars.size(); ///Length of the row bytes
+        record.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        record.append(chars.data(), chars.size());
+    }
+}
+/*!
+ * \brief Row decoder for the column
+ *
+ * This function will read a value written by encode and append it as a
+ * new row, moving the cursor past it.
+ *
+ * \param[in,out] const char *&cursor
+ *                Current read position in the record
+ * \param[in] const char *end
+ *            End of the record
+ * \return boolean true if a whole value was read
+ */
+bool Column::decode(const char *&cursor, const char *end) {
+    uint32_t length; ///Length of a char value
+
+    if (layout == INT_LAYOUT) {
+        int32_t data; ///Int read from the record
+        if ((size_t)(end - cursor) < sizeof(data))
+            return false;
+        memcpy(&data, cursor, sizeof(data));
+        cursor += sizeof(data);
+        own(1, 0);
+        storage->intData.push_back(data);
+    }
+    else if (layout == FLOAT_LAYOUT) {
+        double data; ///Float read from the record
+        if ((size_t)(end - cursor) < sizeof(data))
+            return false;
+        memcpy(&data, cursor, sizeof(data));
+        cursor += sizeof(data);
+        own(1, 0);
+        storage->floatData.push_back(data);
+    }
+    else {
+        if ((size_t)(end - cursor) < sizeof(length))
+            return false;
+        memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if ((size_t)(end - cursor) < length)
+            return false;
+        own(1, length);
+        storage->charBytes.append(cursor, length);
+        storage->charOffsets.push_back(storage->charBytes.size());
+        cursor += length;
+    }
+    return true;
+}
+/*!
+ * \brief Mapping method for the column
+ *
+ * This function will point the column at its segment in a mapped table
+ * file instead of copying the rows. Nothing is read until rows are used.
+ *
+ * \param[in] shared_ptr<MappedFile> file
+ *            Mapped table file holding the segment
+ * \param[in] const char *segment
+ *            Start of the column segment in the mapping
+ * \param[in] size_t rows
+ *            Number of rows in the segment
+ */
+void Column::map(shared_ptr<MappedFile> file, const char *segment, size_t rows) {
+    storage.reset();
+    mapping = file;
+    mappedSegment = segment;
+    mappedBytes = segment + (rows + 1) * sizeof(uint32_t);
+    mappedRows = rows;
+}
+/*!
+ * \brief Materialize method for the column
+ *
+ * This function will copy a mapped column into owned storage so that it
+ * can be changed. Columns that are not mapped are left alone.
+ *
+ */
+void Column::materialize() {
+    if (!mapping)
+        return;
+    shared_ptr<Storage> owned = make_shared<Storage>(); ///Storage the rows are copied to
+
+    if (layout == INT_LAYOUT)
+        owned->intData.assign(intValues(), intValues() + mappedRows);
+    else if (layout == FLOAT_LAYOUT)
+        owned->floatData.assign(floatValues(), floatValues() + mappedRows);
+    else {
+        owned->charOffsets.assign(charOffsetValues(), charOffsetValues() + mappedRows + 1);
+        owned->charBytes.assign(charByteValues(), owned->charOffsets.back());
+    }
+    storage = owned;
+    mapping.reset();
+    mappedSegment = nullptr;
+    mappedBytes = nullptr;
+    mappedRows = 0;
+}
+/*!
+ * \brief Snapshot method for the column
+ *
+ * This function will give a read only copy of the column holding the rows
+ * it has now. The copy points at the same mapping or storage, which it
+ * keeps alive, and rows appended to the column later are not part of it.
+ *
+ * \return Column reading the rows held when it was taken
+ */
+Column Column::snapshot() const {
+    Column view(*this); ///Copy reading the rows held now
+
+    if (!mapping) {
+        view.mappedRows = size();
+        view.mappedSegment = layout == INT_LAYOUT ? reinterpret_cast<const char *>(storage->intData.data())
+            : layout == FLOAT_LAYOUT ? reinterpret_cast<const char *>(storage->floatData.data())
+            : reinterpret_cast<const char *>(storage->charOffsets.data());
+        view.mappedBytes = storage->charBytes.data();
+        view.mapping = storage;
+        view.storage.reset();
+    }
+    return view;
+}
+/*!
+ * \brief Ownership method for the column
+ *
+ * This function will make the storage of the column safe to change before
+ * a change. Storage held by no snapshot is changed as it is. Storage
+ * shared with a snapshot takes appended rows in place while they fit its
+ * capacity, since they lie past the rows of every snapshot, and is copied
+ * with room to grow before anything else.
+ *
+ * \param[in] size_t rows
+ *            Number of rows about to be appended, IN_PLACE for a change to the rows held
+ * \param[in] size_t bytes
+ *            Number of char bytes about to be appended
+ */
+void Column::own(size_t rows, size_t bytes) {
+    materialize();
+    if (storage.use_count() == 1) {
+        /** Order the change after the reads of the last snapshot released **/
+        atomic_thread_fence(memory_order_acquire);
+        return;
+    }
+    const Storage &shared = *storage; ///Storage read by a snapshot
+    size_t count = size(); ///Number of rows held
+    size_t growth = 2; ///Capacity of the copy as a multiple of the rows held
+    if (rows != IN_PLACE) {
+        if (layout == INT_LAYOUT && count + rows <= shared.intData.capacity())
+            return;
+        if (layout == FLOAT_LAYOUT && count + rows <= shared.floatData.capacity())
+            return;
+        if (layout == CHAR_LAYOUT && count + 1 + rows <= shared.charOffsets.capacity()
+            && shared.charBytes.size() + bytes <= shared.charBytes.capacity())
+            return;
+    }
+    else {
+        rows = bytes = 0;
+        growth = 1;
+    }
+
+    /** Copy the rows, with room to grow for an append **/
+    shared_ptr<Storage> copy = make_shared<Storage>(); ///Storage owned by the column alone
+    copy->intData.reserve(max(growth * shared.intData.size(), shared.intData.size() + rows));
+    copy->intData = shared.intData;
+    copy->floatData.reserve(max(growth * shared.floatData.size(), shared.floatData.size() + rows));
+    copy->floatData = shared.floatData;
+    copy->charOffsets.reserve(max(growth * shared.charOffsets.size(), shared.charOffsets.size() + rows));
+    copy->charOffsets = shared.charOffsets;
+    copy->charBytes.reserve(max(growth * shared.charBytes.size(), shared.charBytes.size() + bytes));
+    copy->charBytes = shared.charBytes;
+    storage = copy;
+}
+/*!
+ * \brief Segment length of the column
+ *
+ * \return size_t number of bytes the column takes in a table file
+ */
+size_t Column::segmentLength() const {
+    if (layout == INT_LAYOUT)
+        return size() * sizeof(int32_t);
+    else if (layout == FLOAT_LAYOUT)
+        return size() * sizeof(double);
+    return (size() + 1) * sizeof(uint32_t) + charOffsetValues()[size()];
+}
+/*!
+ * \brief Segment length of a stored column
+ *
+ * This function will give the length of a column segment as found in a
+ * table file, reading the end offset of a char segment when needed.
+ *
+ * \param[in] Layout layout
+ *            Storage layout of the column
+ * \param[in] const char *segment
+ *            Start of the column segment
+ * \param[in] size_t rows
+ *            Number of rows in the segment
+ * \return size_t number of bytes of the segment
+ */
+size_t Column::segmentLength(Layout layout, const char *segment, size_t rows) {
+    if (layout == INT_LAYOUT)
+        return rows * sizeof(int32_t);
+    else if (layout == FLOAT_LAYOUT)
+        return rows * sizeof(double);
+    return (rows + 1) * sizeof(uint32_t) + reinterpret_cast<const uint32_t *>(segment)[rows];
+}
+/*!
+ * \brief Segment writer for the column
+ *
+ * This function will write the column in its table file form. The typed
+ * arrays are written as they are held in memory.
+ *
+ * \param[out] ostream out
+ *             Stream of the table file being written
+ */
+void Column::writeSegment(ostream &out) const {
+    if (layout == INT_LAYOUT)
+        out.write(reinterpret_cast<const char *>(intValues()), size() * sizeof(int32_t));
+    else if (layout == FLOAT_LAYOUT)
+        out.write(reinterpret_cast<const char *>(floatValues()), size() * sizeof(double));
+    else {
+        out.write(reinterpret_cast<const char *>(charOffsetValues()), (size() + 1) * sizeof(uint32_t));
+        out.write(charByteValues(), charOffsetValues()[size()]);
+    }
+}
+/*!
+ * \brief Printable form of a row
+ *
+ * \param[in] size_t row
+ *            Index of the row to print
+ * \return string holding the value as shown to the user
+ */
+string Column::toString(size_t row) const {
+    if (layout == INT_LAYOUT)
+        return to_string(getInt(row));
+    else if (layout == FLOAT_LAYOUT)
+        return formatFloat(getFloat(row));
+    return getChars(row).to_string();
+}
+/*!
+ * \brief Literal form of a row
+ *
+ * This function gives the value as it would be typed in a statement,
+ * putting quotes back around char values.
+ *
+ * \param[in] size_t row
+ *            Index of the row
+ * \return string holding the literal form of the value
+ */
+string Column::toLiteral(size_t row) const {
+    if (layout == CHAR_LAYOUT)
+        return "'" + toString(row) + "'";
+    return toString(row);
+}
+/*!
+ * \brief Printable view of a row
+ *
+ * This function will give the printed form of a row without allocating.
+ * Char values are viewed in place and numbers are formatted into the given
+ * buffer, which must hold at least 32 bytes.
+ *
+ * \param[in] size_t row
+ *            Index of the row to print
+ * \param[out] char *buffer
+ *             Buffer receiving a formatted number
+ * \return string_view of the printed value
+ */
+experimental::string_view Column::format(size_t row, char *buffer) const {
+    if (layout == INT_LAYOUT)
+        return experimental::string_view(buffer, snprintf(buffer, 32, "%d", getInt(row)));
+    else if (layout == FLOAT_LAYOUT)
+        return experimental::string_view(buffer, formatFloat(getFloat(row), buffer));
+    return getChars(row);
+}
+/*!
+ * \brief Float formatter
+ *
+ * This function will print a float with the fewest digits that still read
+ * back as the same value, so 19.99 prints as typed instead of 19.990000.
+ *
+ * \param[in] double value
+ *            Value to print
+ * \return string holding the printed value
+ */
+string Column::formatFloat(double value) {
+    char buffer[32]; ///Buffer holding the printed number
+
+    return string(buffer, formatFloat(value, buffer));
+}
+/*!
+ * \brief Float formatter into a buffer
+ *
+ * \param[in] double value
+ *            Value to print
+ * \param[out] char *buffer
+ *             Buffer of at least 32 bytes receiving the printed number
+ * \return size_t number of characters printed
+ */
+size_t Column::formatFloat(double value, char *buffer) {
+    int length = snprintf(buffer, 32, "%.15g", value); ///Number of characters printed
+
+    if (strtod(buffer, nullptr) != value)
+        length = snprintf(buffer, 32, "%.17g", value);
+    return length;
+}
@@ -0,0 +1,223 @@
+/*!
+ * \file CsvLoader.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the CsvLoader class. The text of a data
+ * file is cut into chunks of whole lines that are parsed in parallel, each
+ * into its own set of columns.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "../include/CsvLoader.h"
+
+///std name space for general use
+using namespace std;
+
+///Definition of the chunk size for use outside the class
+const size_t CsvLoader::CHUNK_BYTES;
+
+/*!
+ * \brief Constructor of the CsvLoader class
+ *
+ * \param[in] vector<Column> newSchema
+ *            Columns of the table being loaded, which must outlive the loader
+ * \param[in] char newDelimiter
+ *            Character separating the fields
+ */
+CsvLoader::CsvLoader(const vector<Column> &newSchema, char newDelimiter) : schema(newSchema) {
+	delimiter = newDelimiter;
+	failedLine = 0;
+	failedColumn = -1;
+}
+/*!
+ * \brief Deconstructor of the CsvLoader class
+ *
+ * This function will deconstruct the CsvLoader class. This currently has
+ * no effect on the class.
+ *
+ */
+CsvLoader::~CsvLoader() {
+
+}
+/*!
+ * \brief Parse the text of a data file
+ *
+ * This function will cut the text into one chunk per core at line ends,
+ * leaving small files in a single chunk, and parse the chunks on their own
+ * threads. If a row is invalid the first one is described in failedLine,
+ * failedColumn and failedField.
+ *
+ * \param[in] const char *data
+ *            Start of the text
+ * \param[in] size_t size
+ *            Number of bytes in the text
+ * \return boolean true if every row was valid
+ */
+bool CsvLoader::parse(const char *data, size_t size) {
+	size_t chunkNum = max(1u, thread::hardware_concurrency()); ///Number of chunks to parse
+	vector<thread> workers; ///Threads parsing every chunk but the first
+	const char *begin = data; ///Start of the next chunk
+
+	/** Cut the text at the first line end after each even share **/
+	chunkNum = min(chunkNum, size / CHUNK_BYTES + 1);
+	chunks.clear();
+	chunks.resize(chunkNum);
+	for (size_t i = 0; i < chunkNum; i++) {
+		const char *end = data + size; ///End of the chunk
+		if (i + 1 < chunkNum && data + size * (i + 1) / chunkNum > begin) {
+			const char *target = data + size * (i + 1) / chunkNum; ///Even share of the text
+			const char *lineEnd = static_cast<const char *>(memchr(target, '\n', data + size - target));
+			if (lineEnd != nullptr)
+				end = lineEnd + 1;
+		}
+		if (end < begin)
+			end = begin;
+		chunks[i].begin = begin;
+		chunks[i].end = end;
+		for (const Column &schemaColumn: schema)
+			chunks[i].columns.push_back(Column(schemaColumn.colName, schemaColumn.colType, schemaColumn.colSize));
+		begin = end;
+	}
+
+	/** Parse the chunks in parallel **/
+	for (size_t i = 1; i < chunkNum; i++)
+		workers.push_back(thread(&CsvLoader::parseChunk, this, ref(chunks[i])));
+	parseChunk(chunks[0]);
+	for (thread &worker: workers)
+		worker.join();
+
+	/** Report the first invalid row by its line in the whole text **/
+	failedLine = 0;
+	for (const Chunk &chunk: chunks) {
+		failedLine += chunk.lines;
+		if (chunk.failed) {
+			failedColumn = chunk.failedColumn;
+			failedField = chunk.failedField;
+			return false;
+		}
+	}
+	return true;
+}
+/*!
+ * \brief Parse the lines of a chunk
+ *
+ * This function will read each line of the chunk as a row, splitting it at
+ * the delimiter and appending each field to its column. Blank lines are
+ * skipped. Parsing stops at the first invalid row.
+ *
+ * \param[in,out] Chunk chunk
+ *                Chunk to parse
+ */
+void CsvLoader::parseChunk(Chunk &chunk) const {
+	const char *cursor = chunk.begin; ///Start of the current line
+	string quoted; ///Unescaped text of a quoted field
+
+	while (cursor < chunk.end) {
+		const char *lineEnd = static_cast<const char *>(memchr(cursor, '\n', chunk.end - cursor)); ///End of the line
+		if (lineEnd == nullptr)
+			lineEnd = chunk.end;
+		const char *stop = lineEnd; ///End of the fields of the line
+		if (stop > cursor && stop[-1] == '\r')
+			stop--;
+		chunk.lines++;
+		if (stop == cursor) {
+			cursor = lineEnd + 1;
+			continue;
+		}
+
+		/** Split the line into fields **/
+		const char *field = cursor; ///Start of the current field
+		size_t col = 0; ///Column of the current field
+		while (true) {
+			const char *value = field; ///Start of the value of the field
+			size_t length; ///Length of the value of the field
+			const char *next; ///End of the field
+			if (field < stop && *field == '"') {
+				/** Unescape a quoted field **/
+				bool closed = false; ///Bool if the closing quote was found
+				quoted.clear();
+				next = field + 1;
+				while (next < stop) {
+					if (*next != '"')
+						quoted += *next++;
+					else if (next + 1 < stop && next[1] == '"') {
+						quoted += '"';
+						next += 2;
+					}
+					else {
+						closed = true;
+						next++;
+						break;
+					}
+				}
+				if (!closed || (next < stop && *next != delimiter)) {
+					chunk.failed = true;
+					chunk.failedColumn = col < schema.size() ? (int)col : -1;
+					chunk.failedField.assign(field, stop - field);
+					return;
+				}
+				value = quoted.data();
+				length = quoted.size();
+			}
+			else {
+				next = static_cast<const char *>(memchr(field, delimiter, stop - field));
+				if (next == nullptr)
+					next = stop;
+				length = next - field;
+			}
+			if (col >= schema.size()) {
+				chunk.failed = true;
+				return;
+			}
+			if (!chunk.columns[col].appendField(value, length)) {
+				chunk.failed = true;
+				chunk.failedColumn = col;
+				chunk.failedField.assign(value, length);
+				return;
+			}
+			col++;
+			if (next >= stop)
+				break;
+			field = next + 1;
+		}
+		if (col != schema.size()) {
+			chunk.failed = true;
+			return;
+		}
+		cursor = lineEnd + 1;
+	}
+}
+/*!
+ * \brief Append the parsed rows to the columns of a table
+ *
+ * \param[in,out] vector<Column> columns
+ *                Columns of the table, shaped like the schema
+ */
+void CsvLoader::appendTo(vector<Column> &columns) const {
+	for (const Chunk &chunk: chunks) {
+		for (size_t i = 0; i < columns.size(); i++)
+			columns[i].appendColumn(chunk.columns[i]);
+	}
+}
+/*!
+ * \brief Number of parsed rows
+ *
+ * \return size_t rows parsed over every chunk
+ */
+size_t CsvLoader::rowCount() const {
+	size_t rows = 0; ///Rows counted so far
+
+	for (const Chunk &chunk: chunks) {
+		if (!chunk.columns.empty())
+			rows += chunk.columns[0].size();
+	}
+	return rows;
+}
@@ -8,8 +8,8 @@
  *
  * This file controls all operations at a Database level. This includes the
  * capabilities to edit tables and their contents as well as perform joins.
- * The control function in this program is the dataBaseParser that handles
- * all commands not handled in the main parser. These include actions that
+ * The control function in this program is execute, which runs the parsed
+ * statements not handled in the main parser. These include actions that
  * are table manipulations, making it easier to control the structure of the
  * table list due to less calls to class elements.
  *
@@ -20,7 +20,15 @@
 #include <vector>
 
 #include "../include/Database.h"
+#include "../include/Join.h"
+#include "../include/Output.h"
+#include "../include/Predicate.h"
+#include "../include/ResultSink.h"
+#include "../include/RowCursor.h"
+#include "../include/Sorter.h"
 #include "../include/Table.h"
+#include "../include/Transaction.h"
+#include "../include/WriteAheadLog.h"
 
 /// std name space for general use
 using namespace std;
@@ -29,21 +37,185 @@ using namespace std;
 /// Not using whole name space as it is not needed
 namespace fs = std::experimental::filesystem;
 
+/*!
+ * \brief List the conditions joined by AND
+ *
+ * \param[in] Expression *expression
+ *            Expression to split, null for none
+ * \param[out] vector<const Expression *> found
+ *             Conditions every matching row passes, appended in order
+ */
+static void splitConditions(const Expression *expression, vector<const Expression *> &found) {
+	if (expression == nullptr)
+		return;
+	if (expression->kind == Expression::AND) {
+		splitConditions(expression->left.get(), found);
+		splitConditions(expression->right.get(), found);
+	}
+	else
+		found.push_back(expression);
+}
+/*!
+ * \brief Describe a step of a join and the steps below it
+ *
+ * The step is listed above the joined rows it reads, the step before it or
+ * the table the join starts from, followed by its own table.
+ *
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] vector<shared_ptr<Table>> handles
+ *            Handle of each table in FROM order
+ * \param[in] vector<Join::Step> steps
+ *            Table the join starts from and the step of each other table
+ * \param[in] size_t k
+ *            Position of the step in join order
+ * \param[in] size_t depth
+ *            Depth of the step in the plan
+ * \param[in,out] vector<pair<size_t, string>> lines
+ *                Depth and text of each line of the plan
+ */
+static void describeJoin(const SelectStatement &statement, const vector<shared_ptr<Table>> &handles,
+	const vector<Join::Step> &steps, size_t k, size_t depth, vector<pair<size_t, string>> &lines) {
+	static const char *TYPES[] = {"INNER ", "INNER ", "LEFT OUTER ", "RIGHT OUTER ", "FULL OUTER "}; ///Way each join type is written
+	const Join::Step &step = steps[k]; /// Step described
+	auto nameOf = [&](size_t slot) {
+		return statement.tables[slot].alias.empty() ? handles[slot]->tableName : statement.tables[slot].alias;
+	};
+
+	/** The join and how it reads each side **/
+	string join = string(step.type == TableRef::CROSS_JOIN && step.predicate.empty() ? "CROSS " : TYPES[step.type])
+		+ Join::methodName(step.method); /// Line joining the table
+	if (step.method != Join::NESTED_LOOP) {
+		join += " ON " + nameOf(step.keySlot) + "." + step.left.column->colName + " = " + nameOf(step.slot) + "."
+			+ step.right.column->colName;
+		if (!step.predicate.single())
+			join += " AND FILTER";
+	}
+	lines.emplace_back(depth, join);
+	bool leftBuilds = step.left.rows < step.right.rows; /// Bool if the hash table is built on the joined rows
+	for (size_t side = 0; side < 2; side++) {
+		const Join::Input &input = side == 0 ? step.left : step.right; /// Side read
+		size_t slot = side == 0 ? steps[0].slot : step.slot; /// Slot of the table read
+		if (side == 0 && k > 1) {
+			describeJoin(statement, handles, steps, k - 1, depth + 1, lines);
+			continue;
+		}
+		string read = "SCAN " + handles[slot]->tableName; /// Line reading the table
+		if (step.method == Join::HASH_JOIN)
+			read += (side == 0) == leftBuilds ? " TO BUILD HASH TABLE" : " TO PROBE";
+		else if (step.method == Join::MERGE_JOIN && input.order == Join::SORTED)
+			read += " IN ROW ORDER";
+		else if (step.method == Join::MERGE_JOIN && input.order == Join::INDEXED)
+			read += " USING INDEX " + input.index->indexName;
+		else if (step.method == Join::MERGE_JOIN)
+			read = "SORT " + handles[slot]->tableName + " BY " + input.column->colName;
+		lines.emplace_back(depth + 1, read);
+	}
+}
+/*!
+ * \brief Open the sink a result is written to
+ *
+ * A result without a file is printed. Otherwise the file is opened and a
+ * sink writing its format is returned, or an error is printed if it could
+ * not be opened.
+ *
+ * \param[in] FileOptions file
+ *            File the result is written to, no path to print it
+ * \param[out] ofstream outFile
+ *             Stream opened on the file
+ * \return unique_ptr<ResultSink> sink for the result, empty if the file could not be opened
+ */
+static unique_ptr<ResultSink> openSink(const FileOptions &file, ofstream &outFile) {
+	if (file.path.empty())
+		return unique_ptr<ResultSink>(new TextSink(Output::stream()));
+	outFile.open(file.path, ios::binary | ios::trunc);
+	if (!outFile) {
+		Output::stream() << "!Failed to export to "
+			 << file.path
+			 << " because it could not be opened." << endl;
+		return nullptr;
+	}
+	if (file.binary)
+		return unique_ptr<ResultSink>(new BinarySink(outFile));
+	return unique_ptr<ResultSink>(new CsvSink(outFile, file.delimiter));
+}
+/*!
+ * \brief Report a result written to a file
+ *
+ * \param[in] ResultSink sink
+ *            Sink the result was written to
+ * \param[in] FileOptions file
+ *            File the result was written to, no path if it was printed
+ * \param[in,out] ofstream outFile
+ *                Stream opened on the file
+ */
+static void closeSink(const ResultSink &sink, const FileOptions &file, ofstream &outFile) {
+	if (file.path.empty())
+		return;
+	outFile.close();
+	if (!outFile)
+		Output::stream() << "!Failed to export to "
+			 << file.path
+			 << " because it could not be written." << endl;
+	else if (sink.rowNum == 1)
+		Output::stream() << "1 record exported." << endl;
+	else
+		Output::stream() << sink.rowNum << " records exported." << endl;
+}
+
 /*!
  * \brief Constructor of the Database class
  *
  * This function will construct the Database class by reading its
  * corresponding directory if it exists. If not it will create the default
  * empty class. Each database contains its name and a list of Tables within
- * the directory
+ * the directory. Tables still stored in the older .txt format are converted
+ * to binary table files as they are found, and temporary files left by a
+ * table write that was cut short are removed. Only the schema of each table is
+ * read here, the rows are loaded when a statement first uses the table.
+ *
+ * The write-ahead log of the database is read back here, and each table is
+ * handed the records made after its file was written to apply on load.
  *
  * \param[in] string path
  *            String corresponding to the path that the tables file will be at
  */
 Database::Database(string path) {
+	vector<fs::path> tablePaths; ///Paths of the table files in the directory
+
 	/** File Reader **/
-	for(auto&p: fs::directory_iterator(path)) {
-		tables.push_back(Table(p.path()));
+	for(auto&p: fs::directory_iterator(path))
+		tablePaths.push_back(p.path());
+
+	/** Convert text tables and map binary tables **/
+	for (auto &tablePath: tablePaths) {
+		shared_ptr<Table> newTable; ///Table read from the path
+		if (tablePath.extension() == ".txt")
+			newTable = make_shared<Table>(Table::convertText(tablePath));
+		else if (tablePath.extension() == ".tbl")
+			newTable = make_shared<Table>(tablePath);
+		else {
+			/** A file left by a write that never finished replaced nothing **/
+			if (tablePath.extension() == ".tmp")
+				fs::remove(tablePath);
+			continue;
+		}
+		tables[newTable->lowerName] = newTable;
+	}
+
+	/** Read back the log, numbering new records past every table file **/
+	uint64_t after = 0; ///Highest sequence number held by a table file
+	vector<WriteAheadLog::Record> records; ///Records read back from the log
+	for (auto &tableEntry: tables)
+		after = max(after, tableEntry.second->fileLsn);
+	wal = make_shared<WriteAheadLog>((fs::path(path) / "database.wal").string());
+	wal->open(after, records);
+	for (auto &tableEntry: tables)
+		tableEntry.second->wal = wal;
+	for (WriteAheadLog::Record &record: records) {
+		auto found = tables.find(record.table); ///Table changed by the record
+		if (found != tables.end() && record.lsn > found->second->fileLsn)
+			found->second->pending.push_back(move(record));
 	}
 }
 /*!
@@ -55,692 +227,656 @@ Database::Database(string path) {
  */
 Database::~Database() {
 
+}
+/*!
+ * \brief Table lookup for the Database class
+ *
+ * This function will find a table by name through the table map. Table
+ * names are matched regardless of case unless asked otherwise.
+ *
+ * \param[in] string name
+ *            String corresponding to the name of the table
+ * \param[in] bool matchCase
+ *            True if the name must match the case of the table name
+ * \return shared_ptr<Table> handle of the table, or empty if it does not exist
+ */
+shared_ptr<Table> Database::findTable(string name, bool matchCase) {
+	lock_guard<mutex> guard(tablesLatch); /// Latch held while the map is read
+	string lowerName = name; /// String holding the lowercase name
+
+	transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+	auto found = tables.find(lowerName);
+	if (found == tables.end() || (matchCase && found->second->tableName != name))
+		return shared_ptr<Table>();
+	return found->second;
+}
+/*!
+ * \brief Table reader for the Database class
+ *
+ * This function will find the rows a query reads. A table locked by the
+ * transaction of the session is read as it is, so the session sees its own
+ * changes. Any other table is read through its last published snapshot,
+ * which no change made while the query runs can alter. A table not used
+ * yet is loaded first under its own latch, so a query never waits on the
+ * latch of the database.
+ *
+ * \param[in] shared_ptr<Table> inputTable
+ *            Handle of the table, empty if it does not exist
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \return shared_ptr<Table> rows of the table, or empty if it does not exist
+ */
+shared_ptr<Table> Database::readTable(const shared_ptr<Table> &inputTable, Transaction *transaction) {
+	if (!inputTable)
+		return inputTable;
+	if (transaction != nullptr && inputTable->transaction == transaction)
+		return inputTable;
+	inputTable->load();
+	return inputTable->snapshot();
 }
 /*!
  * \brief Function for the create table function
  *
  * This function will create a table in the internal table list and then
- * replicate this creation on a file level. When the main parser detects the
- * CREATE command and a database has been used it will direct to this
- * function. The function will then create a file based on the name and
- * create or deny it from the list if the file does or does not
- * exist. t will then output the appropriate error messages.The function
- * will then populate the internal and external table  if the provided
- * construction information for individual columns.
+ * replicate this creation on a file level. The function will create a file
+ * based on the name and create or deny it from the list if the file does
+ * or does not exist. It will then output the appropriate error messages.
+ * The function will then populate the internal and external table with the
+ * column definitions of the statement.
  *
+ * \param[in] CreateTableStatement statement
+ *            Syntax tree of the statement
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::createTable() {
-	string input; /// String holding user input
-	string tableName; /// String containing the table name
-	string colNameNoSpace; /// String to hold column name if no space between table name
-
-	bool endInput = false; /// Boolean to determine if column input is done
-	bool firstInput = true; /// Boolean to adjust parser based on first input
-	bool noSpace = false; /// Boolean if no space between table and column name
-
-	string newColName; /// String containing a new columns name
-	string newColType; /// String containing a new columns type
-	int newColSize; /// Int containing a new columns size
-
+bool Database::createTable(const CreateTableStatement &statement) {
 	fs::path dataPath = "Databases/"; ///Path for the table file
 
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "TABLE" && input != "table") /// Unknown command if TABLE not specified
-		return false;
-	cin >> input;
-	if (input.find('(') != string::npos) {
-		noSpace = true;
-		colNameNoSpace = input.substr(input.find('('));
-		input = input.substr(0, input.find('('));
-	}
-
 	/** Process path for detecting directory **/
-	dataPath += dataBaseName + '/' + input + ".txt";
+	dataPath += dataBaseName + '/' + statement.table + ".tbl";
 
 	/** Attempt to detect directory at path **/
-	if (fs::exists(dataPath)) /// Detect and output error if found
+	if (fs::exists(dataPath) || findTable(statement.table)) /// Detect and output error if found
 	{
-		cout << "!Failed to create table "
-		     << input
+		Output::stream() << "!Failed to create table "
+		     << statement.table
 		     << " because it already exists." << endl;
-		cin.ignore();
-		getline (cin, input);
-	}
-	else /// Create message if success and add database to internal list
-	{
-		/** Set Table Name for Later Use **/
-		tableName = input;
-
-		/** Push new Table onto List **/
-		tables.push_back(Table(dataPath));
-
-		/** Main Table Creator **/
-		while (!endInput) /// Run until input ends / ";" found
-		{
-			/** Get Input **/
-			if (!noSpace)
-				cin >> newColName;
-			else
-			{
-				noSpace = false;
-				newColName = colNameNoSpace;
-			}
-			if (firstInput) /// Check for particular first input problems
-			{
-				/** Check for Empty Token **/
-				if (newColName == "();") /// Handle an Empty Table
-				{
-					tables.back().writeTable(dataPath);
-					cout << "Table "
-						 << tableName
-						 << " created." << endl;
-					return true;
-				}
-				/** Remove the starting "(" **/
-				newColName.erase(0,1);
-				firstInput = false;
-			}
-			/** Get Column Type **/
-			cin >> newColType;
-			if (newColType.back() != ',' && newColType.back() != ';') /// Check for valid token ending "," or ";"
-			{
-				tables.pop_back();
-				return false;
-			}
-			else /// Valid type token
-			{
-				/** Process Type Token **/
-				if (newColType.back() == ';') /// If token ends with ";" it is last token
-				{
-					newColType.pop_back();
-					endInput = true;
-				}
-				newColType.pop_back();
-
-				/** Check if token is of type char or varchar **/
-				if (newColType.substr(0, newColType.find('(')) == "char" ||
-					newColType.substr(0, newColType.find('(')) == "varchar") {
-						/** Process the token to get column type **/
-						input = newColType;
-						newColType = input.substr(0, input.find('('));
-						/** Process token to get the column size **/
-						input = input.substr(input.find('(') + 1);
-						input = input.substr(0, input.find(')'));
-						newColSize = stoi(input);
-				}
-				else if (newColType == "int" || newColType == "float") /// Check for other types
-					newColSize = 0;
-				else /// If not valid remove table
-				{
-					tables.pop_back();
-					return false;
-				}
-				/** Add Column onto Table **/
-				tables.back().columns.push_back(Column(newColName, newColType, newColSize));
-			}
-		}
-		/** Add Valid Path to Table **/
-		tables.back().writeTable(dataPath);
-		cout << "Table "
-			 << tableName
-			 << " created." << endl;
+		return true;
 	}
+
+	/** Construct new Table with its columns and add it to the map **/
+	shared_ptr<Table> newTable = make_shared<Table>(dataPath); /// Table being created
+	newTable->wal = wal;
+	for (const ColumnDef &column: statement.columns)
+		newTable->columns.push_back(Column(column.name, column.type, column.size));
+	newTable->writeTable(dataPath);
+	newTable->publish();
+	lock_guard<mutex> guard(tablesLatch); /// Latch held while the map is changed
+	tables[newTable->lowerName] = newTable;
+	Output::stream() << "Table "
+		 << statement.table
+		 << " created." << endl;
 	return true; /// Return true for end of processing
 }
 /*!
  * \brief Function for the drop table function
  *
  * This function will drop a table from the internal Table list and then
- * replicate this deletion on a file level. When the main parser detects the
- * DROP command and a database has been used it will direct to this
- * function. The function will then drop a table based on the name and
- * drop or deny it from the table list if the file does or does not
- * exist. It will then output the appropriate error messages.
+ * replicate this deletion on a file level. The function will then drop a
+ * table based on the name and drop or deny it from the table list if the
+ * file does or does not exist. It will then output the appropriate error
+ * messages.
  *
+ * \param[in] NameStatement statement
+ *            Syntax tree of the statement
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::dropTable() {
-	string input; /// String holding user input
+bool Database::dropTable(const NameStatement &statement) {
 	fs::path dataPath = "Databases/"; /// Directory path for deleted database
 
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "TABLE") /// Unknown command if TABLE not specified
-		return false;
-	cin >> input;
-	if (input.back() != ';') /// Unknown command if no ";" at end of function
-		return false;
-
 	/** Process path for deleting file **/
-	input.pop_back();
-	dataPath += dataBaseName + '/' + input + ".txt";
+	dataPath += dataBaseName + '/' + statement.name + ".tbl";
 
 	/** Attempt to delete directory at path **/
+	fs::remove(fs::path(dataPath).replace_extension(".idx"));
 	if(!fs::remove_all(dataPath)) /// Delete and output error if fails
 	{
-		cout << "!Failed to delete "
-			 << input
+		Output::stream() << "!Failed to delete "
+			 << statement.name
 		     << " because it does not exist." << endl;
 	}
 	else /// Output message if success and delete table from internal list
 	{
-		/** Locate internal database to also remove **/
-		for (size_t i = 0; i < tables.size(); i++) {
-			if (tables[i].tableName == input)
-				tables.erase(tables.begin() + i);
+		/** Locate internal table to also remove **/
+		if (shared_ptr<Table> inputTable = findTable(statement.name, true)) {
+			lock_guard<mutex> guard(tablesLatch); /// Latch held while the map is changed
+			tables.erase(inputTable->lowerName);
 		}
-		cout << "Table "
-		     << input
+		Output::stream() << "Table "
+		     << statement.name
 		     << " deleted." << endl;
 	}
 
 	return true; /// Return true for end of processing
 }
 /*!
- * \brief Function for the select table function
+ * \brief Function for the create index function
  *
- * This function will select a table from the internal Table list.
- * When the main parser detects the SELECT command and a database
- * has been used it will direct to this function. The function will
- * then list all the column information or output the appropriate
- * error messages. This function also leads to the joining functions.
+ * This function will create an index on a column of a table. The statement
+ * has the form name ON table(column), optionally followed by USING HASH
+ * for a hash index or USING BTREE for the default tree index. A hash index
+ * only serves equality, a tree index serves equality and ranges.
  *
+ * \param[in] CreateIndexStatement statement
+ *            Syntax tree of the statement
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not. This function
- *         will additionally detect if the user is selecting all or selecting a
- *         particular column and direct to the correct function.
+ *         of a processed create command if it is created or not.
  */
-bool Database::selectTable() {
-	string input; /// String holding user input
-	vector <string> types; /// Boolean selected types if not all are selected
-	bool typeBased = false; /// Boolean if all types are selected or not
-	string tempTableName; /// String holds a temp name for joining
-
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "*") /// Switch if not all types selected
-	{
-		typeBased = true; /// Change type of function to use
-		/** Receive input types **/
-		if (input.back() == ',') /// Process first input to see if anymore
-		{
-			input.pop_back();
-			types.push_back(input);
-			/** Loop if more than one input checking for ',' **/
-			while (true) {
-				cin >> input;
-				if (input.back() == ',')  /// Check if more inputs and process
-				{
-					input.pop_back();
-					types.push_back(input);
-				}
-				else /// Get final input and leave loop
-				{
-					types.push_back(input);
-					break;
-				}
-			}
+bool Database::createIndex(const CreateIndexStatement &statement) {
+	Index::Kind kind = statement.hash ? Index::HASH_INDEX : Index::TREE_INDEX; /// Structure of the new index
+
+	/** Index names are shared by every table of the database **/
+	for (auto &entry: tables) {
+		if (entry.second->holdsIndex(statement.index)) {
+			Output::stream() << "!Failed to create index "
+				 << statement.index
+				 << " because it already exists." << endl;
+			return true;
 		}
-		else /// No more inputs after the first input
-			types.push_back(input);
 	}
 
-	/** Process following input **/
-	cin >> input;
-	if (input != "FROM" && input != "from") /// Unknown command if TABLE not specified
-		return false;
-	cin >> input;
-	/** Switch input based on function used **/
-	if (!typeBased) {
-		if (input.back() != ';') /// Switch if a join command instead of select all
-		{
-			tempTableName = input; /// Temporary storage for table one name
-			/** Continue input if not a standard selection **/
-			cin >> input;
-			/** Switch to a regular join **/
-			if (input.back() == ',')
-				return innerJoin(tempTableName);
-			else /// Check if a inner or outer join
-			{
-				/** Get input and check for an inner join **/
-				cin >> input;
-				if (input == "inner"){
-					cin >> input;
-					if (input == "join")
-						return innerJoin(tempTableName);
-					else /// Invalid command
-						return false;
-				}
-				else if (input == "left"){
-					/** Get input and check for an outer join **/
-					cin >> input;
-					if (input == "outer"){
-						cin >> input;
-						if (input == "join")
-							return outerJoin(tempTableName);
-						else /// Invalid command
-							return false;
-					}
-					else /// Invalid command
-						return false;
-				}
-				else /// Invalid command
-					return false;
-			}
-		}
-		/** Process input for table location **/
-		input.pop_back();
+	/** Locate internal table use **/
+	if (shared_ptr<Table> inputTable = findTable(statement.table, true)) {
+		inputTable->load();
+		return inputTable->createIndex(statement.index, statement.column, kind);
 	}
 
-	/** Change input to lower case **/
-	transform(input.begin(), input.end(), input.begin(), ::tolower);
-
-	/** Locate Table in Internal List **/
-	for (auto inputTable: tables){
-		if (inputTable.lowerName == input) {
-				/** Change function based on type of input **/
-				if (typeBased)
-					return inputTable.selectTypes(types);
-				else
-					inputTable.select();
-				return true;
-			}
-		}
+	/** Output error if location failed **/
+	Output::stream() << "!Failed to create index "
+		 << statement.index
+		 << " because table " << statement.table
+		 << " does not exist." << endl;
+
+	return true; /// Return true for end of processing
+}
+/*!
+ * \brief Function for the drop index function
+ *
+ * This function will drop an index from the table holding it.
+ *
+ * \param[in] NameStatement statement
+ *            Syntax tree of the statement
+ * \return boolean true/false
+ *         True or false value depending on state of function. False only sent
+ *         if the parser cannot interpret the error and will send true in case
+ *         of a processed drop command if it is dropped or not.
+ */
+bool Database::dropIndex(const NameStatement &statement) {
+	/** Locate the table holding the index **/
+	for (auto &entry: tables) {
+		if (!entry.second->holdsIndex(statement.name))
+			continue;
+		entry.second->load();
+		if (entry.second->dropIndex(statement.name))
+			return true;
+	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to query table "
-		 << input
+	Output::stream() << "!Failed to delete index "
+		 << statement.name
 		 << " because it does not exist." << endl;
 
-	return true; ///Return true for end of processing
+	return true; /// Return true for end of processing
 }
 /*!
- * \brief Function for the inner join table function
- *
- * This function will select two tables from the internal Table list.
- * When the main parser detects the INNER JOIN command and a database
- * has been used it will direct to this function. The function will
- * then list all the column information or output the appropriate
- * error messages. This function also leads to the joining functions.
+ * \brief Function for the select table function
  *
- * \param[in] string firstTable
- *            String corresponding name of the first table to join
+ * This function will select a table from the internal Table list. The
+ * function will then list the selected columns of the rows matching the
+ * optional condition, or their aggregates by group, in the optional order
+ * and up to the optional limit, or output the appropriate error messages. Selects over more than one table are sent to the
+ * joining function.
  *
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not. This function
- *         will additionally detect if the user is selecting all or selecting a
- *         particular column and direct to the correct function.
+ *         of a processed create command if it is created or not.
  */
-bool Database::innerJoin(string firstTable) {
-	string input; /// String holds input
-	string secondTable; /// String holds the second table
-	string firstType; /// String holds first compare type
-	string secondType; /// String holds second compare type
-	int firstTableIndex = -1; /// Int index of table 1
-	int secondTableIndex = -1; /// Int index of table 2
-	int firstTableTypeIndex = -1; /// Int index of table 1's search type
-	int secondTableTypeIndex = -1;/// Int index of table 2's search type
-	bool firstInput = true; /// Stores if first input to print
-
-	/** Get second table name and process **/
-	cin >> secondTable;
-	cin >> input;
-	cin >> input;
-
-	/** Check for correct syntax **/
-	if (input != "where" && input != "on")
-		return false;
-	cin >> input;
+bool Database::selectTable(const SelectStatement &statement, Transaction *transaction) {
+	string tableName = statement.tables[0].name; /// String holding the table name
 
-	/** Check if proper '.' format **/
-	if (input.find('.') == string::npos)
-		return false;
+	vector<string> types; /// Names of the selected columns
+	bool grouped = !statement.groupBy.empty(); /// Bool if the select lists aggregates by group
 
-	/** Get first table column type **/
-	firstType = input.substr(input.find('.') + 1);
+	if (statement.explain)
+		return explainSelect(statement, transaction);
 
-	/** Check if proper '=' format **/
-	cin >> input;
-	if (input != "=")
-		return false;
+	/** Read the columns and aggregates of the list **/
+	for (const SelectItem &item: statement.columns) {
+		types.push_back(item.column);
+		if (!item.function.empty())
+			grouped = true;
+	}
 
-	/** Get second table column type **/
-	cin >> input;
-	if (input.find('.') == string::npos ) /// Check if proper '.' format
-		return false;
-	if (input.back() != ';') /// Check if ending in ';'
-		return false;
-	input.pop_back();
-	secondType = input.substr(input.find('.') + 1);
+	/** Switch to the joining function **/
+	if (statement.tables.size() > 1) {
+		if (!statement.columns.empty() || grouped || !statement.orderBy.empty()) /// Joins only print every column in row order
+			return false;
+		return joinTables(statement, transaction);
+	}
 
-	/** Change names to lower case **/
-	transform(firstTable.begin(), firstTable.end(), firstTable.begin(), ::tolower);
-	transform(secondTable.begin(), secondTable.end(), secondTable.begin(), ::tolower);
+	/** Change input to lower case **/
+	transform(tableName.begin(), tableName.end(), tableName.begin(), ::tolower);
 
-	/** Check if index exists for tables **/
-	for (size_t i = 0; i < tables.size(); i++) /// Iterate through all tables
-	{
-		if (tables[i].lowerName == firstTable) /// Check if name matches table 1
-			firstTableIndex = i;
-		else if (tables[i].lowerName == secondTable) /// Check if name matches table 2
-			secondTableIndex = i;
+	/** Locate Table in Internal Map **/
+	if (shared_ptr<Table> inputTable = readTable(findTable(tableName), transaction)) {
+		ofstream outFile; /// Stream of the file the result is exported to
+		unique_ptr<ResultSink> sink = openSink(statement.outfile, outFile); /// Sink formatting the result
+		if (!sink)
+			return true;
+		/** Change function based on type of input **/
+		if (grouped) {
+			if (!inputTable->aggregate(statement.columns, statement.groupBy, statement.where.get(),
+				statement.tables[0].alias, statement.orderBy, statement.limit, *sink))
+				return false;
+		}
+		else if (statement.columns.empty() && !statement.where && statement.orderBy.empty()
+			&& statement.limit == SelectStatement::NO_LIMIT)
+			inputTable->select(*sink);
+		else if (!inputTable->selectTypes(types, statement.where.get(), statement.tables[0].alias,
+			statement.orderBy, statement.limit, *sink))
+			return false;
+		closeSink(*sink, statement.outfile, outFile);
+		return true;
 	}
 
-	/** Check for failure **/
-	if (firstTableIndex == -1 || secondTableIndex == -1)
-		return false;
+	/** Output error if location failed **/
+	Output::stream() << "!Failed to query table "
+		 << tableName
+		 << " because it does not exist." << endl;
 
-	/** Check if index exists for first table **/
-	for (size_t i = 0; i < tables[firstTableIndex].columns.size(); i++)
-		if (tables[firstTableIndex].columns[i].colName == firstType)
-			firstTableTypeIndex = i;
+	return true; ///Return true for end of processing
+}
+/*!
+ * \brief Function for printing the plan of a select
+ *
+ * This function will print the steps a select would take, one per line
+ * below the step reading its rows, without reading any row. A join names
+ * the algorithm picked for it and how each table is read, and a select
+ * over one table names the index or scan finding its rows and the
+ * aggregation, sort and limit applied to them.
+ *
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \return boolean true/false
+ *         True or false value depending on state of function. False only sent
+ *         if the select itself would fail the same way.
+ */
+bool Database::explainSelect(const SelectStatement &statement, Transaction *transaction) {
+	vector<pair<size_t, string>> steps; /// Depth and text of each step of the plan
+	bool grouped = !statement.groupBy.empty(); /// Bool if the select lists aggregates by group
+
+	for (const SelectItem &item: statement.columns)
+		grouped |= !item.function.empty();
+
+	/** Steps applied to the result **/
+	if (statement.limit != SelectStatement::NO_LIMIT)
+		steps.emplace_back(steps.size(), "LIMIT " + to_string(statement.limit));
+	if (!statement.orderBy.empty()) {
+		string sort = statement.limit != SelectStatement::NO_LIMIT && Sorter::bounded(statement.limit)
+			? "TOP-N SORT BY " : "SORT BY "; /// Step ordering the rows
+		for (size_t i = 0; i < statement.orderBy.size(); i++) {
+			const SelectItem &item = statement.orderBy[i].item; /// Ordered column or aggregate
+			sort += (i > 0 ? ", " : "") + (item.function.empty() ? item.column : item.function + "(" + item.column + ")")
+				+ (statement.orderBy[i].descending ? " DESC" : "");
+		}
+		steps.emplace_back(steps.size(), sort);
+	}
+	if (grouped) {
+		string aggregate = statement.groupBy.empty() ? "AGGREGATE" : "HASH AGGREGATE BY "; /// Step grouping the rows
+		for (size_t i = 0; i < statement.groupBy.size(); i++)
+			aggregate += (i > 0 ? ", " : "") + statement.groupBy[i];
+		steps.emplace_back(steps.size(), aggregate);
+	}
 
-	/** Check if index exists for first table **/
-	for (size_t i = 0; i < tables[secondTableIndex].columns.size(); i++)
-		if (tables[secondTableIndex].columns[i].colName == secondType)
-			secondTableTypeIndex = i;
+	if (statement.tables.size() > 1) {
+		vector<shared_ptr<Table>> handles; /// Handle of each table
+		vector<Join::Step> joinSteps; /// Table the join starts from and the step of each other table
+		Predicate filter; /// Conditions tested on the joined rows
+
+		if (!statement.columns.empty() || grouped || !statement.orderBy.empty()
+			|| !planJoin(statement, transaction, handles, joinSteps, filter))
+			return false;
+		if (!filter.empty())
+			steps.emplace_back(steps.size(), "FILTER");
+		describeJoin(statement, handles, joinSteps, joinSteps.size() - 1, steps.size(), steps);
+	}
+	else {
+		string tableName = statement.tables[0].name; /// String holding the table name
+		transform(tableName.begin(), tableName.end(), tableName.begin(), ::tolower);
+		shared_ptr<Table> inputTable = readTable(findTable(tableName), transaction); /// Rows of the table
+		string access; /// Step reading the table
+		if (!inputTable) {
+			Output::stream() << "!Failed to query table " << tableName << " because it does not exist." << endl;
+			return true;
+		}
+		if (!inputTable->describeAccess(statement.where.get(), statement.tables[0].alias, access))
+			return false;
+		steps.emplace_back(steps.size(), access);
+	}
 
-	/** Check for failure **/
-	if (firstTableTypeIndex == -1 || secondTableTypeIndex == -1)
-		return false;
+	/** Print each step indented below the step using its rows **/
+	Output::stream() << "QUERY PLAN" << endl;
+	for (const pair<size_t, string> &step: steps)
+		Output::stream() << string(2 * step.first, ' ') << step.second << endl;
+	return true;
+}
+/*!
+ * \brief Function for ordering the tables of a join and picking their algorithms
+ *
+ * This function will find every table of a join, give each table a step
+ * with the conditions tested when it is joined and pick the algorithm of
+ * each step from the equality it joins on, the row counts and the tree
+ * indexes of the join columns.
+ *
+ * Without an outer join the conditions of every ON and WHERE clause are
+ * pooled and each is tested at the first step having all its tables. More
+ * than two tables are then ordered greedily, starting from the smallest
+ * table and adding the smallest table with an equality to the tables
+ * already joined, or the smallest table if none has one. Two tables keep
+ * their written order since every algorithm picks its own build side.
+ *
+ * With an outer join the tables are joined in written order on their ON
+ * clauses. A condition of the WHERE clause is tested early only when no
+ * outer join comes before its tables and no right or full outer join keeps
+ * rows without them, otherwise it filters the joined rows.
+ *
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \param[out] vector<shared_ptr<Table>> handles
+ *             Rows of each table in FROM order
+ * \param[out] vector<Join::Step> steps
+ *             Table the join starts from followed by the step joining each
+ *             other table, in join order
+ * \param[out] Predicate filter
+ *             Conditions of the WHERE clause tested on the joined rows
+ * \return boolean true if every table exists and the conditions name only
+ *         columns of the tables joined so far with valid values
+ */
+bool Database::planJoin(const SelectStatement &statement, Transaction *transaction,
+	vector<shared_ptr<Table>> &handles, vector<Join::Step> &steps, Predicate &filter) {
+	size_t slots = statement.tables.size(); /// Number of joined tables
+	vector<Predicate::Source> sources; /// Tables the conditions read, in FROM order
+	vector<const Expression *> pooled; /// Conditions tested at the first step having their tables
+	vector<const Expression *> late; /// Conditions tested on the joined rows
+	vector<vector<const Expression *>> stepConditions(slots); /// Conditions of each step in join order
+	vector<Predicate> bound; /// Each pooled condition bound alone
+	vector<size_t> order; /// Slots in join order
+	vector<bool> joined(slots, false); /// Bool for each slot if its table is in the join order
+	size_t firstOuter = slots; /// First table joined by an outer join
+	bool keepsRight = false; /// Bool if a right or full outer join keeps rows without the tables before it
+	size_t estimate; /// Estimated number of joined rows
+
+	/** Check if every table exists **/
+	handles.clear();
+	for (const TableRef &table: statement.tables) {
+		handles.push_back(readTable(findTable(table.name), transaction));
+		if (!handles.back())
+			return false;
+		sources.push_back(Predicate::Source{table.name, table.alias, &handles.back()->columns});
+	}
+	for (size_t i = slots; i-- > 1;) {
+		if (statement.tables[i].join >= TableRef::LEFT_OUTER_JOIN)
+			firstOuter = i;
+		keepsRight |= statement.tables[i].join >= TableRef::RIGHT_OUTER_JOIN;
+	}
 
-	/** Print table 1 header **/
-	for (auto inputColumn: tables[firstTableIndex].columns) {
-		if (firstInput) ///Do not print dividers if first input
-			firstInput = false;
-		else ///Print dividers
-			cout << "|";
-		cout << inputColumn.colName << " " << inputColumn.colType;
-		/** If char print the column size **/
-		if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-			cout << "(" << inputColumn.colSize << ")";
-	}
-
-	/** Print table 2 header **/
-	for (auto inputColumn: tables[secondTableIndex].columns) {
-		/** Print dividers and input **/
-		cout << "|" << inputColumn.colName << " " << inputColumn.colType;
-		/** If char print the column size **/
-		if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-			cout << "(" << inputColumn.colSize << ")";
-	}
-	firstInput = true;
-	cout << endl;
-
-	/** Print joined table **/
-	for (size_t i = 0; i < tables[firstTableIndex].rowNum; i++) /// Iterate through table 1
-	{
-		/** Iterate through table 2 **/
-		for (size_t j = 0; j < tables[secondTableIndex].rowNum; j++){
-			/** Check to see if a matching tuple is found **/
-			if (tables[firstTableIndex].columns[firstTableTypeIndex].colData[i] ==
-				tables[secondTableIndex].columns[secondTableTypeIndex].colData[j]) {
-				/** Loop through table 1 columns and print at tuple **/
-				for (auto outputCol: tables[firstTableIndex].columns) {
-					if (firstInput) ///Do not print dividers if first input
-						firstInput = false;
-					else ///Print dividers
-						cout << "|";
-					input = outputCol.colData[i];
-					/** Adjust input for character columns **/
-					if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-						input.erase(0,1);
-						input.pop_back();
-					}
-					cout << input;
+	/** Written order, each ON clause at its table and WHERE conditions as early as they may go **/
+	if (firstOuter < slots) {
+		for (size_t i = 0; i < slots; i++) {
+			order.push_back(i);
+			splitConditions(statement.tables[i].on.get(), stepConditions[i]);
+		}
+		splitConditions(statement.where.get(), pooled);
+		for (const Expression *condition: pooled) {
+			Predicate alone; /// Condition bound alone
+			if (!alone.bind(*condition, sources))
+				return false;
+			size_t last = max(alone.slots().back(), (size_t)1); /// Step having every table of the condition
+			if (last < firstOuter && !keepsRight)
+				stepConditions[last].push_back(condition);
+			else
+				late.push_back(condition);
+		}
+	}
+	/** Any order, every condition at the first step having its tables **/
+	else {
+		for (const TableRef &table: statement.tables)
+			splitConditions(table.on.get(), pooled);
+		splitConditions(statement.where.get(), pooled);
+		bound.resize(pooled.size());
+		for (size_t c = 0; c < pooled.size(); c++) {
+			if (!bound[c].bind(*pooled[c], sources))
+				return false;
+		}
+		order.push_back(0);
+		for (size_t t = 1; t < slots && slots > 2; t++) {
+			if (handles[t]->rowNum < handles[order[0]]->rowNum)
+				order[0] = t;
+		}
+		joined[order[0]] = true;
+		while (order.size() < slots) {
+			size_t next = slots; /// Table joined next
+			bool nextLinked = false; /// Bool if the next table has an equality to the joined tables
+			for (size_t t = 0; t < slots; t++) {
+				bool linked = false; /// Bool if the table has an equality to the joined tables
+				size_t col, otherSlot, otherCol; /// Columns of an equality
+				if (joined[t])
+					continue;
+				for (const Predicate &condition: bound)
+					linked |= condition.joinKey(t, col, otherSlot, otherCol) && joined[otherSlot];
+				if (next == slots || (linked && !nextLinked)
+					|| (linked == nextLinked && handles[t]->rowNum < handles[next]->rowNum)) {
+					next = t;
+					nextLinked = linked;
 				}
-				/** Loop through table 2 columns and print at tuple **/
-				for (auto outputCol: tables[secondTableIndex].columns) {
-					/** Print dividers **/
-					cout << "|";
-					input = outputCol.colData[j];
-					/** Adjust input for character columns **/
-					if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-						input.erase(0,1);
-						input.pop_back();
-					}
-					cout << input;
+			}
+			order.push_back(next);
+			joined[next] = true;
+		}
+		vector<bool> tested(pooled.size(), false); /// Bool for each condition if a step tests it
+		joined.assign(slots, false);
+		joined[order[0]] = true;
+		for (size_t k = 1; k < slots; k++) {
+			joined[order[k]] = true;
+			for (size_t c = 0; c < pooled.size(); c++) {
+				vector<size_t> read = bound[c].slots(); /// Tables the condition reads
+				if (!tested[c] && all_of(read.begin(), read.end(), [&joined](size_t s) { return joined[s]; })) {
+					stepConditions[k].push_back(pooled[c]);
+					tested[c] = true;
 				}
-				firstInput = true;
-				cout << endl;
 			}
 		}
 	}
-	/** End Input **/
-	return true;
+
+	/** Pick the algorithm of each step **/
+	steps.assign(slots, Join::Step());
+	joined.assign(slots, false);
+	estimate = handles[order[0]]->rowNum;
+	steps[0].slot = order[0];
+	steps[0].right.rows = estimate;
+	joined[order[0]] = true;
+	for (size_t k = 1; k < slots; k++) {
+		Join::Step &step = steps[k]; /// Step joining the next table
+		size_t col; /// Join column of the table
+		size_t otherCol; /// Join column of the joined rows
+		step.slot = order[k];
+		step.type = statement.tables[step.slot].join;
+		if (!step.predicate.bind(stepConditions[k], sources))
+			return false;
+		for (size_t s: step.predicate.slots()) {
+			if (s != step.slot && !joined[s])
+				return false;
+		}
+		step.left.rows = estimate;
+		step.left.joined = k > 1;
+		step.right.rows = handles[step.slot]->rowNum;
+		if (step.predicate.joinKey(step.slot, col, step.keySlot, otherCol)) {
+			step.left.column = &handles[step.keySlot]->columns[otherCol];
+			if (!step.left.joined)
+				step.left.index = handles[step.keySlot]->findIndex(otherCol, Predicate::LESS);
+			step.right.column = &handles[step.slot]->columns[col];
+			step.right.index = handles[step.slot]->findIndex(col, Predicate::LESS);
+		}
+		step.method = Join::choose(step.left, step.right);
+		if (step.left.column != nullptr)
+			estimate = max(estimate, step.right.rows);
+		else if (step.right.rows > 0)
+			estimate = estimate > SIZE_MAX / step.right.rows ? SIZE_MAX : estimate * step.right.rows;
+		joined[step.slot] = true;
+	}
+	return filter.bind(late, sources);
 }
 /*!
- * \brief Function for the outer join table function
- *
- * This function will select two tables from the internal Table list.
- * When the main parser detects the OUTER JOIN command and a database
- * has been used it will direct to this function. The function will
- * then list all the column information or output the appropriate
- * error messages. This function also leads to the joining functions.
+ * \brief Function for finding the joined rows
  *
- * \param[in] string firstTable
- *            String corresponding name of the first table to join
+ * This function will start from every row of the first table in join
+ * order and join each other table with its step. The WHERE conditions
+ * left for the joined rows are then tested, and tables joined out of
+ * written order are put back in the order a nested loop over the tables in
+ * FROM order gives.
  *
- * \return boolean true/false
- *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not. This function
- *         will additionally detect if the user is selecting all or selecting a
- *         particular column and direct to the correct function.
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \param[out] vector<shared_ptr<Table>> handles
+ *             Rows of each table in FROM order
+ * \param[out] Join::Tuples tuples
+ *             Row of every table for each joined row
+ * \return boolean true if every table exists and the conditions name only
+ *         columns of the tables joined so far with valid values
  */
-bool Database::outerJoin(string firstTable) {
-	string input; /// String holds input
-	string secondTable; /// String holds the second table
-	string firstType; /// String holds first compare type
-	string secondType; /// String holds second compare type
-	int firstTableIndex = -1; /// Int index of table 1
-	int secondTableIndex = -1; /// Int index of table 2
-	int firstTableTypeIndex = -1; /// Int index of table 1's search type
-	int secondTableTypeIndex = -1;/// Int index of table 2's search type
-	bool firstInput = true; /// Boolean Stores if first input to print
-	bool printedThisRow = false; /// Boolean stores
-
-	/** Get second table name and process **/
-	cin >> secondTable;
-	cin >> input;
-	cin >> input;
-
-	/** Check for correct syntax **/
-	if (input != "on")
+bool Database::joinRows(const SelectStatement &statement, Transaction *transaction,
+	vector<shared_ptr<Table>> &handles, Join::Tuples &tuples) {
+	vector<Join::Step> steps; /// Table the join starts from and the step of each other table
+	Predicate filter; /// Conditions tested on the joined rows
+	size_t slots = statement.tables.size(); /// Number of joined tables
+	size_t kept = 0; /// Number of joined rows passing the filter
+	bool reordered = false; /// Bool if the tables were joined out of written order
+
+	if (!planJoin(statement, transaction, handles, steps, filter))
 		return false;
-	cin >> input;
-
-	/** Check if proper '.' format **/
-	if (input.find('.') == string::npos)
-		return false;
-
-	/** Get first table column type **/
-	firstType = input.substr(input.find('.') + 1);
-
-	/** Check if proper '=' format **/
-	cin >> input;
-	if (input != "=")
-		return false;
-
-	/** Get second table column type **/
-	cin >> input;
-	if (input.find('.') == string::npos ) /// Check if proper '.' format
-		return false;
-	if (input.back() != ';') /// Check if ending in ';'
-		return false;
-	input.pop_back();
-	secondType = input.substr(input.find('.') + 1);
-
-	/** Change names to lower case **/
-	transform(firstTable.begin(), firstTable.end(), firstTable.begin(), ::tolower);
-	transform(secondTable.begin(), secondTable.end(), secondTable.begin(), ::tolower);
 
-	/** Check if index exists for tables **/
-	for (size_t i = 0; i < tables.size(); i++) /// Iterate through all tables
-	{
-		if (tables[i].lowerName == firstTable) /// Check if name matches table 1
-			firstTableIndex = i;
-		else if (tables[i].lowerName == secondTable) /// Check if name matches table 2
-			secondTableIndex = i;
+	/** Join one table at a time **/
+	Join::start(slots, steps[0].slot, steps[0].right.rows, tuples);
+	for (size_t k = 1; k < slots; k++) {
+		Join::extend(steps[k], slots, tuples);
+		reordered |= steps[k].slot != k;
 	}
 
-	/** Check for failure **/
-	if (firstTableIndex == -1 || secondTableIndex == -1)
-		return false;
-
-	/** Check if index exists for first table **/
-	for (size_t i = 0; i < tables[firstTableIndex].columns.size(); i++) {
-		if (tables[firstTableIndex].columns[i].colName == firstType)
-			firstTableTypeIndex = i;
+	/** Test the conditions left for the joined rows **/
+	if (!filter.empty()) {
+		for (size_t i = 0; i < tuples.size(); i += slots) {
+			if (filter.test(&tuples[i]))
+				copy(tuples.begin() + i, tuples.begin() + i + slots, tuples.begin() + kept++ * slots);
+		}
+		tuples.resize(kept * slots);
 	}
-
-	/** Check if index exists for first table **/
-	for (size_t i = 0; i < tables[secondTableIndex].columns.size(); i++) {
-		if (tables[secondTableIndex].columns[i].colName == secondType)
-			secondTableTypeIndex = i;
+	if (reordered) {
+		vector<size_t> rowCounts; /// Number of rows in each table
+		for (const shared_ptr<Table> &handle: handles)
+			rowCounts.push_back(handle->rowNum);
+		Join::orderTuples(rowCounts, tuples);
 	}
+	return true;
+}
+/*!
+ * \brief Function for the join table function
+ *
+ * This function will select the tables of a join from the internal Table
+ * list and list the columns of every table for each joined row, in FROM
+ * order. Tables without a row in a joined row of an outer join are printed
+ * with empty columns.
+ *
+ * \param[in] SelectStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ *
+ * \return boolean true/false
+ *         True or false value depending on state of function. False only sent
+ *         if the parser cannot interpret the error and will send true in case
+ *         of a processed create command if it is created or not.
+ */
+bool Database::joinTables(const SelectStatement &statement, Transaction *transaction) {
+	vector<shared_ptr<Table>> handles; /// Handle of each table
+	Join::Tuples tuples; /// Row of every table for each joined row
+	size_t slots = statement.tables.size(); /// Number of joined tables
+	RowCursor cursor(slots); /// Cursor handing out the values of every table
+	ofstream outFile; /// Stream of the file the result is exported to
+	unique_ptr<ResultSink> sink; /// Sink formatting the result
 
 	/** Check for failure **/
-	if (firstTableTypeIndex == -1 || secondTableTypeIndex == -1)
+	if (!joinRows(statement, transaction, handles, tuples))
 		return false;
-
-	/** Print table 1 header **/
-	for (auto inputColumn: tables[firstTableIndex].columns) {
-		if (firstInput) ///Do not print dividers if first input
-			firstInput = false;
-		else ///Print dividers
-			cout << "|";
-		cout << inputColumn.colName << " " << inputColumn.colType;
-		/** If char print the column size **/
-		if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-			cout << "(" << inputColumn.colSize << ")";
-	}
-
-	/** Print table 2 header **/
-	for (auto inputColumn: tables[secondTableIndex].columns) {
-		/** Print dividers and input **/
-		cout << "|" << inputColumn.colName << " " << inputColumn.colType;
-		/** If char print the column size **/
-		if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-			cout << "(" << inputColumn.colSize << ")";
-	}
-	firstInput = true;
-	cout << endl;
-
-	/** Print joined table **/
-	for (size_t i = 0; i < tables[firstTableIndex].rowNum; i++) /// Iterate through table 1
+	sink = openSink(statement.outfile, outFile);
+	if (!sink)
+		return true;
+
+	/** Print the columns of each table in FROM order **/
+	for (size_t s = 0; s < slots; s++)
+		cursor.projectAll(handles[s]->columns, s);
+	sink->writeHeader(cursor);
+	for (size_t i = 0; i < tuples.size() && sink->rowNum < statement.limit; i += slots) /// Iterate through the joined rows
 	{
-		printedThisRow = false;
-		/** Iterate through table 2 **/
-		for (size_t j = 0; j < tables[secondTableIndex].rowNum; j++){
-			/** Check to see if a matching tuple is found **/
-			if (tables[firstTableIndex].columns[firstTableTypeIndex].colData[i] ==
-				tables[secondTableIndex].columns[secondTableTypeIndex].colData[j]) {
-				printedThisRow = true;
-				/** Loop through table 1 columns and print at tuple **/
-				for (auto outputCol: tables[firstTableIndex].columns) {
-					if (firstInput) ///Do not print dividers if first input
-						firstInput = false;
-					else ///Print dividers
-						cout << "|";
-					input = outputCol.colData[i];
-					/** Adjust input for character columns **/
-					if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-						input.erase(0,1);
-						input.pop_back();
-					}
-					cout << input;
-				}
-				/** Loop through table 2 columns and print at tuple **/
-				for (auto outputCol: tables[secondTableIndex].columns) {
-					/** Print dividers **/
-					cout << "|";
-					input = outputCol.colData[j];
-					/** Adjust input for character columns **/
-					if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-						input.erase(0,1);
-						input.pop_back();
-					}
-					cout << input;
-				}
-				firstInput = true;
-				cout << endl;
-			}
-		}
-		/** Print a blank row if no match found **/
-		if (printedThisRow == false){
-			/** Iterate through first table columns **/
-			for (auto outputCol: tables[firstTableIndex].columns) {
-				if (firstInput) ///Do not print dividers if first input
-					firstInput = false;
-				else ///Print dividers
-					cout << "|";
-				input = outputCol.colData[i];
-				/** Adjust input for character columns **/
-				if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-					input.erase(0,1);
-					input.pop_back();
-				}
-				cout << input;
-			}
-			for (auto outputCol: tables[secondTableIndex].columns) {
-				/** Print dividers **/
-				cout << "|";
-			}
-			firstInput = true;
-			cout << endl;
-		}
+		for (size_t s = 0; s < slots; s++)
+			cursor.seek(s, tuples[i + s]);
+		sink->writeRow(cursor);
 	}
+	/** End Input **/
+	sink->finish();
+	closeSink(*sink, statement.outfile, outFile);
 	return true;
 }
 /*!
  * \brief Function for the alter table function
  *
- * This function will alter a table from the internal Table list.
- * When the main parser detects the ALTER command and a database
- * has been used it will direct to this function. The function will
- * allow the input of a proper column or output the appropriate
- * error messages.
+ * This function will alter a table from the internal Table list by adding
+ * the column of the statement or output the appropriate error messages.
  *
+ * \param[in] AlterTableStatement statement
+ *            Syntax tree of the statement
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::alterTable() {
-	string input; /// String holding user input
-	string tableName; /// String holding the table name
-
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "TABLE") /// Unknown command if TABLE not specified
-		return false;
-	cin >> tableName;
-	cin >> input;
-	if (input != "ADD") /// Unknown command if ADD not specified
-		return false;
-
-	/** Locate internal database use **/
-	for (size_t i = 0; i < tables.size(); i++) {
-		if (tables[i].tableName == tableName)
-			return tables[i].alter();
+bool Database::alterTable(const AlterTableStatement &statement) {
+	/** Locate internal table use **/
+	if (shared_ptr<Table> inputTable = findTable(statement.table, true)) {
+		inputTable->load();
+		return inputTable->alter(statement.column);
 	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to alter table "
-		 << tableName
+	Output::stream() << "!Failed to alter table "
+		 << statement.table
 		 << " because it does not exist." << endl;
 
 	return true; /// Return true for end of processing
@@ -748,36 +884,74 @@ bool Database::alterTable() {
 /*!
  * \brief Function for the insert table function
  *
- * This function will insert into a table from the internal Table list.
- * When the main parser detects the INSERT command and a database
- * has been used it will direct to this function. The function will
- * allow the input of a proper column or output the appropriate
- * error messages.
+ * This function will insert the rows of the statement into a table from the
+ * internal Table list or output the appropriate error messages.
  *
+ * \param[in] InsertStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::insertTable() {
-	string input; ///S tring holding user input
-	string tableName; /// String holding the table name
+bool Database::insertTable(const InsertStatement &statement, Transaction *transaction) {
+	/** Locate internal table use **/
+	if (shared_ptr<Table> inputTable = findTable(statement.table, true)) {
+		if (!lockTable(*inputTable, transaction, "insert into"))
+			return true;
+		inputTable->load();
+		return inputTable->insertRows(statement.rows);
+	}
 
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "into") /// Unknown command if into not specified
-		return false;
-	cin >> tableName;
+	/** Output error if location failed **/
+	Output::stream() << "!Failed to insert into table "
+		 << statement.table
+		 << " because it does not exist." << endl;
 
-	/** Locate internal database use **/
-	for (size_t i = 0; i < tables.size(); i++) {
-		if (tables[i].tableName == tableName)
-			return tables[i].insert();
+	return true; /// Return true for end of processing
+}
+/*!
+ * \brief Function for the copy table function
+ *
+ * This function will load the rows of a data file into a table from the
+ * internal Table list, or write the rows of the table to a data file, or
+ * output the appropriate error messages. A copy to a file reads the rows
+ * the way a select does.
+ *
+ * \param[in] CopyStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \return boolean true/false
+ *         True or false value depending on state of function. False only sent
+ *         if the parser cannot interpret the error and will send true in case
+ *         of a processed copy command if it is loaded or not.
+ */
+bool Database::copyTable(const CopyStatement &statement, Transaction *transaction) {
+	/** Stream every row of the table to the file **/
+	if (statement.toFile) {
+		ofstream outFile; /// Stream of the file the table is exported to
+		if (shared_ptr<Table> inputTable = readTable(findTable(statement.table, true), transaction)) {
+			if (unique_ptr<ResultSink> sink = openSink(statement.file, outFile)) {
+				inputTable->select(*sink);
+				closeSink(*sink, statement.file, outFile);
+			}
+			return true;
+		}
+	}
+	/** Locate internal table use **/
+	else if (shared_ptr<Table> inputTable = findTable(statement.table, true)) {
+		if (!lockTable(*inputTable, transaction, "copy into"))
+			return true;
+		inputTable->load();
+		return inputTable->copyFrom(statement.file.path, statement.file.delimiter);
 	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to insert into table "
-		 << tableName
+	Output::stream() << (statement.toFile ? "!Failed to copy table " : "!Failed to copy into table ")
+		 << statement.table
 		 << " because it does not exist." << endl;
 
 	return true; /// Return true for end of processing
@@ -785,33 +959,30 @@ bool Database::insertTable() {
 /*!
  * \brief Function for the update table function
  *
- * This function will update a table from the internal Table list.
- * When the main parser detects the update command and a database
- * has been used it will direct to this function. The function will
- * allow the input of a proper column or output the appropriate
- * error messages.
+ * This function will update a table from the internal Table list or output
+ * the appropriate error messages.
  *
+ * \param[in] UpdateStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::updateTable() {
-	string input; /// String holding user input
-	string tableName; /// String holding the table name
-
-	/** Receive and Check Input From User **/
-	cin >> tableName;
-
-	/** Locate internal database use **/
-	for (size_t i = 0; i < tables.size(); i++) {
-		if (tables[i].tableName == tableName)
-			return tables[i].update();
+bool Database::updateTable(const UpdateStatement &statement, Transaction *transaction) {
+	/** Locate internal table use **/
+	if (shared_ptr<Table> inputTable = findTable(statement.table, true)) {
+		if (!lockTable(*inputTable, transaction, "update"))
+			return true;
+		inputTable->load();
+		return inputTable->update(statement.setColumn, statement.setValue, *statement.where);
 	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to update table "
-		 << tableName
+	Output::stream() << "!Failed to update table "
+		 << statement.table
 		 << " because it does not exist." << endl;
 
 	return true; /// Return true for end of processing
@@ -819,132 +990,249 @@ bool Database::updateTable() {
 /*!
  * \brief Function for the delete from table function
  *
- * This function will delete from a table from the internal Table list.
- * When the main parser detects the delete command and a database
- * has been used it will direct to this function. The function will
- * allow the input of a proper column or output the appropriate
- * error messages.
+ * This function will delete from a table from the internal Table list or
+ * output the appropriate error messages.
  *
+ * \param[in] DeleteStatement statement
+ *            Syntax tree of the statement
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Database::deleteFromTable() {
-	string input; /// String holding user input
-	string tableName; /// String holding the table name
-
-	/** Receive and Check Input From User **/
-	cin >> input;
-	if (input != "from") /// Unknown command if TABLE not specified
-		return false;
-	cin >> tableName;
+bool Database::deleteFromTable(const DeleteStatement &statement, Transaction *transaction) {
+	string tableName = statement.table; /// String holding the table name
 
 	/** Convert input to lowercase **/
 	transform(tableName.begin(), tableName.end(), tableName.begin(), ::tolower);
 
-	/** Locate internal database use **/
-	for (size_t i = 0; i < tables.size(); i++) {
-		if (tables[i].lowerName == tableName)
-			return tables[i].deleteFrom();
+	/** Locate internal table use **/
+	if (shared_ptr<Table> inputTable = findTable(tableName)) {
+		if (!lockTable(*inputTable, transaction, "delete from"))
+			return true;
+		inputTable->load();
+		return inputTable->deleteFrom(*statement.where);
 	}
 
 	/** Output error if location failed **/
-	cout << "!Failed to delete from table "
+	Output::stream() << "!Failed to delete from table "
 		 << tableName
 		 << " because it does not exist." << endl;
 
 	return true; /// Return true for end of processing
 }
 /*!
- * \brief Function for the database's parser
- *
- * This function will use a database from the internal Database list for use
- * in table manipulation. When the main parser detects the USE command and
- * a valid database is given it will direct to this function. From this
- * function the database's individual actions are controlled. If errors occur
- * it will redirect back to the original parser.
- *
- * \return string containing "END" or last used command
- *         When a command is not recognized in the secondary parser it is
- *         brought back to the main parser to interpret. If the secondary
- *         parser encounters an error it will send END signaling to close the
- *         program.
- * \note Directs flow of program to functions or back to main
+ * \brief Function for executing a statement on the database
+ *
+ * This function will run a statement on the tables of the database. When
+ * the main parser reads a statement that is not handled at the database
+ * list level and a database has been used it will direct to this function,
+ * which passes the syntax tree on to the function for its kind. The log is
+ * synced after a statement that leaves enough bytes unsynced, and once it
+ * has grown past its limit the tables are checkpointed.
+ *
+ * Sessions share the database, so the latch of the database is held while
+ * a statement changing it runs. Queries take no latch and read the last
+ * published snapshot of each table instead, so a long query never holds
+ * up a change and a change never holds up a query. BEGIN opens a transaction for the session, which
+ * locks each table it changes until COMMIT logs its changes or ROLLBACK
+ * undoes them. Statements changing the schema are refused while any table
+ * is locked, and CHECKPOINT inside a transaction, since they write files a
+ * rollback could not take back.
+ *
+ * \param[in] Statement statement
+ *            Syntax tree of the statement
+ * \param[in,out] shared_ptr<Transaction> transaction
+ *                Transaction of the session, empty outside one
+ * \return boolean true/false
+ *         False if the statement cannot be run on a database, signaling the
+ *         main parser to close the program.
+ * \note Directs flow of program to functions for each statement
+ */
+bool Database::execute(const Statement &statement, shared_ptr<Transaction> &transaction) {
+	/** Queries read snapshots, so they run beside the changes **/
+	if (statement.kind == Statement::SELECT)
+		return selectTable(static_cast<const SelectStatement &>(statement), transaction.get());
+	if (statement.kind == Statement::COPY && static_cast<const CopyStatement &>(statement).toFile)
+		return copyTable(static_cast<const CopyStatement &>(statement), transaction.get());
+
+	lock_guard<mutex> guard(latch); /// Latch held for the statement
+	bool processed = true; /// Bool if the statement could be run
+
+	/** Keep files holding uncommitted rows from being written **/
+	switch (statement.kind) {
+	case Statement::CREATE_TABLE: case Statement::DROP_TABLE: case Statement::ALTER_TABLE:
+	case Statement::CREATE_INDEX: case Statement::DROP_INDEX: case Statement::CHECKPOINT:
+		if (transaction || (statement.kind != Statement::CHECKPOINT && locked())) {
+			Output::stream() << "!Failed to run the statement because a transaction is open." << endl;
+			return true;
+		}
+		break;
+	default:
+		break;
+	}
+
+	switch (statement.kind) {
+	case Statement::CREATE_TABLE:
+		processed = createTable(static_cast<const CreateTableStatement &>(statement));
+		break;
+	case Statement::DROP_TABLE:
+		processed = dropTable(static_cast<const NameStatement &>(statement));
+		break;
+	case Statement::CREATE_INDEX:
+		processed = createIndex(static_cast<const CreateIndexStatement &>(statement));
+		break;
+	case Statement::DROP_INDEX:
+		processed = dropIndex(static_cast<const NameStatement &>(statement));
+		break;
+	case Statement::ALTER_TABLE:
+		processed = alterTable(static_cast<const AlterTableStatement &>(statement));
+		break;
+	case Statement::INSERT:
+		processed = insertTable(static_cast<const InsertStatement &>(statement), transaction.get());
+		break;
+	case Statement::COPY:
+		processed = copyTable(static_cast<const CopyStatement &>(statement), transaction.get());
+		break;
+	case Statement::UPDATE:
+		processed = updateTable(static_cast<const UpdateStatement &>(statement), transaction.get());
+		break;
+	case Statement::DELETE:
+		processed = deleteFromTable(static_cast<const DeleteStatement &>(statement), transaction.get());
+		break;
+	case Statement::CHECKPOINT:
+		checkpoint();
+		Output::stream() << "Checkpoint written." << endl;
+		return true;
+	case Statement::BEGIN:
+		if (transaction) {
+			Output::stream() << "!Failed to begin a transaction because one is already open." << endl;
+			return true;
+		}
+		transaction = make_shared<Transaction>();
+		Output::stream() << "Transaction starts." << endl;
+		return true;
+	case Statement::COMMIT:
+	case Statement::ROLLBACK:
+		if (!transaction) {
+			Output::stream() << "!Failed to " << (statement.kind == Statement::COMMIT ? "commit" : "roll back")
+				 << " because no transaction is open." << endl;
+			return true;
+		}
+		if (statement.kind == Statement::ROLLBACK) {
+			transaction->rollback();
+			Output::stream() << "Transaction rolled back." << endl;
+		}
+		else if (transaction->commit(*wal))
+			Output::stream() << "Transaction committed." << endl;
+		else
+			Output::stream() << "!Failed to commit the transaction, it was rolled back." << endl;
+		transaction.reset();
+		return true;
+	default: /// No Acceptable Command
+		return false;
+	}
+
+	/** Sync a large batch between statements, then fold a large log into the table files **/
+	if (wal->unsyncedSize() >= WriteAheadLog::GROUP_COMMIT_BYTES)
+		wal->commit();
+	if (wal->size() > WriteAheadLog::CHECKPOINT_BYTES)
+		checkpoint();
+	return processed;
+}
+/*!
+ * \brief Function to roll back the transaction of a session that ended
+ *
+ * This function will undo the changes of a transaction left open when its
+ * session ended, releasing the tables it locked.
+ *
+ * \param[in,out] shared_ptr<Transaction> transaction
+ *                Transaction of the session, emptied
  */
-string Database::dataBaseParser() {
-	string input; /// String holding user input
-	bool endInput = false; /// Boolean switch if end of input
-
-	/** Main Control Loop **/
-	while (!endInput) {
-		/** Get Token Input **/
-		cin >> input;
-		/** Database Creation/Deletion/Use Commands **/
-	    if (input == "CREATE" || input == "create") /// CREATE command
-	    {
-	    	if (!createTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "DROP") /// DROP command
-	    {
-	    	if (!dropTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "SELECT" || input == "select") /// SELECT command
-	    {
-	    	if (!selectTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "ALTER") /// ALTER command
-	    {
-	    	if (!alterTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "insert") /// INSERT command
-	    {
-	    	if (!insertTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "update") /// UPDATE command
-	    {
-	    	if (!updateTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input == "delete") /// DELETE command
-	    {
-	    	if (!deleteFromTable()) /// If failure end loop and fail main parser
-	    	{
-	    		endInput = true;
-	    		input = "END";
-	    	}
-	    }
-	    else if (input[0] == '-') /// Ignore inputs starting with - and remove line
-        {
-            cin.ignore();
-            getline (cin, input);
-        }
-	    /** No Acceptable Command **/
-	    else
-	    	endInput = true;
-	}
-	return input; /// Return last token or failure string
+void Database::rollback(shared_ptr<Transaction> &transaction) {
+	lock_guard<mutex> guard(latch); /// Latch held for the rollback
+
+	transaction->rollback();
+	transaction.reset();
+}
+/*!
+ * \brief Function to lock a table for a change
+ *
+ * A table changed inside a transaction is locked by it until it ends, so
+ * no other session changes rows the transaction may still undo.
+ *
+ * \param[in,out] Table table
+ *                Table about to be changed
+ * \param[in] Transaction *transaction
+ *            Transaction of the session, null outside one
+ * \param[in] const char *action
+ *            Words naming the change for the error message
+ * \return boolean false if another transaction holds the table
+ */
+bool Database::lockTable(Table &table, Transaction *transaction, const char *action) {
+	if (table.transaction != nullptr && table.transaction != transaction) {
+		Output::stream() << "!Failed to " << action << " table "
+			 << table.tableName
+			 << " because it is locked by another transaction." << endl;
+		return false;
+	}
+	if (transaction != nullptr)
+		transaction->lock(table);
+	return true;
+}
+/*!
+ * \brief Function to check for tables locked by a transaction
+ *
+ * \return boolean true if an open transaction holds a table of the database
+ */
+bool Database::locked() const {
+	for (const auto &tableEntry: tables) {
+		if (tableEntry.second->transaction != nullptr)
+			return true;
+	}
+	return false;
+}
+/*!
+ * \brief Function for the group commit of the database
+ *
+ * This function will sync the records logged since the last commit. The
+ * main parser calls it once it has no more statements waiting, so the
+ * statements of a batch become durable with a single sync.
+ *
+ */
+void Database::commit() {
+	lock_guard<mutex> guard(latch); /// Latch held for the sync
+
+	wal->commit();
+}
+/*!
+ * \brief Function for the checkpoint of the database
+ *
+ * This function will write every table changed since its file was written,
+ * loading the tables whose logged records were not applied yet. Each table
+ * file is on disk once written, and the write-ahead log is emptied only
+ * once every table file holds its records, so a crash part way leaves the
+ * log to replay.
+ *
+ * Tables locked by a transaction of another session are left out, since
+ * their rows may still be rolled back. The log then has to keep their
+ * records and is not emptied.
+ *
+ */
+void Database::checkpoint() {
+	bool complete = true; /// Bool if every changed table was written
+
+	for (auto &tableEntry: tables) {
+		shared_ptr<Table> &changedTable = tableEntry.second; /// Table checked for changes
+		if (changedTable->pending.empty() && changedTable->lastLsn <= changedTable->fileLsn)
+			continue;
+		if (changedTable->transaction != nullptr)
+			complete = false;
+		else if (!changedTable->writeTable(changedTable->tablePath))
+			return;
+	}
+	if (complete)
+		wal->reset();
 }
@@ -0,0 +1,394 @@
+/*!
+ * \file Filter.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Filter class. Every numeric kernel
+ * finds two bitmaps for a batch, the rows above the value and the rows
+ * below it, and the operator picks its result from those. This keeps one
+ * kernel per column type and instruction set and matches Column::compare,
+ * which also orders a row by testing above and below.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILTER_X86
+#endif
+
+#include "../include/Filter.h"
+
+///std name space for general use
+using namespace std;
+
+///Definition of the batch size for use outside the class
+const size_t Filter::BATCH_ROWS;
+///Definition of the bitmap size for use outside the class
+const size_t Filter::BATCH_WORDS;
+
+/*!
+ * \brief Scalar ordering of int rows
+ *
+ * \param[in] const int32_t *data
+ *            Rows of the batch
+ * \param[in] size_t start
+ *            First row to order
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] int32_t value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+static void intOrderScalar(const int32_t *data, size_t start, size_t count, int32_t value,
+	uint64_t *greater, uint64_t *less) {
+	for (size_t i = start; i < count; i++) {
+		greater[i / 64] |= (uint64_t)(data[i] > value) << (i % 64);
+		less[i / 64] |= (uint64_t)(data[i] < value) << (i % 64);
+	}
+}
+/*!
+ * \brief Scalar ordering of float rows
+ *
+ * \param[in] const double *data
+ *            Rows of the batch
+ * \param[in] size_t start
+ *            First row to order
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] double value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+static void floatOrderScalar(const double *data, size_t start, size_t count, double value,
+	uint64_t *greater, uint64_t *less) {
+	for (size_t i = start; i < count; i++) {
+		greater[i / 64] |= (uint64_t)(data[i] > value) << (i % 64);
+		less[i / 64] |= (uint64_t)(data[i] < value) << (i % 64);
+	}
+}
+
+#ifdef FILTER_X86
+/*!
+ * \brief SSE2 ordering of int rows, four rows at a time
+ *
+ * \param[in] const int32_t *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] int32_t value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+__attribute__((target("sse2")))
+static void intOrderSse2(const int32_t *data, size_t count, int32_t value, uint64_t *greater, uint64_t *less) {
+	__m128i bound = _mm_set1_epi32(value); ///Value in every lane
+	size_t i = 0; ///Row being ordered
+
+	for (; i + 4 <= count; i += 4) {
+		__m128i rows = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		uint64_t above = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(rows, bound)));
+		uint64_t below = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(rows, bound)));
+		greater[i / 64] |= above << (i % 64);
+		less[i / 64] |= below << (i % 64);
+	}
+	intOrderScalar(data, i, count, value, greater, less);
+}
+/*!
+ * \brief AVX2 ordering of int rows, eight rows at a time
+ *
+ * \param[in] const int32_t *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] int32_t value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+__attribute__((target("avx2")))
+static void intOrderAvx2(const int32_t *data, size_t count, int32_t value, uint64_t *greater, uint64_t *less) {
+	__m256i bound = _mm256_set1_epi32(value); ///Value in every lane
+	size_t i = 0; ///Row being ordered
+
+	for (; i + 8 <= count; i += 8) {
+		__m256i rows = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+		uint64_t above = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rows, bound)));
+		uint64_t below = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(bound, rows)));
+		greater[i / 64] |= above << (i % 64);
+		less[i / 64] |= below << (i % 64);
+	}
+	intOrderScalar(data, i, count, value, greater, less);
+}
+/*!
+ * \brief SSE2 ordering of float rows, two rows at a time
+ *
+ * \param[in] const double *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] double value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+__attribute__((target("sse2")))
+static void floatOrderSse2(const double *data, size_t count, double value, uint64_t *greater, uint64_t *less) {
+	__m128d bound = _mm_set1_pd(value); ///Value in every lane
+	size_t i = 0; ///Row being ordered
+
+	for (; i + 2 <= count; i += 2) {
+		__m128d rows = _mm_loadu_pd(data + i);
+		uint64_t above = _mm_movemask_pd(_mm_cmpgt_pd(rows, bound));
+		uint64_t below = _mm_movemask_pd(_mm_cmplt_pd(rows, bound));
+		greater[i / 64] |= above << (i % 64);
+		less[i / 64] |= below << (i % 64);
+	}
+	floatOrderScalar(data, i, count, value, greater, less);
+}
+/*!
+ * \brief AVX2 ordering of float rows, four rows at a time
+ *
+ * \param[in] const double *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] double value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+__attribute__((target("avx2")))
+static void floatOrderAvx2(const double *data, size_t count, double value, uint64_t *greater, uint64_t *less) {
+	__m256d bound = _mm256_set1_pd(value); ///Value in every lane
+	size_t i = 0; ///Row being ordered
+
+	for (; i + 4 <= count; i += 4) {
+		__m256d rows = _mm256_loadu_pd(data + i);
+		uint64_t above = _mm256_movemask_pd(_mm256_cmp_pd(rows, bound, _CMP_GT_OQ));
+		uint64_t below = _mm256_movemask_pd(_mm256_cmp_pd(rows, bound, _CMP_LT_OQ));
+		greater[i / 64] |= above << (i % 64);
+		less[i / 64] |= below << (i % 64);
+	}
+	floatOrderScalar(data, i, count, value, greater, less);
+}
+
+/// Bool if the processor running the program has AVX2
+static const bool HAS_AVX2 = __builtin_cpu_supports("avx2");
+#endif
+
+/*!
+ * \brief Order a batch of int rows with the best kernel
+ *
+ * \param[in] const int32_t *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] int32_t value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+static void intOrder(const int32_t *data, size_t count, int32_t value, uint64_t *greater, uint64_t *less) {
+#ifdef FILTER_X86
+	if (HAS_AVX2)
+		intOrderAvx2(data, count, value, greater, less);
+	else
+		intOrderSse2(data, count, value, greater, less);
+#else
+	intOrderScalar(data, 0, count, value, greater, less);
+#endif
+}
+/*!
+ * \brief Order a batch of float rows with the best kernel
+ *
+ * \param[in] const double *data
+ *            Rows of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in] double value
+ *            Value the rows are ordered against
+ * \param[in,out] uint64_t *greater
+ *                Bitmap receiving the rows above the value
+ * \param[in,out] uint64_t *less
+ *                Bitmap receiving the rows below the value
+ */
+static void floatOrder(const double *data, size_t count, double value, uint64_t *greater, uint64_t *less) {
+#ifdef FILTER_X86
+	if (HAS_AVX2)
+		floatOrderAvx2(data, count, value, greater, less);
+	else
+		floatOrderSse2(data, count, value, greater, less);
+#else
+	floatOrderScalar(data, 0, count, value, greater, less);
+#endif
+}
+/*!
+ * \brief Pick the result of an operator from the order of the rows
+ *
+ * \param[in] Predicate::Op op
+ *            Operator of the comparison
+ * \param[in] const uint64_t *greater
+ *            Bitmap of the rows above the value
+ * \param[in] const uint64_t *less
+ *            Bitmap of the rows below the value
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[out] uint64_t *bits
+ *             Bitmap receiving the rows the comparison holds for
+ */
+static void combine(Predicate::Op op, const uint64_t *greater, const uint64_t *less, size_t count, uint64_t *bits) {
+	for (size_t word = 0; word * 64 < count; word++) {
+		switch (op) {
+		case Predicate::EQUAL:
+			bits[word] = ~(greater[word] | less[word]);
+			break;
+		case Predicate::NOT_EQUAL:
+			bits[word] = greater[word] | less[word];
+			break;
+		case Predicate::LESS:
+			bits[word] = less[word];
+			break;
+		case Predicate::LESS_EQUAL:
+			bits[word] = ~greater[word];
+			break;
+		case Predicate::GREATER:
+			bits[word] = greater[word];
+			break;
+		case Predicate::GREATER_EQUAL:
+			bits[word] = ~less[word];
+			break;
+		}
+	}
+}
+/*!
+ * \brief Compare a batch of rows with a value
+ *
+ * This function will compare the rows first to first + count of a column
+ * with a value parsed for the column, giving the same result as
+ * Column::compare for each row. An int column compared with a decimal
+ * value is compared with the nearest whole number on the side the
+ * operator looks at, so int rows never need to be turned into floats.
+ *
+ * \param[in] Column column
+ *            Column compared
+ * \param[in] size_t first
+ *            First row of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch, at most BATCH_ROWS
+ * \param[in] Predicate::Op op
+ *            Operator of the comparison
+ * \param[in] Value value
+ *            Value parsed for the column
+ * \param[out] uint64_t *bits
+ *             Bitmap receiving the rows the comparison holds for
+ */
+void Filter::compare(const Column &column, size_t first, size_t count, Predicate::Op op, const Value &value,
+	uint64_t *bits) {
+	uint64_t greater[BATCH_WORDS] = {}; ///Rows above the value
+	uint64_t less[BATCH_WORDS] = {}; ///Rows below the value
+
+	if (column.layout == Column::INT_LAYOUT) {
+		double bound = value.integral ? (double)value.intValue : value.floatValue; ///Value rows are ordered against
+		if (!value.integral && !std::isnan(bound) && bound != floor(bound)) {
+			/** No row equals a decimal value, and a range starts at the next whole number **/
+			if (op == Predicate::EQUAL || op == Predicate::NOT_EQUAL) {
+				memset(bits, op == Predicate::EQUAL ? 0 : 0xff, (count + 63) / 64 * sizeof(uint64_t));
+				return;
+			}
+			bool below = op == Predicate::LESS || op == Predicate::LESS_EQUAL; ///Bool if the rows below are wanted
+			bound = below ? floor(bound) : ceil(bound);
+			op = below ? Predicate::LESS_EQUAL : Predicate::GREATER_EQUAL;
+		}
+		/** A value no int reaches is above or below every row, and NaN orders as equal **/
+		if (std::isnan(bound) || bound > numeric_limits<int32_t>::max() || bound < numeric_limits<int32_t>::min()) {
+			int order = std::isnan(bound) ? 0 : (bound > 0 ? -1 : 1); ///Order of every row against the value
+			memset(bits, Predicate::holds(op, order) ? 0xff : 0, (count + 63) / 64 * sizeof(uint64_t));
+			return;
+		}
+		intOrder(column.intValues() + first, count, (int32_t)bound, greater, less);
+	}
+	else if (column.layout == Column::FLOAT_LAYOUT)
+		floatOrder(column.floatValues() + first, count, value.floatValue, greater, less);
+	else {
+		for (size_t i = 0; i < count; i++) {
+			int order = column.compare(first + i, value); ///Order of the row against the value
+			greater[i / 64] |= (uint64_t)(order > 0) << (i % 64);
+			less[i / 64] |= (uint64_t)(order < 0) << (i % 64);
+		}
+	}
+	combine(op, greater, less, count, bits);
+}
+/*!
+ * \brief Compare a batch of rows of two columns
+ *
+ * \param[in] Column column
+ *            Column on the left of the comparison
+ * \param[in] Column other
+ *            Column on the right of the comparison, of the same table
+ * \param[in] size_t first
+ *            First row of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch, at most BATCH_ROWS
+ * \param[in] Predicate::Op op
+ *            Operator of the comparison
+ * \param[out] uint64_t *bits
+ *             Bitmap receiving the rows the comparison holds for
+ */
+void Filter::compareRows(const Column &column, const Column &other, size_t first, size_t count,
+	Predicate::Op op, uint64_t *bits) {
+	memset(bits, 0, (count + 63) / 64 * sizeof(uint64_t));
+	for (size_t i = 0; i < count; i++) {
+		if (Predicate::holds(op, column.compareRows(first + i, other, first + i)))
+			bits[i / 64] |= (uint64_t)1 << (i % 64);
+	}
+}
+/*!
+ * \brief Append the rows set in a bitmap
+ *
+ * Bits past the end of the batch are ignored.
+ *
+ * \param[in] const uint64_t *bits
+ *            Bitmap of the batch
+ * \param[in] size_t first
+ *            First row of the batch
+ * \param[in] size_t count
+ *            Number of rows in the batch
+ * \param[in,out] vector<size_t> rows
+ *                Rows receiving the set rows in ascending order
+ */
+void Filter::appendRows(const uint64_t *bits, size_t first, size_t count, vector<size_t> &rows) {
+	for (size_t word = 0; word * 64 < count; word++) {
+		uint64_t set = bits[word]; ///Rows of the word still to append
+		if (count - word * 64 < 64)
+			set &= ((uint64_t)1 << (count - word * 64)) - 1;
+		while (set != 0) {
+			rows.push_back(first + word * 64 + __builtin_ctzll(set));
+			set &= set - 1;
+		}
+	}
+}
@@ -0,0 +1,693 @@
+/*!
+ * \file Index.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Index class. An index maps each
+ * value of a column to the rows holding it, so a where clause on an
+ * indexed column reads only the matching rows instead of the whole column.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "../include/Index.h"
+
+///std name space for general use
+using namespace std;
+
+/// Definition of the posting list of a missing key
+const size_t Index::NO_POSTING;
+
+/*!
+ * \struct IndexSegmentHeader
+ *
+ * \brief Fixed header at the start of packed keys
+ *
+ * The header is followed by the key offsets, left out when every key has
+ * the same width, the posting offsets, the rows of every posting list and
+ * the key bytes. Offsets and rows are 32 bit like the char offsets of a
+ * column, and each offset array holds one more entry than there are keys.
+ */
+struct IndexSegmentHeader {
+	uint64_t keyNum; ///Number of keys
+	uint64_t rowNum; ///Number of rows in the posting lists
+	uint64_t byteNum; ///Number of key bytes
+	uint32_t keyWidth; ///Bytes of each key if all have the same, else zero
+	uint32_t reserved; ///Unused, written as zero
+};
+
+/*!
+ * \struct KeyPacker
+ *
+ * \brief Keys collected in key order before they are packed
+ */
+struct KeyPacker {
+	static const size_t NO_WIDTH = (size_t)-1; ///Width before the first key
+
+	string keyBytes; ///Bytes of every key
+	vector<uint32_t> keyOffsets; ///Offset of each key in keyBytes
+	vector<uint32_t> postingOffsets; ///Offset of the posting list of each key in rows
+	vector<uint32_t> rows; ///Rows of every posting list
+	size_t keyWidth = NO_WIDTH; ///Bytes of each key if all have the same, else zero
+
+	/*!
+	 * \brief Start the posting list of the next key
+	 *
+	 * \param[in] string_view key
+	 *            Key above every key added before
+	 */
+	void addKey(experimental::string_view key) {
+		keyOffsets.push_back(keyBytes.size());
+		postingOffsets.push_back(rows.size());
+		keyBytes.append(key.data(), key.size());
+		keyWidth = (keyWidth == NO_WIDTH || keyWidth == key.size()) ? key.size() : 0;
+	}
+	/*!
+	 * \brief Add a row to the posting list of the last key
+	 *
+	 * \param[in] size_t row
+	 *            Row above every row added to the key before
+	 */
+	void addRow(size_t row) {
+		rows.push_back(row);
+	}
+	/*!
+	 * \brief Lay out the keys collected
+	 *
+	 * \param[out] const char *&segment
+	 *             Start of the packed keys
+	 * \param[out] size_t &length
+	 *             Bytes of the packed keys
+	 * \return shared_ptr buffer holding the packed keys
+	 */
+	shared_ptr<const void> pack(const char *&segment, size_t &length) {
+		IndexSegmentHeader header; ///Header of the packed keys
+		size_t width = keyWidth == NO_WIDTH ? 0 : keyWidth; ///Width written to the header
+
+		keyOffsets.push_back(keyBytes.size());
+		postingOffsets.push_back(rows.size());
+		header.keyNum = postingOffsets.size() - 1;
+		header.rowNum = rows.size();
+		header.byteNum = keyBytes.size();
+		header.keyWidth = width;
+		header.reserved = 0;
+		length = sizeof(header) + (width ? 0 : keyOffsets.size() * sizeof(uint32_t)) +
+			(postingOffsets.size() + rows.size()) * sizeof(uint32_t) + keyBytes.size();
+		shared_ptr<vector<uint64_t>> buffer = make_shared<vector<uint64_t>>(
+			(length + sizeof(uint64_t) - 1) / sizeof(uint64_t)); ///Aligned storage of the packed keys
+		char *cursor = reinterpret_cast<char *>(buffer->data()); ///Current write position
+		segment = cursor;
+		memcpy(cursor, &header, sizeof(header));
+		cursor += sizeof(header);
+		if (!width) {
+			memcpy(cursor, keyOffsets.data(), keyOffsets.size() * sizeof(uint32_t));
+			cursor += keyOffsets.size() * sizeof(uint32_t);
+		}
+		memcpy(cursor, postingOffsets.data(), postingOffsets.size() * sizeof(uint32_t));
+		cursor += postingOffsets.size() * sizeof(uint32_t);
+		memcpy(cursor, rows.data(), rows.size() * sizeof(uint32_t));
+		cursor += rows.size() * sizeof(uint32_t);
+		memcpy(cursor, keyBytes.data(), keyBytes.size());
+		return buffer;
+	}
+};
+
+/*!
+ * \brief Sortable bits of a number
+ *
+ * This function will give the bits of a double with the sign bit flipped
+ * for positive numbers and every bit flipped for negative numbers, so the
+ * bits compare as unsigned integers in numeric order.
+ *
+ * \param[in] double number
+ *            Number to key
+ * \return uint64_t bits of the number in numeric order
+ */
+static uint64_t numberBits(double number) {
+	uint64_t bits; ///Bits of the number
+
+	if (number == 0) ///Key negative zero as zero
+		number = 0;
+	memcpy(&bits, &number, sizeof(bits));
+	return (bits >> 63) ? ~bits : bits | (uint64_t)1 << 63;
+}
+/*!
+ * \brief Key bytes of sortable bits
+ *
+ * \param[in] uint64_t bits
+ *            Bits given by numberBits
+ * \param[out] char *key
+ *             Eight bytes the bits are written to, most significant first
+ */
+static void writeNumberKey(uint64_t bits, char *key) {
+	for (size_t i = 0; i < sizeof(bits); i++)
+		key[i] = (char)(bits >> (8 * (sizeof(bits) - 1 - i)));
+}
+/*!
+ * \brief Key of a number
+ *
+ * The eight bytes of the key sort in numeric order.
+ *
+ * \param[in] double number
+ *            Number to key
+ * \return string holding the eight key bytes
+ */
+static string numberKey(double number) {
+	string key(sizeof(uint64_t), '\0'); ///Key bytes
+
+	writeNumberKey(numberBits(number), &key[0]);
+	return key;
+}
+
+/*!
+ * \brief Constructor of the Index class
+ *
+ * This function will construct an empty index over a column.
+ *
+ * \param[in] string newName
+ *            String corresponding to the name of the index
+ * \param[in] string newColName
+ *            String corresponding to the name of the indexed column
+ * \param[in] Kind newKind
+ *            Structure used to find the posting lists
+ */
+Index::Index(string newName, string newColName, Kind newKind) {
+	indexName = newName;
+	colName = newColName;
+	kind = newKind;
+}
+/*!
+ * \brief Copy constructor of the Index class
+ *
+ * This function will copy the rows changed since the keys were packed,
+ * while the packed keys are shared and never change.
+ *
+ * \param[in] Index other
+ *            Index to copy
+ */
+Index::Index(const Index &other) : indexName(other.indexName), colName(other.colName), kind(other.kind),
+	packedOwner(other.packedOwner), packedSegment(other.packedSegment), packedLength(other.packedLength),
+	keyOffsets(other.keyOffsets), postingOffsets(other.postingOffsets), packedRows(other.packedRows),
+	keyBytes(other.keyBytes), keyNum(other.keyNum), packedRowNum(other.packedRowNum),
+	keyByteNum(other.keyByteNum), keyWidth(other.keyWidth), erasedPacked(other.erasedPacked),
+	postings(other.postings), hashed(other.hashed) {
+	vector<pair<string, size_t>> added; ///Keys and posting lists of the tree
+
+	for (auto entry = other.tree.begin(); entry.valid(); entry.advance())
+		added.push_back(make_pair(entry.key(), entry.value()));
+	tree.bulkLoad(added);
+}
+/*!
+ * \brief Deconstructor of the Index class
+ *
+ * This function will deconstruct the Index class. This currently has no
+ * effect on the class.
+ *
+ */
+Index::~Index() {
+
+}
+/*!
+ * \brief Key of a row
+ *
+ * \param[in] Column column
+ *            Indexed column
+ * \param[in] size_t row
+ *            Row to key
+ * \return string holding the key of the row value
+ */
+string Index::key(const Column &column, size_t row) {
+	if (column.layout == Column::INT_LAYOUT)
+		return numberKey(column.getInt(row));
+	else if (column.layout == Column::FLOAT_LAYOUT)
+		return numberKey(column.getFloat(row));
+	return column.getChars(row).to_string();
+}
+/*!
+ * \brief Key of a parsed value
+ *
+ * \param[in] Column column
+ *            Indexed column the value was parsed for
+ * \param[in] Value value
+ *            Value to key
+ * \return string holding the key of the value
+ */
+string Index::key(const Column &column, const Value &value) {
+	if (column.isChar())
+		return value.charValue;
+	return numberKey(value.integral ? (double)value.intValue : value.floatValue);
+}
+/*!
+ * \brief Index every row of a column
+ *
+ * This function will replace the index with one built from the rows of
+ * the column. The rows are sorted by value, numbers through their sortable
+ * bits and chars in place in the column, and packed in that order without
+ * building a key for each row.
+ *
+ * \param[in] Column column
+ *            Column to index
+ */
+void Index::build(const Column &column) {
+	KeyPacker packer; ///Keys collected in order
+	const char *segment; ///Start of the packed keys
+	size_t length; ///Bytes of the packed keys
+
+	if (column.isChar()) {
+		vector<uint32_t> sorted(column.size()); ///Rows in key order
+		for (size_t i = 0; i < sorted.size(); i++)
+			sorted[i] = i;
+		stable_sort(sorted.begin(), sorted.end(), [&column](uint32_t left, uint32_t right) {
+			return column.getChars(left) < column.getChars(right);
+		});
+		for (size_t i = 0; i < sorted.size(); i++) {
+			if (i == 0 || column.getChars(sorted[i]) != column.getChars(sorted[i - 1]))
+				packer.addKey(column.getChars(sorted[i]));
+			packer.addRow(sorted[i]);
+		}
+	}
+	else {
+		vector<pair<uint64_t, uint32_t>> sorted(column.size()); ///Bits and row in key order
+		for (size_t i = 0; i < sorted.size(); i++) {
+			double number = column.layout == Column::INT_LAYOUT ? column.getInt(i) : column.getFloat(i);
+			sorted[i] = make_pair(numberBits(number), i);
+		}
+		sort(sorted.begin(), sorted.end());
+		for (size_t i = 0; i < sorted.size(); i++) {
+			if (i == 0 || sorted[i].first != sorted[i - 1].first) {
+				char key[sizeof(uint64_t)]; ///Key bytes of the number
+				writeNumberKey(sorted[i].first, key);
+				packer.addKey(KeyView(key, sizeof(key)));
+			}
+			packer.addRow(sorted[i].second);
+		}
+	}
+	shared_ptr<const void> owner = packer.pack(segment, length); ///Buffer holding the packed keys
+	map(owner, segment, length, column.size());
+}
+/*!
+ * \brief Read packed keys
+ *
+ * This function will replace the index with packed keys written by pack,
+ * read in place. Only the header is checked here, the offsets are checked
+ * as they are read so a damaged segment gives no rows instead of reading
+ * outside it.
+ *
+ * \param[in] shared_ptr owner
+ *            Mapped file or buffer holding the segment, kept while the index reads it
+ * \param[in] const char *segment
+ *            Start of the packed keys, aligned to eight bytes
+ * \param[in] size_t length
+ *            Bytes of the segment
+ * \param[in] size_t rows
+ *            Number of rows the keys were packed with
+ * \return boolean true if the segment holds packed keys over the rows
+ */
+bool Index::map(shared_ptr<const void> owner, const char *segment, size_t length, size_t rows) {
+	IndexSegmentHeader header; ///Header of the packed keys
+
+	if (length < sizeof(header))
+		return false;
+	memcpy(&header, segment, sizeof(header));
+	if (header.rowNum != rows || header.keyNum > length || header.rowNum > length || header.byteNum > length)
+		return false;
+	size_t offsetNum = header.keyWidth ? 0 : header.keyNum + 1; ///Number of key offsets
+	if (sizeof(header) + (offsetNum + header.keyNum + 1 + header.rowNum) * sizeof(uint32_t) +
+		header.byteNum > length || (header.keyWidth && header.keyWidth * header.keyNum != header.byteNum))
+		return false;
+	clearChanges();
+	packedOwner = owner;
+	packedSegment = segment;
+	packedLength = length;
+	keyNum = header.keyNum;
+	packedRowNum = header.rowNum;
+	keyByteNum = header.byteNum;
+	keyWidth = header.keyWidth;
+	const uint32_t *cursor = reinterpret_cast<const uint32_t *>(segment + sizeof(header)); ///Current read position
+	keyOffsets = offsetNum ? cursor : nullptr;
+	cursor += offsetNum;
+	postingOffsets = cursor;
+	cursor += keyNum + 1;
+	packedRows = cursor;
+	cursor += packedRowNum;
+	keyBytes = reinterpret_cast<const char *>(cursor);
+	return true;
+}
+/*!
+ * \brief Packed form of every key
+ *
+ * This function will give the keys as written by an index file. Packed
+ * keys without changes are given as they are, otherwise the changes are
+ * merged into a new buffer.
+ *
+ * \param[out] const char *&segment
+ *             Start of the packed keys
+ * \param[out] size_t &length
+ *             Bytes of the packed keys
+ * \return shared_ptr mapped file or buffer holding the packed keys
+ */
+shared_ptr<const void> Index::pack(const char *&segment, size_t &length) const {
+	KeyPacker packer; ///Keys collected in order
+
+	if (packedOwner && postings.empty() && erasedPacked.empty()) {
+		segment = packedSegment;
+		length = packedLength;
+		return packedOwner;
+	}
+	scan(nullptr, nullptr, [&packer](KeyView key, const vector<size_t> &rows) {
+		packer.addKey(key);
+		for (size_t row: rows)
+			packer.addRow(row);
+	});
+	return packer.pack(segment, length);
+}
+/*!
+ * \brief Add a row under a key
+ *
+ * Rows are normally added in ascending order and go to the end of the
+ * posting list, other rows are placed in order. The row must not be held
+ * by the packed keys, a packed row changing its key is erased first.
+ *
+ * \param[in] string key
+ *            Key of the row value
+ * \param[in] size_t row
+ *            Row to add
+ */
+void Index::insert(const string &key, size_t row) {
+	vector<size_t> &rows = postings[addPosting(key)]; ///Posting list of the key
+
+	if (rows.empty() || rows.back() < row)
+		rows.push_back(row);
+	else {
+		auto place = lower_bound(rows.begin(), rows.end(), row);
+		if (*place != row)
+			rows.insert(place, row);
+	}
+}
+/*!
+ * \brief Remove a row from a key
+ *
+ * A row added since packing is taken out of its posting list, and the key
+ * stays with an empty posting list until the index is packed again. A
+ * packed row is marked as erased.
+ *
+ * \param[in] string key
+ *            Key of the row value
+ * \param[in] size_t row
+ *            Row to remove
+ */
+void Index::erase(const string &key, size_t row) {
+	size_t posting = findPosting(key); ///Posting list of the key
+
+	if (posting != NO_POSTING) {
+		vector<size_t> &rows = postings[posting];
+		auto place = lower_bound(rows.begin(), rows.end(), row);
+		if (place != rows.end() && *place == row) {
+			rows.erase(place);
+			return;
+		}
+	}
+	if (row < packedRowNum) {
+		if (erasedPacked.empty())
+			erasedPacked.resize(packedRowNum, false);
+		erasedPacked[row] = true;
+	}
+}
+/*!
+ * \brief Renumber rows after a delete
+ *
+ * This function will drop the erased rows from every posting list and
+ * move the remaining rows down to their new positions, packing the keys
+ * again without the keys left empty.
+ *
+ * \param[in] vector<bool> erased
+ *            Bitmap holding true for each removed row
+ */
+void Index::eraseRows(const vector<bool> &erased) {
+	vector<uint32_t> moved(erased.size()); ///New position of each row
+	size_t kept = 0; ///Number of rows kept so far
+	KeyPacker packer; ///Keys collected in order
+	const char *segment; ///Start of the packed keys
+	size_t length; ///Bytes of the packed keys
+
+	for (size_t i = 0; i < erased.size(); i++) {
+		moved[i] = kept;
+		if (!erased[i])
+			kept++;
+	}
+	scan(nullptr, nullptr, [&](KeyView key, const vector<size_t> &rows) {
+		bool added = false; ///Bool if the key has a row left
+		for (size_t row: rows) {
+			if (row >= erased.size() || erased[row])
+				continue;
+			if (!added)
+				packer.addKey(key);
+			added = true;
+			packer.addRow(moved[row]);
+		}
+	});
+	shared_ptr<const void> owner = packer.pack(segment, length); ///Buffer holding the packed keys
+	map(owner, segment, length, packer.rows.size());
+}
+/*!
+ * \brief Rows holding a key
+ *
+ * \param[in] string key
+ *            Key to look up
+ * \param[out] vector<size_t> rows
+ *             Rows the posting list is appended to in ascending order
+ */
+void Index::equal(const string &key, vector<size_t> &rows) const {
+	size_t position = boundPacked(key, false); ///Packed key at or after the key
+	size_t first = rows.size(); ///Position of the first row appended
+
+	if (position < keyNum && packedKey(position) == KeyView(key))
+		appendPacked(position, rows);
+	size_t middle = rows.size(); ///Position of the first added row
+	appendPosting(findPosting(key), rows);
+	if (middle != first && middle != rows.size())
+		inplace_merge(rows.begin() + first, rows.begin() + middle, rows.end());
+}
+/*!
+ * \brief Rows above a key
+ *
+ * Only a tree index can answer a range.
+ *
+ * \param[in] string key
+ *            Key the rows are above
+ * \param[out] vector<size_t> rows
+ *             Rows the posting lists are appended to in key order
+ */
+void Index::greater(const string &key, vector<size_t> &rows) const {
+	scan(&key, nullptr, [&rows](KeyView, const vector<size_t> &keyRows) {
+		rows.insert(rows.end(), keyRows.begin(), keyRows.end());
+	});
+}
+/*!
+ * \brief Rows below a key
+ *
+ * Only a tree index can answer a range.
+ *
+ * \param[in] string key
+ *            Key the rows are below
+ * \param[out] vector<size_t> rows
+ *             Rows the posting lists are appended to in key order
+ */
+void Index::less(const string &key, vector<size_t> &rows) const {
+	scan(nullptr, &key, [&rows](KeyView, const vector<size_t> &keyRows) {
+		rows.insert(rows.end(), keyRows.begin(), keyRows.end());
+	});
+}
+/*!
+ * \brief Every row in key order
+ *
+ * Only a tree index keeps its keys in order. Rows holding the same key are
+ * listed in ascending order.
+ *
+ * \param[out] vector<size_t> rows
+ *             Rows the posting lists are appended to in key order
+ */
+void Index::ordered(vector<size_t> &rows) const {
+	scan(nullptr, nullptr, [&rows](KeyView, const vector<size_t> &keyRows) {
+		rows.insert(rows.end(), keyRows.begin(), keyRows.end());
+	});
+}
+/*!
+ * \brief Posting list of a key
+ *
+ * \param[in] string key
+ *            Key to look up
+ * \return size_t position of the posting list, or NO_POSTING if the key is
+ *         missing
+ */
+size_t Index::findPosting(const string &key) const {
+	if (postings.empty())
+		return NO_POSTING;
+	if (kind == HASH_INDEX) {
+		auto found = hashed.find(key);
+		return found == hashed.end() ? NO_POSTING : found->second;
+	}
+	size_t *found = tree.find(key); ///Posting list in the tree
+	return found == nullptr ? NO_POSTING : *found;
+}
+/*!
+ * \brief Posting list of a key, added if missing
+ *
+ * \param[in] string key
+ *            Key to look up
+ * \return size_t position of the posting list
+ */
+size_t Index::addPosting(const string &key) {
+	size_t posting = postings.size(); ///Posting list given to a new key
+
+	if (kind == HASH_INDEX)
+		posting = hashed.emplace(key, posting).first->second;
+	else
+		posting = tree.insert(key, posting);
+	if (posting == postings.size())
+		postings.emplace_back();
+	return posting;
+}
+/*!
+ * \brief Append a posting list
+ *
+ * \param[in] size_t posting
+ *            Position of the posting list, or NO_POSTING for none
+ * \param[out] vector<size_t> rows
+ *             Rows the posting list is appended to
+ */
+void Index::appendPosting(size_t posting, vector<size_t> &rows) const {
+	if (posting != NO_POSTING)
+		rows.insert(rows.end(), postings[posting].begin(), postings[posting].end());
+}
+/*!
+ * \brief Packed key at a position
+ *
+ * \param[in] size_t position
+ *            Position of the key, below keyNum
+ * \return string_view bytes of the key, empty if its offsets are damaged
+ */
+Index::KeyView Index::packedKey(size_t position) const {
+	if (keyWidth)
+		return KeyView(keyBytes + position * keyWidth, keyWidth);
+	size_t first = keyOffsets[position]; ///Offset of the key
+	size_t last = keyOffsets[position + 1]; ///Offset past the key
+	if (first > last || last > keyByteNum)
+		return KeyView();
+	return KeyView(keyBytes + first, last - first);
+}
+/*!
+ * \brief First packed key at or after a key
+ *
+ * \param[in] string_view key
+ *            Key to look up
+ * \param[in] bool after
+ *            True to skip a packed key equal to the key
+ * \return size_t position of the first packed key not below the key, or
+ *         above it if after is set, keyNum if there is none
+ */
+size_t Index::boundPacked(KeyView key, bool after) const {
+	size_t low = 0; ///First position that may hold the bound
+	size_t high = keyNum; ///Position past the last that may hold the bound
+
+	while (low < high) {
+		size_t middle = low + (high - low) / 2; ///Position compared
+		int order = packedKey(middle).compare(key); ///Order of the packed key to the key
+		if (order < 0 || (after && order == 0))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+/*!
+ * \brief Append the rows of a packed key
+ *
+ * Rows erased from the key since packing are skipped.
+ *
+ * \param[in] size_t position
+ *            Position of the key, below keyNum
+ * \param[out] vector<size_t> rows
+ *             Rows the posting list is appended to in ascending order
+ */
+void Index::appendPacked(size_t position, vector<size_t> &rows) const {
+	size_t first = postingOffsets[position]; ///Offset of the posting list
+	size_t last = postingOffsets[position + 1]; ///Offset past the posting list
+
+	if (first > last || last > packedRowNum)
+		return;
+	for (size_t i = first; i < last; i++) {
+		size_t row = packedRows[i]; ///Row holding the key
+		if (row < packedRowNum && (erasedPacked.empty() || !erasedPacked[row]))
+			rows.push_back(row);
+	}
+}
+/*!
+ * \brief Visit keys in order
+ *
+ * This function will merge the packed keys with the keys added since, and
+ * visit each key between the bounds that holds a row with all of its rows
+ * in ascending order. The added keys of a hash index are sorted first.
+ *
+ * \param[in] const string *above
+ *            Key every visited key is above, or null for no bound
+ * \param[in] const string *below
+ *            Key every visited key is below, or null for no bound
+ * \param[in] Visitor visit
+ *            Function called with each key and its rows
+ */
+void Index::scan(const string *above, const string *below, const Visitor &visit) const {
+	vector<pair<KeyView, size_t>> added; ///Added keys in the bounds and their posting lists, in key order
+	vector<size_t> rows; ///Rows of the visited key
+	size_t position = above ? boundPacked(*above, true) : 0; ///Next packed key
+	size_t stop = below ? boundPacked(*below, false) : keyNum; ///Packed key past the bounds
+	size_t next = 0; ///Next added key
+
+	if (kind == HASH_INDEX) {
+		for (auto &entry: hashed) {
+			if ((!above || *above < entry.first) && (!below || entry.first < *below))
+				added.push_back(make_pair(KeyView(entry.first), entry.second));
+		}
+		sort(added.begin(), added.end());
+	}
+	else {
+		for (auto entry = above ? tree.upperBound(*above) : tree.begin();
+			entry.valid() && (!below || entry.key() < *below); entry.advance())
+			added.push_back(make_pair(KeyView(entry.key()), entry.value()));
+	}
+	while (position < stop || next < added.size()) {
+		KeyView key; ///Key visited
+		rows.clear();
+		int order = position == stop ? 1 : next == added.size() ? -1 :
+			packedKey(position).compare(added[next].first); ///Order of the next packed and added keys
+		if (order <= 0) {
+			key = packedKey(position);
+			appendPacked(position++, rows);
+		}
+		if (order >= 0) {
+			size_t middle = rows.size(); ///Position of the first added row
+			key = added[next].first;
+			appendPosting(added[next++].second, rows);
+			if (middle != 0 && middle != rows.size())
+				inplace_merge(rows.begin(), rows.begin() + middle, rows.end());
+		}
+		if (!rows.empty())
+			visit(key, rows);
+	}
+}
+/*!
+ * \brief Forget the rows changed since packing
+ */
+void Index::clearChanges() {
+	erasedPacked.clear();
+	erasedPacked.shrink_to_fit();
+	postings.clear();
+	postings.shrink_to_fit();
+	hashed.clear();
+	tree.clear();
+}
@@ -0,0 +1,464 @@
+/*!
+ * \file Join.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Join class. A hash join builds a
+ * hash table on the join column of the smaller table and looks up the rows
+ * of the larger table in it, so a join costs the size of both tables
+ * instead of their product. A merge join reads both join columns in key
+ * order and pairs the runs of equal keys. Either way the matches are put
+ * back in the order a nested loop over the left table gives.
+ *
+ * Joins of more tables extend tuples of joined rows by one table a step,
+ * reading the join column of the joined rows through the row each tuple
+ * holds for its table.
+ *
+ */
+
+#include <algorithm>
+#include <experimental/string_view>
+#include <string>
+#include <unordered_map>
+
+#include "../include/Join.h"
+#include "../include/Sorter.h"
+#include "../include/Statement.h"
+
+///std name space for general use
+using namespace std;
+
+const size_t Join::NO_ROW;
+
+/*!
+ * \brief Build and probe step of the hash join
+ *
+ * This function will build a hash table over the keys of the build side
+ * and look up each key of the probe side in it. Rows sharing a key are
+ * chained through an index array instead of separate lists, and the chains
+ * are built backwards so every chain lists its rows in ascending order.
+ *
+ * \param[in] size_t buildRows
+ *            Number of rows on the build side
+ * \param[in] BuildKey buildKey
+ *            Function giving the key of a build row
+ * \param[in] size_t probeRows
+ *            Number of rows on the probe side
+ * \param[in] ProbeKey probeKey
+ *            Function giving the key of a probe row
+ * \param[in] bool buildIsLeft
+ *            True if the build side is the left table of the join
+ * \param[out] RowPairs matches
+ *             Pairs of left and right rows with equal keys
+ */
+template <typename Key, typename BuildKey, typename ProbeKey>
+static void buildAndProbe(size_t buildRows, BuildKey buildKey, size_t probeRows, ProbeKey probeKey,
+	bool buildIsLeft, Join::RowPairs &matches) {
+	unordered_map<Key, size_t> heads; ///First row of each key
+	vector<size_t> next(buildRows); ///Next row with the same key
+
+	/** Build the hash table on the smaller side **/
+	heads.reserve(buildRows);
+	for (size_t i = buildRows; i-- > 0;) {
+		auto inserted = heads.emplace(buildKey(i), i);
+		next[i] = inserted.second ? Join::NO_ROW : inserted.first->second;
+		inserted.first->second = i;
+	}
+
+	/** Probe with every row of the larger side **/
+	for (size_t j = 0; j < probeRows; j++) {
+		auto found = heads.find(probeKey(j));
+		if (found == heads.end())
+			continue;
+		for (size_t i = found->second; i != Join::NO_ROW; i = next[i]) {
+			if (buildIsLeft)
+				matches.push_back(make_pair(i, j));
+			else
+				matches.push_back(make_pair(j, i));
+		}
+	}
+}
+/*!
+ * \brief Order the matches by the row of one side
+ *
+ * This function will reorder the matches with a stable counting sort on
+ * the row of one side. Matches already ordered by right row and sorted by
+ * left row are listed by left row and then by right row, the order a
+ * nested loop over the left table gives.
+ *
+ * \param[in] size_t rowCount
+ *            Number of rows in the table of the side
+ * \param[in] bool byLeft
+ *            True to order by the left row, false for the right row
+ * \param[in,out] RowPairs matches
+ *                Pairs of left and right rows to reorder
+ */
+static void orderPairs(size_t rowCount, bool byLeft, Join::RowPairs &matches) {
+	vector<size_t> starts(rowCount + 1, 0); ///Start of each row in the result
+	Join::RowPairs ordered(matches.size()); ///Reordered matches
+
+	for (auto &match: matches)
+		starts[(byLeft ? match.first : match.second) + 1]++;
+	for (size_t i = 0; i < rowCount; i++)
+		starts[i + 1] += starts[i];
+	for (auto &match: matches)
+		ordered[starts[byLeft ? match.first : match.second]++] = match;
+	matches.swap(ordered);
+}
+/*!
+ * \brief Pick the join algorithm
+ *
+ * This function will join small tables and tables without an equality
+ * with a nested loop. Otherwise the order of each join column is found and
+ * a merge join is used when both are read in order without sorting or the
+ * hash table on the smaller table would not fit in the sort memory. Columns
+ * of a char and a number type are only joined by hashing their printed
+ * values, and joined rows of earlier tables are only hashed, since their
+ * order is not known until they are read.
+ *
+ * \param[in,out] Input left
+ *                Left table, given the order of its join column
+ * \param[in,out] Input right
+ *                Right table, given the order of its join column
+ * \return Method algorithm joining the tables
+ */
+Join::Method Join::choose(Input &left, Input &right) {
+	if (left.column == nullptr || right.column == nullptr)
+		return NESTED_LOOP;
+	if (left.rows <= NESTED_LOOP_PAIRS / max(right.rows, (size_t)1))
+		return NESTED_LOOP;
+	if (left.column->isChar() != right.column->isChar() || left.joined || right.joined)
+		return HASH_JOIN;
+
+	/** Read a column in row order when it is stored sorted, else through a tree index **/
+	for (Input *input: {&left, &right})
+		input->order = sorted(*input->column) ? SORTED : input->index != nullptr ? INDEXED : UNSORTED;
+	if (left.order != UNSORTED && right.order != UNSORTED)
+		return MERGE_JOIN;
+	if (min(left.rows, right.rows) > Sorter::memoryBytes / HASH_ROW_BYTES)
+		return MERGE_JOIN;
+	return HASH_JOIN;
+}
+/*!
+ * \brief Name a join algorithm
+ *
+ * \param[in] Method method
+ *            Algorithm to name
+ * \return const char * name printed by EXPLAIN
+ */
+const char *Join::methodName(Method method) {
+	switch (method) {
+	case HASH_JOIN:
+		return "HASH JOIN";
+	case MERGE_JOIN:
+		return "MERGE JOIN";
+	default:
+		return "NESTED LOOP JOIN";
+	}
+}
+/*!
+ * \brief Hash join of two columns
+ *
+ * This function will find every pair of rows where the left and right
+ * column hold equal values. The hash table is built on the smaller column.
+ * Keys are hashed in their native type, int and float columns are joined
+ * as numbers, and any other mix is joined on the printed values. Rows read
+ * through row ids are paired by their position among the rows read.
+ *
+ * \param[in] Input left
+ *            Left rows and their join column
+ * \param[in] Input right
+ *            Right rows and their join column
+ * \return RowPairs holding the matching rows ordered by left row and then
+ *         by right row
+ */
+Join::RowPairs Join::hashJoin(const Input &left, const Input &right) {
+	RowPairs matches; ///Pairs of matching rows
+	bool buildIsLeft = left.rows < right.rows; ///Build on the smaller side
+	const Input &buildSide = buildIsLeft ? left : right; ///Rows the hash table is built on
+	const Input &probeSide = buildIsLeft ? right : left; ///Rows looked up in the hash table
+	const Column &build = *buildSide.column; ///Column the hash table is built on
+	const Column &probe = *probeSide.column; ///Column looked up in the hash table
+	const size_t *buildIds = buildSide.rowIds; ///Row of the build column for each build row
+	const size_t *probeIds = probeSide.rowIds; ///Row of the probe column for each probe row
+
+	/** Pick the key type from the column types **/
+	if (build.layout == Column::INT_LAYOUT && probe.layout == Column::INT_LAYOUT) {
+		const int32_t *buildData = build.intValues();
+		const int32_t *probeData = probe.intValues();
+		buildAndProbe<int32_t>(buildSide.rows, [buildData, buildIds](size_t i) { return buildData[buildIds ? buildIds[i] : i]; },
+			probeSide.rows, [probeData, probeIds](size_t i) { return probeData[probeIds ? probeIds[i] : i]; },
+			buildIsLeft, matches);
+	}
+	else if (!build.isChar() && !probe.isChar()) {
+		auto numberAt = [](const Input &input) {
+			return [&input](size_t i) {
+				const Column &column = *input.column;
+				return column.layout == Column::INT_LAYOUT ? (double)column.getInt(input.row(i)) : column.getFloat(input.row(i));
+			};
+		};
+		buildAndProbe<double>(buildSide.rows, numberAt(buildSide), probeSide.rows, numberAt(probeSide),
+			buildIsLeft, matches);
+	}
+	else if (build.isChar() && probe.isChar()) {
+		buildAndProbe<experimental::string_view>(buildSide.rows,
+			[&build, &buildSide](size_t i) { return build.getChars(buildSide.row(i)); },
+			probeSide.rows, [&probe, &probeSide](size_t i) { return probe.getChars(probeSide.row(i)); },
+			buildIsLeft, matches);
+	}
+	else {
+		buildAndProbe<string>(buildSide.rows, [&build, &buildSide](size_t i) { return build.toString(buildSide.row(i)); },
+			probeSide.rows, [&probe, &probeSide](size_t i) { return probe.toString(probeSide.row(i)); },
+			buildIsLeft, matches);
+	}
+
+	/** Probing the right table gives matches ordered by right row **/
+	if (buildIsLeft)
+		orderPairs(left.rows, true, matches);
+	return matches;
+}
+/*!
+ * \brief Check if the rows are in key order
+ *
+ * \param[in] Column column
+ *            Join column
+ * \return boolean true if no row is above the row after it
+ */
+bool Join::sorted(const Column &column) {
+	for (size_t i = 1; i < column.size(); i++) {
+		if (column.compareRows(i - 1, column, i) > 0)
+			return false;
+	}
+	return true;
+}
+/*!
+ * \brief List the rows in key order
+ *
+ * Rows stored in order are listed as they are, an indexed column is read
+ * through its tree index and any other column is sorted.
+ *
+ * \param[in] Input input
+ *            Table on one side of the join
+ * \param[out] vector<size_t> rows
+ *             Rows of the table in key order
+ * \return boolean false if the sort could not write its runs
+ */
+bool Join::keyOrder(const Input &input, vector<size_t> &rows) {
+	rows.clear();
+	rows.reserve(input.rows);
+	if (input.order == SORTED) {
+		for (size_t i = 0; i < input.rows; i++)
+			rows.push_back(i);
+		return true;
+	}
+	if (input.order == INDEXED) {
+		input.index->ordered(rows);
+		return true;
+	}
+	Sorter sorter; ///Sort of the join column
+	sorter.addKey(*input.column, false);
+	return sorter.sort(nullptr, input.rows, SelectStatement::NO_LIMIT, [&rows](size_t row) { rows.push_back(row); });
+}
+/*!
+ * \brief Merge join of two columns
+ *
+ * This function will read both join columns in key order and advance the
+ * side with the lower key. When the keys are equal the run of rows holding
+ * the key on each side is found and every pair of the two runs matches.
+ *
+ * \param[in] Input left
+ *            Left table and the order of its join column
+ * \param[in] Input right
+ *            Right table and the order of its join column
+ * \param[out] RowPairs matches
+ *             Pairs of matching rows ordered by left row and then by right
+ *             row
+ * \return boolean false if a join column could not be sorted
+ */
+bool Join::mergeJoin(const Input &left, const Input &right, RowPairs &matches) {
+	vector<size_t> leftRows; ///Rows of the left table in key order
+	vector<size_t> rightRows; ///Rows of the right table in key order
+	const Column &leftColumn = *left.column; ///Join column of the left table
+	const Column &rightColumn = *right.column; ///Join column of the right table
+	size_t i = 0; ///Position in the left rows
+	size_t j = 0; ///Position in the right rows
+
+	if (!keyOrder(left, leftRows) || !keyOrder(right, rightRows))
+		return false;
+	matches.clear();
+	while (i < leftRows.size() && j < rightRows.size()) {
+		int compared = leftColumn.compareRows(leftRows[i], rightColumn, rightRows[j]); ///Order of the two keys
+		if (compared < 0)
+			i++;
+		else if (compared > 0)
+			j++;
+		else {
+			/** Pair the runs of the equal key **/
+			size_t leftEnd = i + 1; ///End of the left run
+			size_t rightEnd = j + 1; ///End of the right run
+			while (leftEnd < leftRows.size() && leftColumn.compareRows(leftRows[leftEnd], rightColumn, rightRows[j]) == 0)
+				leftEnd++;
+			while (rightEnd < rightRows.size() && leftColumn.compareRows(leftRows[i], rightColumn, rightRows[rightEnd]) == 0)
+				rightEnd++;
+			for (size_t a = i; a < leftEnd; a++) {
+				for (size_t b = j; b < rightEnd; b++)
+					matches.emplace_back(leftRows[a], rightRows[b]);
+			}
+			i = leftEnd;
+			j = rightEnd;
+		}
+	}
+
+	/** Key order is put back to row order **/
+	orderPairs(right.rows, false, matches);
+	orderPairs(left.rows, true, matches);
+	return true;
+}
+/*!
+ * \brief Start from every row of a table
+ *
+ * \param[in] size_t slots
+ *            Number of tables in the join
+ * \param[in] size_t slot
+ *            Slot of the table
+ * \param[in] size_t rows
+ *            Number of rows in the table
+ * \param[out] Tuples tuples
+ *             One tuple per row of the table, with no row for the tables
+ *             not joined yet
+ */
+void Join::start(size_t slots, size_t slot, size_t rows, Tuples &tuples) {
+	tuples.assign(slots * rows, NO_ROW);
+	for (size_t i = 0; i < rows; i++)
+		tuples[i * slots + slot] = i;
+}
+/*!
+ * \brief Join a table to the joined rows
+ *
+ * This function will find the pairs of joined rows and rows of the table
+ * the step holds for, with the algorithm picked for the step. Joined rows
+ * with no row for the table holding the join column never match. Each
+ * matching pair gives a tuple in the order a nested loop over the joined
+ * rows gives. A left or full outer join keeps the joined rows without a
+ * match in place, and a right or full outer join adds the rows of the table
+ * without a match at the end.
+ *
+ * \param[in,out] Step step
+ *                Table joined and the algorithm joining it, falling back
+ *                to a hash join if a merge join cannot sort
+ * \param[in] size_t slots
+ *            Number of tables in the join
+ * \param[in,out] Tuples tuples
+ *                Joined rows, replaced by the rows joined with the table
+ */
+void Join::extend(Step &step, size_t slots, Tuples &tuples) {
+	size_t count = tuples.size() / slots; ///Number of joined rows
+	size_t tableRows = step.right.rows; ///Number of rows in the table
+	vector<size_t> keyRows; ///Row of the join column for each joined row that has one
+	vector<size_t> positions; ///Joined row of each key row
+	vector<size_t> current(slots); ///Rows of the pair being tested
+	RowPairs matches; ///Pairs of joined rows and rows of the table
+	Tuples joined; ///Tuples of the matching pairs
+
+	/** Pairs with equal join columns, tested against the rest of the conditions **/
+	if (step.method != NESTED_LOOP) {
+		if (step.left.joined) {
+			for (size_t i = 0; i < count; i++) {
+				if (tuples[i * slots + step.keySlot] != NO_ROW) {
+					keyRows.push_back(tuples[i * slots + step.keySlot]);
+					positions.push_back(i);
+				}
+			}
+			step.left.rowIds = keyRows.data();
+			step.left.rows = keyRows.size();
+		}
+		if (step.method == MERGE_JOIN && !mergeJoin(step.left, step.right, matches))
+			step.method = HASH_JOIN;
+		if (step.method == HASH_JOIN)
+			matches = hashJoin(step.left, step.right);
+		if (step.left.joined) {
+			for (auto &match: matches)
+				match.first = positions[match.first];
+		}
+		if (!step.predicate.single())
+			matches.erase(remove_if(matches.begin(), matches.end(), [&](const pair<size_t, size_t> &match) {
+				copy(tuples.begin() + match.first * slots, tuples.begin() + (match.first + 1) * slots, current.begin());
+				current[step.slot] = match.second;
+				return !step.predicate.test(current.data());
+			}), matches.end());
+	}
+	/** Every pair tested otherwise **/
+	else {
+		for (size_t i = 0; i < count; i++) {
+			copy(tuples.begin() + i * slots, tuples.begin() + (i + 1) * slots, current.begin());
+			for (size_t j = 0; j < tableRows; j++) {
+				current[step.slot] = j;
+				if (step.predicate.test(current.data()))
+					matches.emplace_back(i, j);
+			}
+		}
+	}
+
+	/** Tuples of the matches and the unmatched rows an outer join keeps **/
+	bool keepLeft = step.type == TableRef::LEFT_OUTER_JOIN || step.type == TableRef::FULL_OUTER_JOIN; ///Bool if unmatched joined rows are kept
+	bool keepRight = step.type == TableRef::RIGHT_OUTER_JOIN || step.type == TableRef::FULL_OUTER_JOIN; ///Bool if unmatched table rows are kept
+	vector<bool> rightMatched(keepRight ? tableRows : 0, false); ///Bool for each table row if it matched
+	size_t next = 0; ///Next match to add
+	joined.reserve(matches.size() * slots);
+	for (size_t i = 0; i < count; i++) {
+		bool matched = false; ///Bool if the joined row had a match
+		for (; next < matches.size() && matches[next].first == i; next++) {
+			joined.insert(joined.end(), tuples.begin() + i * slots, tuples.begin() + (i + 1) * slots);
+			joined[joined.size() - slots + step.slot] = matches[next].second;
+			if (keepRight)
+				rightMatched[matches[next].second] = true;
+			matched = true;
+		}
+		if (!matched && keepLeft)
+			joined.insert(joined.end(), tuples.begin() + i * slots, tuples.begin() + (i + 1) * slots);
+	}
+	for (size_t j = 0; j < rightMatched.size(); j++) {
+		if (!rightMatched[j]) {
+			joined.insert(joined.end(), slots, NO_ROW);
+			joined[joined.size() - slots + step.slot] = j;
+		}
+	}
+	tuples.swap(joined);
+}
+/*!
+ * \brief Order joined rows by table
+ *
+ * This function will list the tuples by the row of the first table, then
+ * by the row of the second and so on, the order a nested loop over the
+ * tables in slot order gives. A stable counting sort on each slot from the
+ * last to the first does this in time linear in the tuples and rows. No
+ * row for a table sorts after every row.
+ *
+ * \param[in] vector<size_t> rowCounts
+ *            Number of rows in the table of each slot
+ * \param[in,out] Tuples tuples
+ *                Joined rows to reorder
+ */
+void Join::orderTuples(const vector<size_t> &rowCounts, Tuples &tuples) {
+	size_t slots = rowCounts.size(); ///Number of tables in the join
+	size_t count = tuples.size() / slots; ///Number of joined rows
+	Tuples ordered(tuples.size()); ///Reordered tuples
+
+	for (size_t slot = slots; slot-- > 0;) {
+		vector<size_t> starts(rowCounts[slot] + 2, 0); ///Start of each row in the result
+		auto bucket = [&](size_t i) {
+			size_t row = tuples[i * slots + slot];
+			return row == NO_ROW ? rowCounts[slot] : row;
+		};
+		for (size_t i = 0; i < count; i++)
+			starts[bucket(i) + 1]++;
+		for (size_t b = 0; b + 1 < starts.size(); b++)
+			starts[b + 1] += starts[b];
+		for (size_t i = 0; i < count; i++)
+			copy(tuples.begin() + i * slots, tuples.begin() + (i + 1) * slots, ordered.begin() + starts[bucket(i)]++ * slots);
+		tuples.swap(ordered);
+	}
+}
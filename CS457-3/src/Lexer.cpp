@@ -0,0 +1,117 @@
+/*!
+ * \file Lexer.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Lexer class. The lexer turns the
+ * text of a statement into the tokens read by the parser.
+ *
+ */
+
+#include <cctype>
+
+#include "../include/Lexer.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the Lexer class
+ *
+ * \param[in] string newText
+ *            Statement to read, which must outlive the lexer
+ */
+Lexer::Lexer(const string &newText) : text(newText) {
+	position = 0;
+}
+/*!
+ * \brief Deconstructor of the Lexer class
+ *
+ * This function will deconstruct the Lexer class. This currently has no
+ * effect on the class.
+ *
+ */
+Lexer::~Lexer() {
+
+}
+/*!
+ * \brief Read the next token
+ *
+ * This function will skip whitespace and read one token. A string that is
+ * never closed gives an INVALID token and the end of the text gives END.
+ *
+ * \return Token read from the statement
+ */
+Token Lexer::next() {
+	Token token; ///Token being read
+
+	/** Skip whitespace **/
+	while (position < text.size() && isspace((unsigned char)text[position]))
+		position++;
+	if (position >= text.size())
+		return token;
+	size_t start = position; ///Start of the token
+	char first = text[position]; ///First character of the token
+
+	/** Words are letters, digits and underscores **/
+	if (isalpha((unsigned char)first) || first == '_') {
+		while (position < text.size() && (isalnum((unsigned char)text[position]) || text[position] == '_'))
+			position++;
+		token.type = Token::IDENTIFIER;
+	}
+	/** Numbers have digits with an optional fraction and exponent **/
+	else if (isdigit((unsigned char)first) ||
+		(first == '.' && position + 1 < text.size() && isdigit((unsigned char)text[position + 1]))) {
+		while (position < text.size() && isdigit((unsigned char)text[position]))
+			position++;
+		if (position < text.size() && text[position] == '.') {
+			position++;
+			while (position < text.size() && isdigit((unsigned char)text[position]))
+				position++;
+		}
+		if (position < text.size() && (text[position] == 'e' || text[position] == 'E')) {
+			size_t exponent = position + 1; ///Position after the e
+			if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-'))
+				exponent++;
+			if (exponent < text.size() && isdigit((unsigned char)text[exponent])) {
+				position = exponent;
+				while (position < text.size() && isdigit((unsigned char)text[position]))
+					position++;
+			}
+		}
+		token.type = Token::NUMBER;
+	}
+	/** Strings run to the matching quote, a doubled quote stands for itself **/
+	else if (first == '\'' || first == '"') {
+		position++;
+		token.type = Token::INVALID;
+		while (position < text.size()) {
+			if (text[position] == first) {
+				if (position + 1 < text.size() && text[position + 1] == first)
+					position += 2;
+				else {
+					position++;
+					token.type = Token::STRING;
+					break;
+				}
+			}
+			else
+				position++;
+		}
+	}
+	/** Comparison operators may be two characters long **/
+	else if ((first == '!' || first == '<' || first == '>') && position + 1 < text.size() &&
+		(text[position + 1] == '=' || (first == '<' && text[position + 1] == '>'))) {
+		position += 2;
+		token.type = Token::SYMBOL;
+	}
+	else {
+		position++;
+		token.type = Token::SYMBOL;
+	}
+	token.text = text.substr(start, position - start);
+	return token;
+}
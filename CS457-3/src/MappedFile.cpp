@@ -0,0 +1,89 @@
+/*!
+ * \file MappedFile.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the MappedFile class. The class wraps
+ * the mmap system call so that table files can be opened without reading
+ * them and are paged in as their columns are used.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/MappedFile.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the MappedFile class
+ *
+ * This function will map the file at the given path read only. If the
+ * file does not exist or is empty nothing is mapped and isOpen reports
+ * false.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the file to map
+ */
+MappedFile::MappedFile(string path) {
+	struct stat fileStat; ///Holds the size of the file
+	int fileDescriptor; ///Holds the open file
+
+	address = nullptr;
+	length = 0;
+
+	/** Open the file and get its size **/
+	fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		return;
+	if (fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+		/** Map the file, the mapping stays valid after closing it **/
+		address = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (address == MAP_FAILED)
+			address = nullptr;
+		else
+			length = fileStat.st_size;
+	}
+	close(fileDescriptor);
+}
+/*!
+ * \brief Deconstructor of the MappedFile class
+ *
+ * This function will remove the mapping if one was made.
+ *
+ */
+MappedFile::~MappedFile() {
+	if (address != nullptr)
+		munmap(address, length);
+}
+/*!
+ * \brief Check if the file is mapped
+ *
+ * \return boolean true if the file was mapped
+ */
+bool MappedFile::isOpen() const {
+	return address != nullptr;
+}
+/*!
+ * \brief Start of the mapping
+ *
+ * \return const char pointer to the first byte of the file
+ */
+const char *MappedFile::data() const {
+	return static_cast<const char *>(address);
+}
+/*!
+ * \brief Length of the mapping
+ *
+ * \return size_t number of bytes mapped
+ */
+size_t MappedFile::size() const {
+	return length;
+}
@@ -0,0 +1,39 @@
+/*!
+ * \file Output.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Output class.
+ *
+ */
+
+#include <iostream>
+
+#include "../include/Output.h"
+
+///std name space for general use
+using namespace std;
+
+/// Stream of the running thread, null for standard output
+thread_local ostream *Output::current = nullptr;
+
+/*!
+ * \brief Stream of the running thread
+ *
+ * \return ostream the results of the running statement are written to
+ */
+ostream &Output::stream() {
+	return current == nullptr ? cout : *current;
+}
+/*!
+ * \brief Set the stream of the running thread
+ *
+ * \param[in] ostream *newStream
+ *            Stream the results are written to from now on, null for standard output
+ */
+void Output::redirect(ostream *newStream) {
+	current = newStream;
+}
@@ -0,0 +1,765 @@
+/*!
+ * \file Parser.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Parser class. Each statement is
+ * parsed by a function for its first keyword, which builds the syntax
+ * tree of the statement from the smaller rules below.
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include "../include/Parser.h"
+
+///std name space for general use
+using namespace std;
+
+/// Words that end a table reference instead of naming its alias
+static const char *RESERVED[] = {"where", "inner", "left", "right", "full", "cross", "join", "on", "outer", "as", "into",
+	"group", "order", "limit"};
+
+/*!
+ * \brief Case insensitive comparison of a word
+ *
+ * \param[in] string text
+ *            Text of a token
+ * \param[in] const char *word
+ *            Lowercase word to compare with
+ * \return boolean true if the token is the word
+ */
+static bool sameWord(const string &text, const char *word) {
+	if (text.size() != strlen(word))
+		return false;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (tolower((unsigned char)text[i]) != word[i])
+			return false;
+	}
+	return true;
+}
+/*!
+ * \brief Read a whole number written with digits only
+ *
+ * \param[in] string text
+ *            Text of a number token
+ * \param[in] unsigned long long most
+ *            Largest number accepted
+ * \param[out] unsigned long long value
+ *             Number read
+ * \return boolean true if the text is a number no larger than the most accepted
+ */
+static bool wholeNumber(const string &text, unsigned long long most, unsigned long long &value) {
+	if (text.empty() || text.find_first_not_of("0123456789") != string::npos)
+		return false;
+	errno = 0;
+	value = strtoull(text.c_str(), nullptr, 10);
+	return errno != ERANGE && value <= most;
+}
+
+/*!
+ * \brief Constructor of the Parser class
+ *
+ * \param[in] string newText
+ *            Statement to parse, which must outlive the parser
+ */
+Parser::Parser(const string &newText) : lexer(newText) {
+	advance();
+}
+/*!
+ * \brief Deconstructor of the Parser class
+ *
+ * This function will deconstruct the Parser class. This currently has no
+ * effect on the class.
+ *
+ */
+Parser::~Parser() {
+
+}
+/*!
+ * \brief Parse the statement
+ *
+ * This function will pick the statement from its first keyword. Commands
+ * starting with a '.' such as .exit do not need a ';'. EXPLAIN may come
+ * before a select that is not written to a file.
+ *
+ * \return unique_ptr<Statement> syntax tree of the statement, or empty if
+ *         the statement does not follow the grammar
+ */
+unique_ptr<Statement> Parser::parse() {
+	if (symbol(".")) {
+		if (!keyword("exit"))
+			return nullptr;
+		symbol(";");
+		if (current.type != Token::END)
+			return nullptr;
+		return unique_ptr<Statement>(new Statement(Statement::EXIT));
+	}
+	if (keyword("create"))
+		return parseCreate();
+	if (keyword("drop"))
+		return parseDrop();
+	if (keyword("use")) {
+		unique_ptr<NameStatement> statement(new NameStatement(Statement::USE_DATABASE));
+		if (!identifier(statement->name) || !end())
+			return nullptr;
+		return move(statement);
+	}
+	if (keyword("alter"))
+		return parseAlter();
+	if (keyword("insert"))
+		return parseInsert();
+	if (keyword("copy"))
+		return parseCopy();
+	if (keyword("update"))
+		return parseUpdate();
+	if (keyword("delete"))
+		return parseDelete();
+	if (keyword("select"))
+		return parseSelect();
+	if (keyword("checkpoint")) {
+		if (!end())
+			return nullptr;
+		return unique_ptr<Statement>(new Statement(Statement::CHECKPOINT));
+	}
+	if (keyword("begin")) {
+		keyword("transaction");
+		if (!end())
+			return nullptr;
+		return unique_ptr<Statement>(new Statement(Statement::BEGIN));
+	}
+	if (keyword("commit")) {
+		if (!end())
+			return nullptr;
+		return unique_ptr<Statement>(new Statement(Statement::COMMIT));
+	}
+	if (keyword("rollback")) {
+		if (!end())
+			return nullptr;
+		return unique_ptr<Statement>(new Statement(Statement::ROLLBACK));
+	}
+	if (keyword("explain")) {
+		if (!keyword("select"))
+			return nullptr;
+		unique_ptr<Statement> statement = parseSelect(); ///Select whose plan is printed
+		SelectStatement *select = static_cast<SelectStatement *>(statement.get());
+		if (select == nullptr || !select->outfile.path.empty())
+			return nullptr;
+		select->explain = true;
+		return statement;
+	}
+	return nullptr;
+}
+/*!
+ * \brief Move to the next token
+ */
+void Parser::advance() {
+	current = lexer.next();
+}
+/*!
+ * \brief Accept a keyword
+ *
+ * \param[in] const char *word
+ *            Lowercase keyword to accept
+ * \return boolean true if the current token was the keyword and was passed
+ */
+bool Parser::keyword(const char *word) {
+	if (current.type != Token::IDENTIFIER || !sameWord(current.text, word))
+		return false;
+	advance();
+	return true;
+}
+/*!
+ * \brief Accept a symbol
+ *
+ * \param[in] const char *text
+ *            Symbol to accept
+ * \return boolean true if the current token was the symbol and was passed
+ */
+bool Parser::symbol(const char *text) {
+	if (current.type != Token::SYMBOL || current.text != text)
+		return false;
+	advance();
+	return true;
+}
+/*!
+ * \brief Accept a name
+ *
+ * \param[out] string name
+ *             Name of a database, table, column or index
+ * \return boolean true if the current token was a name and was passed
+ */
+bool Parser::identifier(string &name) {
+	if (current.type != Token::IDENTIFIER)
+		return false;
+	name = current.text;
+	advance();
+	return true;
+}
+/*!
+ * \brief Accept a literal
+ *
+ * This function will accept a number with an optional sign or a quoted
+ * string. A doubled quote inside a string is turned back into a single
+ * quote, the surrounding quotes are kept so the column can tell a string
+ * from a number.
+ *
+ * \param[out] string value
+ *             Text of the literal
+ * \return boolean true if a literal was passed
+ */
+bool Parser::literal(string &value) {
+	string sign; ///Sign written before a number
+
+	if (current.type == Token::SYMBOL && (current.text == "-" || current.text == "+")) {
+		sign = current.text;
+		advance();
+		if (current.type != Token::NUMBER)
+			return false;
+	}
+	if (current.type == Token::NUMBER)
+		value = sign + current.text;
+	else if (current.type == Token::STRING) {
+		char quote = current.text.front(); ///Quote around the string
+		value.assign(1, quote);
+		for (size_t i = 1; i + 1 < current.text.size(); i++) {
+			value += current.text[i];
+			if (current.text[i] == quote)
+				i++;
+		}
+		value += quote;
+	}
+	else
+		return false;
+	advance();
+	return true;
+}
+/*!
+ * \brief Accept a column definition
+ *
+ * A definition is a name followed by int, float, char(size) or
+ * varchar(size), where the size is a positive number that fits an int.
+ *
+ * \param[out] ColumnDef column
+ *             Definition of the column
+ * \return boolean true if a definition was passed
+ */
+bool Parser::columnDef(ColumnDef &column) {
+	if (!identifier(column.name))
+		return false;
+	if (keyword("int"))
+		column.type = "int";
+	else if (keyword("float"))
+		column.type = "float";
+	else if (current.type == Token::IDENTIFIER && (sameWord(current.text, "char") || sameWord(current.text, "varchar"))) {
+		unsigned long long size; ///Size of the column as written
+		column.type = sameWord(current.text, "char") ? "char" : "varchar";
+		advance();
+		if (!symbol("(") || current.type != Token::NUMBER || !wholeNumber(current.text, INT_MAX, size) || size == 0)
+			return false;
+		column.size = size;
+		advance();
+		return symbol(")");
+	}
+	else
+		return false;
+	column.size = 0;
+	return true;
+}
+/*!
+ * \brief Accept a column or literal
+ *
+ * \param[out] Operand side
+ *             Column, with its table if qualified, or literal
+ * \return boolean true if an operand was passed
+ */
+bool Parser::operand(Operand &side) {
+	side = Operand();
+	if (current.type == Token::IDENTIFIER) {
+		side.isColumn = true;
+		identifier(side.text);
+		if (symbol(".")) {
+			side.table = side.text;
+			return identifier(side.text);
+		}
+		return true;
+	}
+	return literal(side.text);
+}
+/*!
+ * \brief Accept a comparison
+ *
+ * \param[out] Condition where
+ *             Operands and operator of the comparison
+ * \return boolean true if a comparison was passed
+ */
+bool Parser::condition(Condition &where) {
+	static const char *OPERATORS[] = {"=", "!=", "<>", "<", ">", "<=", ">="}; ///Comparison operators
+
+	if (!operand(where.left) || current.type != Token::SYMBOL)
+		return false;
+	if (none_of(std::begin(OPERATORS), std::end(OPERATORS), [this](const char *op) { return current.text == op; }))
+		return false;
+	where.op = current.text == "<>" ? "!=" : current.text;
+	advance();
+	return operand(where.right);
+}
+/*!
+ * \brief Accept expressions joined by OR
+ *
+ * OR binds looser than AND, which binds looser than NOT, and each joins
+ * its operands from the left.
+ *
+ * \return unique_ptr<Expression> expression, or empty on a syntax error
+ */
+unique_ptr<Expression> Parser::expression() {
+	unique_ptr<Expression> result = conjunction(); ///Expression read so far
+
+	while (result && keyword("or")) {
+		unique_ptr<Expression> joined(new Expression()); ///OR of the expressions
+		joined->kind = Expression::OR;
+		joined->left = move(result);
+		joined->right = conjunction();
+		if (!joined->right)
+			return nullptr;
+		result = move(joined);
+	}
+	return result;
+}
+/*!
+ * \brief Accept expressions joined by AND
+ *
+ * \return unique_ptr<Expression> expression, or empty on a syntax error
+ */
+unique_ptr<Expression> Parser::conjunction() {
+	unique_ptr<Expression> result = factor(); ///Expression read so far
+
+	while (result && keyword("and")) {
+		unique_ptr<Expression> joined(new Expression()); ///AND of the expressions
+		joined->kind = Expression::AND;
+		joined->left = move(result);
+		joined->right = factor();
+		if (!joined->right)
+			return nullptr;
+		result = move(joined);
+	}
+	return result;
+}
+/*!
+ * \brief Accept a comparison, a NOT or an expression in parentheses
+ *
+ * \return unique_ptr<Expression> expression, or empty on a syntax error
+ */
+unique_ptr<Expression> Parser::factor() {
+	unique_ptr<Expression> result(new Expression()); ///Expression being read
+
+	if (keyword("not")) {
+		result->kind = Expression::NOT;
+		result->left = factor();
+		if (!result->left)
+			return nullptr;
+		return result;
+	}
+	if (symbol("(")) {
+		result = expression();
+		if (!result || !symbol(")"))
+			return nullptr;
+		return result;
+	}
+	if (!condition(result->compare))
+		return nullptr;
+	return result;
+}
+/*!
+ * \brief Accept a column or aggregate of a select list
+ *
+ * A column may be qualified by a table, which is dropped. An aggregate is
+ * COUNT(*) or COUNT, SUM, AVG, MIN or MAX of a column.
+ *
+ * \param[out] SelectItem item
+ *             Function and column of the item
+ * \return boolean true if an item was passed
+ */
+bool Parser::selectItem(SelectItem &item) {
+	static const char *FUNCTIONS[] = {"count", "sum", "avg", "min", "max"}; ///Aggregate functions
+	string name; ///First name of the item
+
+	if (!identifier(name))
+		return false;
+	if (!symbol("(")) {
+		item.column = name;
+		return !symbol(".") || identifier(item.column);
+	}
+	if (none_of(std::begin(FUNCTIONS), std::end(FUNCTIONS), [&name](const char *function) { return sameWord(name, function); }))
+		return false;
+	item.function = name;
+	transform(item.function.begin(), item.function.end(), item.function.begin(), ::toupper);
+	if (item.function == "COUNT" && symbol("*"))
+		item.column = "*";
+	else if (!identifier(item.column) || (symbol(".") && !identifier(item.column)))
+		return false;
+	return symbol(")");
+}
+/*!
+ * \brief Accept a table and its alias
+ *
+ * \param[out] TableRef table
+ *             Name and alias of the table
+ * \return boolean true if a table was passed
+ */
+bool Parser::tableRef(TableRef &table) {
+	if (!identifier(table.name))
+		return false;
+	table.alias.clear();
+	if (keyword("as"))
+		return identifier(table.alias);
+	if (current.type == Token::IDENTIFIER &&
+		none_of(std::begin(RESERVED), std::end(RESERVED), [this](const char *word) { return sameWord(current.text, word); }))
+		identifier(table.alias);
+	return true;
+}
+/*!
+ * \brief Accept the keywords joining a table
+ *
+ * A comma or [CROSS | INNER | LEFT [OUTER] | RIGHT [OUTER] | FULL [OUTER]]
+ * JOIN, where a bare JOIN is an inner join.
+ *
+ * \param[out] TableRef::JoinType join
+ *             Way the next table is joined
+ * \return boolean true if a table is joined next
+ */
+bool Parser::joinType(TableRef::JoinType &join) {
+	if (symbol(",")) {
+		join = TableRef::CROSS_JOIN;
+		return true;
+	}
+	if (keyword("cross"))
+		join = TableRef::CROSS_JOIN;
+	else if (keyword("inner"))
+		join = TableRef::INNER_JOIN;
+	else if (keyword("left"))
+		join = TableRef::LEFT_OUTER_JOIN;
+	else if (keyword("right"))
+		join = TableRef::RIGHT_OUTER_JOIN;
+	else if (keyword("full"))
+		join = TableRef::FULL_OUTER_JOIN;
+	else {
+		join = TableRef::INNER_JOIN;
+		return keyword("join");
+	}
+	if (join >= TableRef::LEFT_OUTER_JOIN)
+		keyword("outer");
+	return keyword("join");
+}
+/*!
+ * \brief Accept a data file and its format
+ *
+ * 'path' [DELIMITER 'character'] [FORMAT CSV|BINARY], where the delimiter
+ * may be written as '\t' for a tab.
+ *
+ * \param[out] FileOptions file
+ *             Path and format of the file
+ * \return boolean true if the file was accepted
+ */
+bool Parser::fileOptions(FileOptions &file) {
+	string delimiter; ///Quoted delimiter
+
+	if (current.type != Token::STRING || !literal(file.path))
+		return false;
+	file.path = file.path.substr(1, file.path.size() - 2);
+	if (keyword("delimiter")) {
+		if (current.type != Token::STRING || !literal(delimiter))
+			return false;
+		delimiter = delimiter.substr(1, delimiter.size() - 2);
+		if (delimiter == "\\t")
+			delimiter = "\t";
+		if (delimiter.size() != 1 || delimiter[0] == '"' || delimiter[0] == '\n')
+			return false;
+		file.delimiter = delimiter[0];
+	}
+	if (keyword("format")) {
+		if (keyword("binary"))
+			file.binary = true;
+		else if (!keyword("csv"))
+			return false;
+	}
+	return true;
+}
+/*!
+ * \brief Accept the end of the statement
+ *
+ * \return boolean true if only a ';' is left
+ */
+bool Parser::end() {
+	return symbol(";") && current.type == Token::END;
+}
+/*!
+ * \brief Parse a CREATE statement
+ *
+ * CREATE DATABASE name, CREATE TABLE name (definitions) or
+ * CREATE INDEX name ON table (column) [USING HASH | BTREE].
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseCreate() {
+	if (keyword("database")) {
+		unique_ptr<NameStatement> statement(new NameStatement(Statement::CREATE_DATABASE));
+		if (!identifier(statement->name) || !end())
+			return nullptr;
+		return move(statement);
+	}
+	if (keyword("table")) {
+		unique_ptr<CreateTableStatement> statement(new CreateTableStatement());
+		if (!identifier(statement->table) || !symbol("("))
+			return nullptr;
+		/** An empty list gives a table without columns **/
+		if (!symbol(")")) {
+			do {
+				statement->columns.emplace_back();
+				if (!columnDef(statement->columns.back()))
+					return nullptr;
+			} while (symbol(","));
+			if (!symbol(")"))
+				return nullptr;
+		}
+		if (!end())
+			return nullptr;
+		return move(statement);
+	}
+	if (keyword("index")) {
+		unique_ptr<CreateIndexStatement> statement(new CreateIndexStatement());
+		if (!identifier(statement->index) || !keyword("on") || !identifier(statement->table) ||
+			!symbol("(") || !identifier(statement->column) || !symbol(")"))
+			return nullptr;
+		if (keyword("using")) {
+			if (keyword("hash"))
+				statement->hash = true;
+			else if (!keyword("btree"))
+				return nullptr;
+		}
+		if (!end())
+			return nullptr;
+		return move(statement);
+	}
+	return nullptr;
+}
+/*!
+ * \brief Parse a DROP statement
+ *
+ * DROP DATABASE name, DROP TABLE name or DROP INDEX name.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseDrop() {
+	Statement::Kind kind; ///Kind of the dropped object
+
+	if (keyword("database"))
+		kind = Statement::DROP_DATABASE;
+	else if (keyword("table"))
+		kind = Statement::DROP_TABLE;
+	else if (keyword("index"))
+		kind = Statement::DROP_INDEX;
+	else
+		return nullptr;
+	unique_ptr<NameStatement> statement(new NameStatement(kind));
+	if (!identifier(statement->name) || !end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse an ALTER statement
+ *
+ * ALTER TABLE name ADD definition.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseAlter() {
+	unique_ptr<AlterTableStatement> statement(new AlterTableStatement());
+
+	if (!keyword("table") || !identifier(statement->table) || !keyword("add") ||
+		!columnDef(statement->column) || !end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse an INSERT statement
+ *
+ * INSERT INTO name VALUES (literal, ...), (literal, ...), ...
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseInsert() {
+	unique_ptr<InsertStatement> statement(new InsertStatement());
+
+	if (!keyword("into") || !identifier(statement->table) || !keyword("values"))
+		return nullptr;
+	/** Rows are listed in parentheses separated by commas **/
+	do {
+		if (!symbol("("))
+			return nullptr;
+		statement->rows.emplace_back();
+		vector<string> &values = statement->rows.back(); ///Literals of the row
+		do {
+			values.emplace_back();
+			if (!literal(values.back()))
+				return nullptr;
+		} while (symbol(","));
+		if (!symbol(")"))
+			return nullptr;
+	} while (symbol(","));
+	if (!end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse a COPY statement
+ *
+ * COPY name FROM 'path' or COPY name TO 'path', followed by the options
+ * of the file. Only text files can be loaded.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseCopy() {
+	unique_ptr<CopyStatement> statement(new CopyStatement());
+
+	if (!identifier(statement->table))
+		return nullptr;
+	if (keyword("to"))
+		statement->toFile = true;
+	else if (!keyword("from"))
+		return nullptr;
+	if (!fileOptions(statement->file) || (statement->file.binary && !statement->toFile) || !end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse an UPDATE statement
+ *
+ * UPDATE name SET column = literal WHERE expression.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseUpdate() {
+	unique_ptr<UpdateStatement> statement(new UpdateStatement());
+
+	if (!identifier(statement->table) || !keyword("set") || !identifier(statement->setColumn) ||
+		!symbol("=") || !literal(statement->setValue) || !keyword("where"))
+		return nullptr;
+	statement->where = expression();
+	if (!statement->where || !end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse a DELETE statement
+ *
+ * DELETE FROM name WHERE expression.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseDelete() {
+	unique_ptr<DeleteStatement> statement(new DeleteStatement());
+
+	if (!keyword("from") || !identifier(statement->table) || !keyword("where"))
+		return nullptr;
+	statement->where = expression();
+	if (!statement->where || !end())
+		return nullptr;
+	return move(statement);
+}
+/*!
+ * \brief Parse a SELECT statement
+ *
+ * SELECT * or a list of columns FROM a table with an optional WHERE
+ * clause. Any number of tables may follow, each listed with a comma or
+ * CROSS JOIN, or joined with INNER, LEFT, RIGHT or FULL JOIN and an ON
+ * clause.
+ * The list may hold the aggregates COUNT, SUM, AVG, MIN and MAX, which may
+ * be followed by GROUP BY and a list of columns. ORDER BY a list of
+ * columns or aggregates, each ASC or DESC, and LIMIT may follow. INTO
+ * OUTFILE and the options of a file may end the statement.
+ *
+ * \return unique_ptr<Statement> syntax tree, or empty on a syntax error
+ */
+unique_ptr<Statement> Parser::parseSelect() {
+	unique_ptr<SelectStatement> statement(new SelectStatement());
+	string column; ///Name of a grouped column
+	TableRef::JoinType join; ///Way the next table is joined
+
+	/** Selected columns and aggregates **/
+	if (!symbol("*")) {
+		do {
+			statement->columns.emplace_back();
+			if (!selectItem(statement->columns.back()))
+				return nullptr;
+		} while (symbol(","));
+	}
+
+	/** Tables and the way each is joined **/
+	statement->tables.emplace_back();
+	if (!keyword("from") || !tableRef(statement->tables.back()))
+		return nullptr;
+	while (joinType(join)) {
+		statement->tables.emplace_back();
+		TableRef &table = statement->tables.back(); ///Joined table
+		if (!tableRef(table))
+			return nullptr;
+		table.join = join;
+		if (join != TableRef::CROSS_JOIN) {
+			if (!keyword("on"))
+				return nullptr;
+			table.on = expression();
+			if (!table.on)
+				return nullptr;
+		}
+	}
+
+	/** Expression of the WHERE clause **/
+	if (keyword("where")) {
+		statement->where = expression();
+		if (!statement->where)
+			return nullptr;
+	}
+	if (keyword("group")) {
+		if (!keyword("by"))
+			return nullptr;
+		do {
+			if (!identifier(column) || (symbol(".") && !identifier(column)))
+				return nullptr;
+			statement->groupBy.push_back(column);
+		} while (symbol(","));
+	}
+	if (keyword("order")) {
+		if (!keyword("by"))
+			return nullptr;
+		do {
+			statement->orderBy.emplace_back();
+			if (!selectItem(statement->orderBy.back().item))
+				return nullptr;
+			if (keyword("desc"))
+				statement->orderBy.back().descending = true;
+			else
+				keyword("asc");
+		} while (symbol(","));
+	}
+	if (keyword("limit")) {
+		unsigned long long limit; ///Most rows listed as written
+		if (current.type != Token::NUMBER || !wholeNumber(current.text, SelectStatement::NO_LIMIT, limit))
+			return nullptr;
+		statement->limit = limit;
+		advance();
+	}
+	if (keyword("into") && (!keyword("outfile") || !fileOptions(statement->outfile)))
+		return nullptr;
+	if (!end())
+		return nullptr;
+	return move(statement);
+}
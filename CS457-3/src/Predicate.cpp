@@ -0,0 +1,462 @@
+/*!
+ * \file Predicate.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Predicate class. An expression is
+ * bound into a flat list of nodes, each placed after its operands, and is
+ * evaluated by walking the list from the top node with short circuits for
+ * AND and OR. A comparison reading a slot with no row, the unmatched side
+ * of an outer join, does not hold.
+ *
+ */
+
+#include <algorithm>
+#include <strings.h>
+
+#include "../include/Filter.h"
+#include "../include/Predicate.h"
+#include "../include/RowCursor.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the Predicate class
+ *
+ */
+Predicate::Predicate() {
+	root = 0;
+}
+/*!
+ * \brief Deconstructor of the Predicate class
+ *
+ * This function will deconstruct the Predicate class. This currently has
+ * no effect on the class.
+ *
+ */
+Predicate::~Predicate() {
+
+}
+/*!
+ * \brief Read an operator
+ *
+ * \param[in] string text
+ *            Operator as written, "=", "!=", "<", "<=", ">" or ">="
+ * \param[out] Op op
+ *             Operator read
+ * \return boolean true if the operator is known
+ */
+bool Predicate::parseOp(const string &text, Op &op) {
+	if (text == "=")
+		op = EQUAL;
+	else if (text == "!=")
+		op = NOT_EQUAL;
+	else if (text == "<")
+		op = LESS;
+	else if (text == "<=")
+		op = LESS_EQUAL;
+	else if (text == ">")
+		op = GREATER;
+	else if (text == ">=")
+		op = GREATER_EQUAL;
+	else
+		return false;
+	return true;
+}
+/*!
+ * \brief Write an operator
+ *
+ * \param[in] Op op
+ *            Operator to write
+ * \return const char * operator as written in a statement
+ */
+const char *Predicate::opName(Op op) {
+	static const char *names[] = {"=", "!=", "<", "<=", ">", ">="}; ///Text of each operator
+	return names[op];
+}
+/*!
+ * \brief Check an operator against an order
+ *
+ * \param[in] Op op
+ *            Operator of the comparison
+ * \param[in] int compared
+ *            Negative, zero or positive as the left side is below, equal to or above the right
+ * \return boolean true if the comparison holds
+ */
+bool Predicate::holds(Op op, int compared) {
+	switch (op) {
+	case EQUAL:
+		return compared == 0;
+	case NOT_EQUAL:
+		return compared != 0;
+	case LESS:
+		return compared < 0;
+	case LESS_EQUAL:
+		return compared <= 0;
+	case GREATER:
+		return compared > 0;
+	case GREATER_EQUAL:
+		return compared >= 0;
+	}
+	return false;
+}
+/*!
+ * \brief Bind an expression to the columns of its tables
+ *
+ * This function will find every column the expression names and parse
+ * every literal for the column it is compared with.
+ *
+ * \param[in] Expression expression
+ *            Syntax tree of the expression
+ * \param[in] vector<Source> sources
+ *            Tables the expression reads, in slot order
+ * \return boolean false if a column is unknown, a literal is not valid
+ *         for its column or two literals are compared
+ */
+bool Predicate::bind(const Expression &expression, const vector<Source> &sources) {
+	nodes.clear();
+	return bindNode(expression, sources, root);
+}
+/*!
+ * \brief Bind the AND of expressions
+ *
+ * This function will bind every expression and join them with AND nodes,
+ * so conditions taken from different clauses are tested as one. No
+ * expression gives an empty predicate, which every row passes.
+ *
+ * \param[in] vector<const Expression *> expressions
+ *            Syntax trees of the expressions
+ * \param[in] vector<Source> sources
+ *            Tables the expressions read, in slot order
+ * \return boolean false if an expression could not be bound
+ */
+bool Predicate::bind(const vector<const Expression *> &expressions, const vector<Source> &sources) {
+	nodes.clear();
+	root = 0;
+	for (size_t i = 0; i < expressions.size(); i++) {
+		Node node; ///AND of the expressions so far and this one
+		node.kind = Expression::AND;
+		node.left = root;
+		if (!bindNode(*expressions[i], sources, node.right))
+			return false;
+		if (i == 0)
+			root = node.right;
+		else {
+			root = nodes.size();
+			nodes.push_back(node);
+		}
+	}
+	return true;
+}
+/*!
+ * \brief Bind a node of the expression
+ *
+ * A literal on the left of a comparison is moved to the right with the
+ * operator turned around, so a bound comparison always starts with a
+ * column.
+ *
+ * \param[in] Expression expression
+ *            Node of the syntax tree
+ * \param[in] vector<Source> sources
+ *            Tables the expression reads, in slot order
+ * \param[out] size_t position
+ *             Position of the bound node
+ * \return boolean true if the node and its operands were bound
+ */
+bool Predicate::bindNode(const Expression &expression, const vector<Source> &sources, size_t &position) {
+	Node node; ///Node being bound
+
+	node.kind = expression.kind;
+	if (expression.kind != Expression::COMPARE) {
+		if (!bindNode(*expression.left, sources, node.left))
+			return false;
+		if (expression.kind != Expression::NOT && !bindNode(*expression.right, sources, node.right))
+			return false;
+	}
+	else {
+		const Operand *first = &expression.compare.left; ///Side holding a column
+		const Operand *second = &expression.compare.right; ///Other side
+		if (!parseOp(expression.compare.op, node.op))
+			return false;
+		if (!first->isColumn) {
+			if (!second->isColumn)
+				return false;
+			swap(first, second);
+			if (node.op == LESS || node.op == GREATER)
+				node.op = node.op == LESS ? GREATER : LESS;
+			else if (node.op == LESS_EQUAL || node.op == GREATER_EQUAL)
+				node.op = node.op == LESS_EQUAL ? GREATER_EQUAL : LESS_EQUAL;
+		}
+		if (!resolve(*first, sources, node.slot, node.col))
+			return false;
+		node.column = &(*sources[node.slot].columns)[node.col];
+		if (second->isColumn) {
+			if (!resolve(*second, sources, node.otherSlot, node.otherCol))
+				return false;
+			/** Two unqualified columns found in one table compare it with a later table if they can **/
+			if (first->table.empty() && second->table.empty() && node.otherSlot == node.slot)
+				resolve(*second, sources, node.otherSlot, node.otherCol, node.slot + 1);
+			node.againstColumn = true;
+			node.other = &(*sources[node.otherSlot].columns)[node.otherCol];
+		}
+		else if (!node.column->parse(second->text, node.value))
+			return false;
+	}
+	position = nodes.size();
+	nodes.push_back(node);
+	return true;
+}
+/*!
+ * \brief Find the column an operand names
+ *
+ * A qualified column belongs to the table with that alias or name. An
+ * unqualified column belongs to the first table that has it.
+ *
+ * \param[in] Operand side
+ *            Column operand
+ * \param[in] vector<Source> sources
+ *            Tables the expression reads, in slot order
+ * \param[out] size_t slot
+ *             Slot of the table holding the column
+ * \param[out] size_t col
+ *             Position of the column in its table
+ * \param[in] size_t from
+ *            First slot searched
+ * \return boolean true if the column was found, leaving slot and col unchanged otherwise
+ */
+bool Predicate::resolve(const Operand &side, const vector<Source> &sources, size_t &slot, size_t &col,
+	size_t from) const {
+	for (size_t i = from; i < sources.size(); i++) {
+		const Source &source = sources[i]; ///Table being searched
+		if (!side.table.empty() && side.table != source.alias &&
+			strcasecmp(side.table.c_str(), source.name.c_str()) != 0)
+			continue;
+		for (size_t j = 0; j < source.columns->size(); j++) {
+			if ((*source.columns)[j].colName == side.text) {
+				slot = i;
+				col = j;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+/*!
+ * \brief Test the current row of every slot
+ *
+ * \param[in] const size_t *rows
+ *            Current row of each slot
+ * \return boolean true if the expression holds
+ */
+bool Predicate::test(const size_t *rows) const {
+	return nodes.empty() || evaluate(root, rows);
+}
+/*!
+ * \brief Evaluate a node
+ *
+ * \param[in] size_t position
+ *            Position of the node
+ * \param[in] const size_t *rows
+ *            Current row of each slot
+ * \return boolean true if the node holds
+ */
+bool Predicate::evaluate(size_t position, const size_t *rows) const {
+	const Node &node = nodes[position]; ///Node being evaluated
+
+	switch (node.kind) {
+	case Expression::AND:
+		return evaluate(node.left, rows) && evaluate(node.right, rows);
+	case Expression::OR:
+		return evaluate(node.left, rows) || evaluate(node.right, rows);
+	case Expression::NOT:
+		return !evaluate(node.left, rows);
+	case Expression::COMPARE:
+		break;
+	}
+	if (rows[node.slot] == RowCursor::NO_ROW || (node.againstColumn && rows[node.otherSlot] == RowCursor::NO_ROW))
+		return false;
+	if (node.againstColumn)
+		return holds(node.op, node.column->compareRows(rows[node.slot], *node.other, rows[node.otherSlot]));
+	return holds(node.op, node.column->compare(rows[node.slot], node.value));
+}
+/*!
+ * \brief Find the matching rows of a single table
+ *
+ * This function will evaluate the expression over batches of rows. Every
+ * node is placed after its operands, so the nodes are evaluated in order,
+ * each comparison filling its bitmap with a Filter kernel and each AND,
+ * OR and NOT combining the bitmaps of its operands a word at a time.
+ *
+ * \param[in] size_t rowCount
+ *            Number of rows in the table
+ * \param[out] vector<size_t> rows
+ *             Rows the expression holds for in ascending order
+ * \param[in] size_t limit
+ *            Most rows found, the scan stops at the batch reaching it
+ */
+void Predicate::select(size_t rowCount, vector<size_t> &rows, size_t limit) const {
+	vector<uint64_t> bits(nodes.size() * Filter::BATCH_WORDS); ///Bitmap of each node for the batch
+
+	for (size_t first = 0; first < rowCount && rows.size() < limit; first += Filter::BATCH_ROWS) {
+		size_t count = min(Filter::BATCH_ROWS, rowCount - first); ///Rows in the batch
+		size_t words = (count + 63) / 64; ///Bitmap words in the batch
+		for (size_t position = 0; position < nodes.size(); position++) {
+			const Node &node = nodes[position]; ///Node being evaluated
+			uint64_t *out = &bits[position * Filter::BATCH_WORDS]; ///Bitmap of the node
+			const uint64_t *left = &bits[node.left * Filter::BATCH_WORDS]; ///Bitmap of the first operand
+			const uint64_t *right = &bits[node.right * Filter::BATCH_WORDS]; ///Bitmap of the second operand
+			switch (node.kind) {
+			case Expression::AND:
+				for (size_t word = 0; word < words; word++)
+					out[word] = left[word] & right[word];
+				break;
+			case Expression::OR:
+				for (size_t word = 0; word < words; word++)
+					out[word] = left[word] | right[word];
+				break;
+			case Expression::NOT:
+				for (size_t word = 0; word < words; word++)
+					out[word] = ~left[word];
+				break;
+			case Expression::COMPARE:
+				if (node.againstColumn)
+					Filter::compareRows(*node.column, *node.other, first, count, node.op, out);
+				else
+					Filter::compare(*node.column, first, count, node.op, node.value, out);
+				break;
+			}
+		}
+		Filter::appendRows(&bits[root * Filter::BATCH_WORDS], first, count, rows);
+	}
+	if (rows.size() > limit)
+		rows.resize(limit);
+}
+/*!
+ * \brief Check if the expression is one comparison
+ *
+ * \return boolean true if the expression has no AND, OR or NOT
+ */
+bool Predicate::single() const {
+	return !nodes.empty() && nodes[root].kind == Expression::COMPARE;
+}
+/*!
+ * \brief Check if the predicate has no expression
+ *
+ * \return boolean true if every row passes
+ */
+bool Predicate::empty() const {
+	return nodes.empty();
+}
+/*!
+ * \brief List the slots the expression reads
+ *
+ * \return vector<size_t> slots of the compared columns in ascending order
+ */
+vector<size_t> Predicate::slots() const {
+	vector<size_t> found; ///Slots of the compared columns
+
+	for (const Node &node: nodes) {
+		if (node.kind != Expression::COMPARE)
+			continue;
+		found.push_back(node.slot);
+		if (node.againstColumn)
+			found.push_back(node.otherSlot);
+	}
+	sort(found.begin(), found.end());
+	found.erase(unique(found.begin(), found.end()), found.end());
+	return found;
+}
+/*!
+ * \brief List the comparisons joined by AND at the top of the expression
+ *
+ * Every row the expression holds for passes each of these comparisons.
+ *
+ * \param[in] size_t position
+ *            Position of the node
+ * \param[out] vector<size_t> found
+ *             Positions of the comparisons
+ */
+void Predicate::conjuncts(size_t position, vector<size_t> &found) const {
+	const Node &node = nodes[position]; ///Node being searched
+
+	if (node.kind == Expression::AND) {
+		conjuncts(node.left, found);
+		conjuncts(node.right, found);
+	}
+	else if (node.kind == Expression::COMPARE)
+		found.push_back(position);
+}
+/*!
+ * \brief Find a column to look up the matching rows of a table
+ *
+ * This function will find a comparison of a column with a literal that
+ * every matching row passes, preferring an equality. The rows passing it
+ * are a superset of the matching rows and can be found through an index.
+ *
+ * \param[out] size_t col
+ *             Position of the column
+ * \param[out] Op op
+ *             Operator of the comparison
+ * \param[out] const Value *value
+ *             Literal parsed for the column
+ * \return boolean true if such a comparison was found
+ */
+bool Predicate::keyCondition(size_t &col, Op &op, const Value *&value) const {
+	vector<size_t> found; ///Comparisons every matching row passes
+	const Node *key = nullptr; ///Comparison picked
+
+	conjuncts(root, found);
+	for (size_t position: found) {
+		const Node &node = nodes[position]; ///Comparison being looked at
+		if (node.againstColumn || node.slot != 0)
+			continue;
+		if (key == nullptr || (node.op == EQUAL && key->op != EQUAL))
+			key = &node;
+	}
+	if (key == nullptr)
+		return false;
+	col = key->col;
+	op = key->op;
+	value = &key->value;
+	return true;
+}
+/*!
+ * \brief Find an equality between a column of a slot and another slot
+ *
+ * This function will find a comparison of a column of the slot and a
+ * column of another slot for equality that every matching row passes, so
+ * the rows can be found with a hash join on the two columns.
+ *
+ * \param[in] size_t slot
+ *            Slot of the table joined
+ * \param[out] size_t col
+ *             Position of the column in the table of the slot
+ * \param[out] size_t otherSlot
+ *             Slot of the other table
+ * \param[out] size_t otherCol
+ *             Position of the column in the other table
+ * \return boolean true if such a comparison was found
+ */
+bool Predicate::joinKey(size_t slot, size_t &col, size_t &otherSlot, size_t &otherCol) const {
+	vector<size_t> found; ///Comparisons every matching row passes
+
+	if (nodes.empty())
+		return false;
+	conjuncts(root, found);
+	for (size_t position: found) {
+		const Node &node = nodes[position]; ///Comparison being looked at
+		if (!node.againstColumn || node.op != EQUAL || node.slot == node.otherSlot
+			|| (node.slot != slot && node.otherSlot != slot))
+			continue;
+		bool first = node.slot == slot; ///Bool if the slot holds the first column
+		col = first ? node.col : node.otherCol;
+		otherSlot = first ? node.otherSlot : node.slot;
+		otherCol = first ? node.otherCol : node.col;
+		return true;
+	}
+	return false;
+}
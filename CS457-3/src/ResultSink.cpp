@@ -0,0 +1,230 @@
+/*!
+ * \file ResultSink.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the ResultSink class and its output
+ * formats. Every query result is written through a sink so the formatting
+ * of headers and rows lives in one place.
+ *
+ */
+
+#include "../include/ResultSink.h"
+
+///std name space for general use
+using namespace std;
+
+/// Definition of the size the buffer may reach before it is written
+const size_t ResultSink::FLUSH_BYTES;
+/// Definition of the size the buffer of a file export may reach
+const size_t ResultSink::FILE_FLUSH_BYTES;
+/// Magic bytes at the start of every binary export
+static const char ROW_MAGIC[8] = {'C', 'S', '4', '5', '7', 'R', 'O', 'W'};
+/// Version of the binary export format written by this program
+static const uint32_t ROW_VERSION = 1;
+
+/*!
+ * \brief Constructor of the ResultSink class
+ *
+ * \param[out] ostream out
+ *             Stream the result is written to
+ * \param[in] size_t newFlushBytes
+ *            Size the buffer may reach before it is written
+ */
+ResultSink::ResultSink(ostream &out, size_t newFlushBytes) : output(out) {
+	rowNum = 0;
+	flushBytes = newFlushBytes;
+	buffer.reserve(flushBytes + 1024);
+}
+/*!
+ * \brief Deconstructor of the ResultSink class
+ *
+ * This function will write out anything left in the buffer.
+ *
+ */
+ResultSink::~ResultSink() {
+	finish();
+}
+/*!
+ * \brief Write out the buffer at the end of a result
+ *
+ * This function will write the buffer to the stream and flush the stream,
+ * so the result is out before the next statement runs.
+ *
+ */
+void ResultSink::finish() {
+	output.write(buffer.data(), buffer.size());
+	buffer.clear();
+	output.flush();
+}
+/*!
+ * \brief Write out a full buffer
+ *
+ * This function will write the buffer to the stream once it passes the
+ * flush size, keeping its memory for the next rows.
+ *
+ */
+void ResultSink::spill() {
+	if (buffer.size() >= flushBytes) {
+		output.write(buffer.data(), buffer.size());
+		buffer.clear();
+	}
+}
+/*!
+ * \brief Constructor of the TextSink class
+ *
+ * \param[out] ostream out
+ *             Stream the result is written to
+ */
+TextSink::TextSink(ostream &out) : ResultSink(out) {
+
+}
+/*!
+ * \brief Write the projected columns
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor holding the projection of the result
+ */
+void TextSink::writeHeader(const RowCursor &cursor) {
+	for (size_t i = 0; i < cursor.width(); i++) {
+		const Column &headerColumn = cursor.column(i); ///Column named in the header
+		if (i != 0) ///Do not print dividers if first input
+			buffer += '|';
+		buffer += headerColumn.colName;
+		buffer += ' ';
+		buffer += headerColumn.colType;
+		/** If char print the column size **/
+		if (headerColumn.isChar())
+			buffer += '(' + to_string(headerColumn.colSize) + ')';
+	}
+	buffer += '\n';
+	spill();
+}
+/*!
+ * \brief Write the current row
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor positioned on the row
+ */
+void TextSink::writeRow(RowCursor &cursor) {
+	for (size_t i = 0; i < cursor.width(); i++) {
+		if (i != 0) ///Do not print dividers if first input
+			buffer += '|';
+		experimental::string_view printed = cursor.value(i); ///View of the value
+		buffer.append(printed.data(), printed.size());
+	}
+	buffer += '\n';
+	rowNum++;
+	spill();
+}
+/*!
+ * \brief Constructor of the CsvSink class
+ *
+ * \param[out] ostream out
+ *             Stream the result is written to
+ * \param[in] char newDelimiter
+ *            Character separating the values
+ */
+CsvSink::CsvSink(ostream &out, char newDelimiter) : ResultSink(out, FILE_FLUSH_BYTES) {
+	delimiter = newDelimiter;
+}
+/*!
+ * \brief Write the projected columns
+ *
+ * A delimited file has no header, so nothing is written.
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor holding the projection of the result
+ */
+void CsvSink::writeHeader(const RowCursor &cursor) {
+
+}
+/*!
+ * \brief Write the current row
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor positioned on the row
+ */
+void CsvSink::writeRow(RowCursor &cursor) {
+	for (size_t i = 0; i < cursor.width(); i++) {
+		if (i != 0)
+			buffer += delimiter;
+		experimental::string_view printed = cursor.value(i); ///View of the value
+		/** Quote a char value that would be split or cut when read back **/
+		if (cursor.column(i).isChar() && (printed.find(delimiter) != experimental::string_view::npos ||
+			printed.find_first_of("\"\r\n") != experimental::string_view::npos)) {
+			buffer += '"';
+			for (char printedChar: printed) {
+				if (printedChar == '"')
+					buffer += '"';
+				buffer += printedChar;
+			}
+			buffer += '"';
+		}
+		else
+			buffer.append(printed.data(), printed.size());
+	}
+	buffer += '\n';
+	rowNum++;
+	spill();
+}
+/*!
+ * \brief Constructor of the BinarySink class
+ *
+ * \param[out] ostream out
+ *             Stream the result is written to
+ */
+BinarySink::BinarySink(ostream &out) : ResultSink(out, FILE_FLUSH_BYTES) {
+
+}
+/*!
+ * \brief Write the projected columns
+ *
+ * This function will write the magic bytes, version and schema of the
+ * result.
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor holding the projection of the result
+ */
+void BinarySink::writeHeader(const RowCursor &cursor) {
+	uint32_t colNum = cursor.width(); ///Number of columns in the result
+
+	buffer.append(ROW_MAGIC, sizeof(ROW_MAGIC));
+	buffer.append(reinterpret_cast<const char *>(&ROW_VERSION), sizeof(ROW_VERSION));
+	buffer.append(reinterpret_cast<const char *>(&colNum), sizeof(colNum));
+	for (size_t i = 0; i < cursor.width(); i++) {
+		const Column &headerColumn = cursor.column(i); ///Column named in the header
+		uint32_t length = headerColumn.colName.size(); ///Length of a schema string
+		int32_t size = headerColumn.colSize; ///Size of the column
+		buffer.append(reinterpret_cast<const char *>(&length), sizeof(length));
+		buffer += headerColumn.colName;
+		length = headerColumn.colType.size();
+		buffer.append(reinterpret_cast<const char *>(&length), sizeof(length));
+		buffer += headerColumn.colType;
+		buffer.append(reinterpret_cast<const char *>(&size), sizeof(size));
+	}
+	spill();
+}
+/*!
+ * \brief Write the current row
+ *
+ * A column of a table with no matching row is written as a zero or an
+ * empty char value.
+ *
+ * \param[in] RowCursor cursor
+ *            Cursor positioned on the row
+ */
+void BinarySink::writeRow(RowCursor &cursor) {
+	for (size_t i = 0; i < cursor.width(); i++) {
+		size_t row = cursor.row(i); ///Row the value is read from
+		if (row != RowCursor::NO_ROW)
+			cursor.column(i).encode(row, buffer);
+		else
+			buffer.append(cursor.column(i).layout == Column::FLOAT_LAYOUT ? sizeof(double) : sizeof(uint32_t), '\0');
+	}
+	rowNum++;
+	spill();
+}
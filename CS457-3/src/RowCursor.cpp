@@ -0,0 +1,125 @@
+/*!
+ * \file RowCursor.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the RowCursor class. The cursor is used
+ * by selects and joins to print result rows straight from the column data.
+ *
+ */
+
+#include "../include/RowCursor.h"
+
+///std name space for general use
+using namespace std;
+
+/// Definition of the row used for a table with no matching row
+const size_t RowCursor::NO_ROW;
+
+/*!
+ * \brief Constructor of the RowCursor class
+ *
+ * This function will construct a cursor over the given number of tables
+ * with an empty projection. Every table starts without a row.
+ *
+ * \param[in] size_t slots
+ *            Number of tables the projected columns come from
+ */
+RowCursor::RowCursor(size_t slots) {
+	rows.assign(slots, NO_ROW);
+}
+/*!
+ * \brief Deconstructor of the RowCursor class
+ *
+ * This function will deconstruct the RowCursor class. This currently has no
+ * effect on the class.
+ *
+ */
+RowCursor::~RowCursor() {
+
+}
+/*!
+ * \brief Add a column to the projection
+ *
+ * \param[in] Column column
+ *            Column to add, which must outlive the cursor
+ * \param[in] size_t slot
+ *            Table slot the column belongs to
+ */
+void RowCursor::project(const Column &column, size_t slot) {
+	columns.push_back(&column);
+	slotOf.push_back(slot);
+}
+/*!
+ * \brief Add every column of a table to the projection
+ *
+ * \param[in] vector<Column> columns
+ *            Columns of the table in order
+ * \param[in] size_t slot
+ *            Table slot the columns belong to
+ */
+void RowCursor::projectAll(const vector<Column> &tableColumns, size_t slot) {
+	for (const Column &tableColumn: tableColumns)
+		project(tableColumn, slot);
+}
+/*!
+ * \brief Move a table to a row
+ *
+ * \param[in] size_t slot
+ *            Table slot to move
+ * \param[in] size_t row
+ *            Row to move to, or NO_ROW for an unmatched table
+ */
+void RowCursor::seek(size_t slot, size_t row) {
+	rows[slot] = row;
+}
+/*!
+ * \brief Number of projected columns
+ *
+ * \return size_t number of columns in a result row
+ */
+size_t RowCursor::width() const {
+	return columns.size();
+}
+/*!
+ * \brief Projected column
+ *
+ * \param[in] size_t index
+ *            Position of the column in the projection
+ * \return Column reference to the projected column
+ */
+const Column &RowCursor::column(size_t index) const {
+	return *columns[index];
+}
+/*!
+ * \brief Current row of a projected column
+ *
+ * \param[in] size_t index
+ *            Position of the column in the projection
+ * \return size_t row the column is read from, NO_ROW if its table has none
+ */
+size_t RowCursor::row(size_t index) const {
+	return rows[slotOf[index]];
+}
+/*!
+ * \brief Projected value of the current row
+ *
+ * This function will give a view of a projected value. Char values are
+ * viewed in place and numbers are formatted into the cursor buffer, so the
+ * view is valid until the next call. A table without a row gives an empty
+ * value.
+ *
+ * \param[in] size_t index
+ *            Position of the column in the projection
+ * \return string_view of the printed value
+ */
+experimental::string_view RowCursor::value(size_t index) {
+	size_t row = rows[slotOf[index]]; ///Current row of the column's table
+
+	if (row == NO_ROW)
+		return experimental::string_view();
+	return columns[index]->format(row, buffer);
+}
@@ -0,0 +1,356 @@
+/*!
+ * \file Server.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Server class. The class accepts the
+ * clients of a Unix domain socket and runs a session for each of them on
+ * a pool of worker threads. It also holds the small client that sends the
+ * input of the program to a server and prints what comes back.
+ *
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../include/Server.h"
+
+///std name space for general use
+using namespace std;
+
+/// Pipe written by the signal handler to wake the server
+int Server::wakeup[2] = {-1, -1};
+
+/*!
+ * \brief Function to fill in the address of a socket path
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the socket
+ * \param[out] sockaddr_un address
+ *             Address of the socket
+ * \return boolean false if the path is too long for a socket address
+ */
+static bool socketAddress(const string &path, sockaddr_un &address) {
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path.empty() || path.size() >= sizeof(address.sun_path))
+		return false;
+	memcpy(address.sun_path, path.c_str(), path.size());
+	return true;
+}
+/*!
+ * \brief Constructor of the Connection class
+ *
+ * \param[in] int newSocket
+ *            Connected socket the stream reads and writes
+ */
+Server::Connection::Connection(int newSocket) : socket(newSocket), input(BUFFER_BYTES), output(BUFFER_BYTES) {
+	setg(input.data(), input.data(), input.data());
+	setp(output.data(), output.data() + output.size());
+}
+/*!
+ * \brief Receive more input
+ *
+ * This function will wait for the client to send more bytes. The end of
+ * the input is reached once the client closes its side of the connection.
+ *
+ * \return int_type next byte of the input, or the end of the file
+ */
+Server::Connection::int_type Server::Connection::underflow() {
+	ssize_t received; ///Number of bytes received
+
+	do
+		received = recv(socket, input.data(), input.size(), 0);
+	while (received < 0 && errno == EINTR);
+	if (received <= 0)
+		return traits_type::eof();
+	setg(input.data(), input.data(), input.data() + received);
+	return traits_type::to_int_type(*gptr());
+}
+/*!
+ * \brief Send a full output buffer
+ *
+ * \param[in] int_type c
+ *            Byte that did not fit in the buffer, or the end of the file
+ * \return int_type the byte written, or the end of the file on failure
+ */
+Server::Connection::int_type Server::Connection::overflow(int_type c) {
+	if (sync() != 0)
+		return traits_type::eof();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+/*!
+ * \brief Send the buffered output
+ *
+ * \return int 0 once the output is sent, -1 if the client went away
+ */
+int Server::Connection::sync() {
+	bool sent = sendAll(socket, pbase(), pptr() - pbase()); ///Bool if the bytes were sent
+
+	setp(output.data(), output.data() + output.size());
+	return sent ? 0 : -1;
+}
+/*!
+ * \brief Count the input waiting on the socket
+ *
+ * The statement reader uses the count to tell whether the client has sent
+ * more statements, so the logged changes are only committed once it has
+ * not.
+ *
+ * \return streamsize number of bytes that can be read without waiting
+ */
+streamsize Server::Connection::showmanyc() {
+	int waitingBytes = 0; ///Number of bytes waiting on the socket
+
+	if (ioctl(socket, FIONREAD, &waitingBytes) != 0 || waitingBytes <= 0)
+		return 0;
+	return waitingBytes;
+}
+/*!
+ * \brief Constructor of the Server class
+ *
+ * \param[in] string newPath
+ *            String corresponding to the path of the socket
+ * \param[in] size_t newThreads
+ *            Number of sessions served at once
+ * \param[in] Session newSession
+ *            Function running a session on the streams of a client
+ */
+Server::Server(string newPath, size_t newThreads, Session newSession) {
+	path = newPath;
+	threads = newThreads;
+	session = newSession;
+	listener = -1;
+	stopping = false;
+}
+/*!
+ * \brief Deconstructor of the Server class
+ *
+ * This function will close the socket if it is still open.
+ *
+ */
+Server::~Server() {
+	if (listener >= 0)
+		close(listener);
+}
+/*!
+ * \brief Serve clients until the server is stopped
+ *
+ * This function will listen on the socket path, replacing a socket left
+ * by an earlier server, and queue every client that connects for the
+ * workers. Once SIGINT or SIGTERM arrives the socket is removed, the
+ * waiting clients are dropped and the running sessions read no further
+ * statements. The function returns after every worker has finished.
+ *
+ * \return int exit status of the program
+ */
+int Server::run() {
+	sockaddr_un address; ///Address of the socket
+	struct sigaction action; ///Handler of the stopping signals
+
+	/** Listen on the socket path **/
+	if (!socketAddress(path, address)) {
+		cerr << "!Failed to listen on " << path << " because the path is too long." << endl;
+		return 1;
+	}
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(path.c_str());
+	if (listener < 0 || bind(listener, (sockaddr *)&address, sizeof(address)) != 0
+		|| listen(listener, SOMAXCONN) != 0 || pipe(wakeup) != 0) {
+		cerr << "!Failed to listen on " << path << " because " << strerror(errno) << '.' << endl;
+		return 1;
+	}
+
+	/** Stop on SIGINT or SIGTERM, and survive clients that go away **/
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = stop;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+	signal(SIGPIPE, SIG_IGN);
+
+	for (size_t i = 0; i < threads; i++)
+		workers.emplace_back(&Server::work, this);
+	cerr << "Listening on " << path << " with " << threads << " threads." << endl;
+
+	/** Accept clients until woken by a signal **/
+	while (true) {
+		pollfd watched[2] = {{listener, POLLIN, 0}, {wakeup[0], POLLIN, 0}}; ///Sockets waited on
+		if (poll(watched, 2, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		if (watched[1].revents != 0)
+			break;
+		if (watched[0].revents != 0) {
+			int client = accept(listener, nullptr, nullptr); ///Socket of the client
+			if (client < 0)
+				continue;
+			lock_guard<mutex> guard(latch); ///Latch held while the queue is changed
+			queue.push_back(client);
+			waiting.notify_one();
+		}
+	}
+
+	/** Stop reading from the clients and wait for the workers **/
+	close(listener);
+	listener = -1;
+	unlink(path.c_str());
+	{
+		lock_guard<mutex> guard(latch); ///Latch held while the sessions are stopped
+		stopping = true;
+		for (int client: queue)
+			close(client);
+		queue.clear();
+		for (int client: sessions)
+			shutdown(client, SHUT_RD);
+		waiting.notify_all();
+	}
+	for (thread &worker: workers)
+		worker.join();
+	workers.clear();
+	close(wakeup[0]);
+	close(wakeup[1]);
+	cerr << "Server stopped." << endl;
+	return 0;
+}
+/*!
+ * \brief Function run by each worker thread
+ *
+ * This function will take the next queued client and run its session,
+ * closing the connection once the session ends, until the server stops.
+ *
+ */
+void Server::work() {
+	while (true) {
+		int client; ///Socket of the client served
+		{
+			unique_lock<mutex> guard(latch); ///Latch held while the queue is read
+			waiting.wait(guard, [this] { return stopping || !queue.empty(); });
+			if (queue.empty())
+				return;
+			client = queue.front();
+			queue.pop_front();
+			sessions.insert(client);
+		}
+
+		/** Run the session on the streams of the connection **/
+		Connection connection(client); ///Stream buffer of the client
+		istream in(&connection); ///Statements sent by the client
+		ostream out(&connection); ///Results sent to the client
+		session(in, out);
+		out.flush();
+
+		lock_guard<mutex> guard(latch); ///Latch held while the session is removed
+		sessions.erase(client);
+		close(client);
+	}
+}
+/*!
+ * \brief Send a whole buffer
+ *
+ * \param[in] int socket
+ *            Connected socket
+ * \param[in] const char *data
+ *            Bytes to send
+ * \param[in] size_t length
+ *            Number of bytes to send
+ * \return boolean false if the other side went away
+ */
+bool Server::sendAll(int socket, const char *data, size_t length) {
+	while (length > 0) {
+		ssize_t sent = send(socket, data, length, MSG_NOSIGNAL); ///Number of bytes sent
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+			return false;
+		data += sent;
+		length -= sent;
+	}
+	return true;
+}
+/*!
+ * \brief Function handling the signals stopping the server
+ *
+ * Only a write to the wakeup pipe is safe inside a signal handler, so the
+ * server is stopped by the loop it wakes.
+ *
+ * \param[in] int signal
+ *            Signal received
+ */
+void Server::stop(int signal) {
+	char byte = (char)signal; ///Byte written to the pipe
+	int saved = errno; ///Errno of the interrupted code
+
+	if (write(wakeup[1], &byte, 1) < 0) {}
+	errno = saved;
+}
+/*!
+ * \brief Run as a client of a server
+ *
+ * This function will connect to the socket of a server and send it the
+ * standard input, printing the results the server sends back. Once the
+ * input ends the client closes its side of the connection, and it returns
+ * once the server has sent the results of the last statement.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the socket
+ * \return int exit status of the program
+ */
+int Server::connect(const string &path) {
+	sockaddr_un address; ///Address of the socket
+	int server = socket(AF_UNIX, SOCK_STREAM, 0); ///Socket connected to the server
+	char buffer[Connection::BUFFER_BYTES]; ///Bytes received from the server
+	ssize_t received; ///Number of bytes received
+
+	if (!socketAddress(path, address) || server < 0
+		|| ::connect(server, (sockaddr *)&address, sizeof(address)) != 0) {
+		cerr << "!Failed to connect to " << path << " because " << strerror(errno) << '.' << endl;
+		if (server >= 0)
+			close(server);
+		return 1;
+	}
+
+	/** Send the input from its own thread while the results are printed **/
+	thread sender([server] {
+		char input[Connection::BUFFER_BYTES]; ///Bytes read from the input
+		ssize_t length; ///Number of bytes read
+		while ((length = read(STDIN_FILENO, input, sizeof(input))) > 0 || (length < 0 && errno == EINTR)) {
+			if (length > 0 && !sendAll(server, input, length))
+				break;
+		}
+		shutdown(server, SHUT_WR);
+	});
+	/** The sender may be waiting on input nobody will send once the server is gone **/
+	sender.detach();
+
+	/** Print the results until the server closes the connection **/
+	while ((received = recv(server, buffer, sizeof(buffer), 0)) != 0) {
+		if (received < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		for (ssize_t written = 0, length; written < received; written += length) {
+			length = write(STDOUT_FILENO, buffer + written, received - written);
+			if (length <= 0)
+				return 1;
+		}
+	}
+	close(server);
+	return 0;
+}
@@ -0,0 +1,295 @@
+/*!
+ * \file Sorter.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Sorter class. A key is built from
+ * the ordered columns in turn. Ints are stored big endian with the sign bit
+ * flipped, floats as their bits with the sign bit flipped or every bit
+ * flipped when negative, and char values as their bytes with each zero byte
+ * followed by 0xff and two zero bytes at the end, so no key of a column is
+ * the start of another and the next column cannot change the order.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+#include "../include/Sorter.h"
+
+///std name space for general use
+using namespace std;
+
+///Keys kept in memory before a run is spilled, changed with --sort-memory
+size_t Sorter::memoryBytes = 256 * 1024 * 1024;
+
+/** Size of the buffer of each run file **/
+static const size_t RUN_BUFFER_BYTES = 64 * 1024;
+
+/*!
+ * \brief Constructor of the Sorter class
+ */
+Sorter::Sorter() {
+
+}
+/*!
+ * \brief Deconstructor of the Sorter class
+ *
+ * This function will deconstruct the Sorter class and remove any run left
+ * by a failed sort.
+ *
+ */
+Sorter::~Sorter() {
+	closeRuns();
+}
+/*!
+ * \brief Check if a limit is kept in a heap
+ *
+ * \param[in] size_t limit
+ *            Most rows handed out
+ * \return boolean true if the pairs of that many rows fit in memory
+ */
+bool Sorter::bounded(size_t limit) {
+	return limit <= memoryBytes / (sizeof(Entry) + 16);
+}
+/*!
+ * \brief Order by a column
+ *
+ * Columns are compared in the order they are added.
+ *
+ * \param[in] Column column
+ *            Ordered column, which must outlive the sorter
+ * \param[in] bool newDescending
+ *            Bool if the highest values come first
+ */
+void Sorter::addKey(const Column &column, bool newDescending) {
+	columns.push_back(&column);
+	descending.push_back(newDescending);
+}
+/*!
+ * \brief Build the key of a row
+ *
+ * \param[in] size_t row
+ *            Row of the ordered columns
+ * \param[out] string key
+ *             Bytes whose order is the order of the row
+ */
+void Sorter::encode(size_t row, string &key) const {
+	key.clear();
+	for (size_t c = 0; c < columns.size(); c++) {
+		const Column &column = *columns[c]; ///Ordered column
+		size_t start = key.size(); ///Start of the key of the column
+		if (column.layout == Column::INT_LAYOUT) {
+			uint32_t bits = (uint32_t)column.getInt(row) ^ 0x80000000u; ///Value in unsigned order
+			for (int shift = 24; shift >= 0; shift -= 8)
+				key.push_back((char)(bits >> shift));
+		}
+		else if (column.layout == Column::FLOAT_LAYOUT) {
+			double value = column.getFloat(row) + 0.0; ///Value with negative zero made zero
+			uint64_t bits; ///Value in unsigned order
+			memcpy(&bits, &value, sizeof(bits));
+			bits = (bits >> 63) ? ~bits : bits ^ (1ull << 63);
+			for (int shift = 56; shift >= 0; shift -= 8)
+				key.push_back((char)(bits >> shift));
+		}
+		else {
+			for (char byte: column.getChars(row)) {
+				key.push_back(byte);
+				if (byte == '\0')
+					key.push_back((char)0xff);
+			}
+			key.append(2, '\0');
+		}
+		if (descending[c]) {
+			for (size_t i = start; i < key.size(); i++)
+				key[i] = ~key[i];
+		}
+	}
+}
+/*!
+ * \brief Hand out the rows in order
+ *
+ * This function will hand every row to emit in the order of the keys, up
+ * to a limit. A limit whose rows fit in memory keeps only the lowest rows
+ * in a heap. Otherwise the pairs are collected, spilling a sorted run each
+ * time they pass memoryBytes, and either sorted in memory or merged from
+ * the runs.
+ *
+ * \param[in] vector<size_t> *rows
+ *            Rows to order, null for rows 0 to count - 1
+ * \param[in] size_t count
+ *            Number of rows to order
+ * \param[in] size_t limit
+ *            Most rows handed out
+ * \param[in] function<void(size_t)> emit
+ *            Function given each row in order
+ * \return boolean false if a run could not be written or read
+ */
+bool Sorter::sort(const vector<size_t> *rows, size_t count, size_t limit, const function<void(size_t)> &emit) {
+	vector<Entry> entries; ///Pairs held in memory
+	size_t heldBytes = 0; ///Bytes of the pairs held in memory
+
+	if (limit == 0)
+		return true;
+	if (limit < count && bounded(limit)) {
+		top(rows, count, limit, emit);
+		return true;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		size_t row = rows != nullptr ? (*rows)[i] : i; ///Ordered row
+		entries.emplace_back(string(), row);
+		encode(row, entries.back().first);
+		heldBytes += sizeof(Entry) + entries.back().first.size();
+		if (heldBytes >= memoryBytes) {
+			if (!spill(entries))
+				return false;
+			heldBytes = 0;
+		}
+	}
+
+	/** Sort in memory when nothing was spilled **/
+	if (runs.empty()) {
+		std::sort(entries.begin(), entries.end());
+		for (size_t i = 0; i < entries.size() && i < limit; i++)
+			emit(entries[i].second);
+		return true;
+	}
+	if (!entries.empty() && !spill(entries))
+		return false;
+	return merge(limit, emit);
+}
+/*!
+ * \brief Hand out the lowest rows
+ *
+ * The heap holds the lowest rows found so far with the highest on top, so
+ * each later row only has to be compared with the top.
+ *
+ * \param[in] vector<size_t> *rows
+ *            Rows to order, null for rows 0 to count - 1
+ * \param[in] size_t count
+ *            Number of rows to order
+ * \param[in] size_t limit
+ *            Number of rows handed out, less than count
+ * \param[in] function<void(size_t)> emit
+ *            Function given each row in order
+ */
+void Sorter::top(const vector<size_t> *rows, size_t count, size_t limit, const function<void(size_t)> &emit) const {
+	vector<Entry> heap; ///Lowest rows so far, highest first
+	Entry entry; ///Pair of the row being ordered
+
+	heap.reserve(limit);
+	for (size_t i = 0; i < count; i++) {
+		entry.second = rows != nullptr ? (*rows)[i] : i;
+		encode(entry.second, entry.first);
+		if (heap.size() < limit) {
+			heap.push_back(entry);
+			push_heap(heap.begin(), heap.end());
+		}
+		else if (entry < heap.front()) {
+			pop_heap(heap.begin(), heap.end());
+			heap.back().swap(entry);
+			push_heap(heap.begin(), heap.end());
+		}
+	}
+	sort_heap(heap.begin(), heap.end());
+	for (const Entry &lowest: heap)
+		emit(lowest.second);
+}
+/*!
+ * \brief Write a sorted run
+ *
+ * Each pair is written as the length of the key, the key and the row.
+ *
+ * \param[in,out] vector<Entry> entries
+ *                Pairs to write, emptied once written
+ * \return boolean false if the temporary file could not be written
+ */
+bool Sorter::spill(vector<Entry> &entries) {
+	FILE *run = tmpfile(); ///File of the run, removed when closed
+
+	if (run == nullptr)
+		return false;
+	runs.push_back(run);
+	setvbuf(run, nullptr, _IOFBF, RUN_BUFFER_BYTES);
+	std::sort(entries.begin(), entries.end());
+	for (const Entry &entry: entries) {
+		uint32_t length = entry.first.size(); ///Bytes of the key
+		uint64_t row = entry.second; ///Row of the key
+		fwrite(&length, sizeof(length), 1, run);
+		fwrite(entry.first.data(), 1, length, run);
+		fwrite(&row, sizeof(row), 1, run);
+	}
+	entries.clear();
+	if (fflush(run) != 0 || ferror(run))
+		return false;
+	rewind(run);
+	return true;
+}
+/*!
+ * \brief Read the next pair of a run
+ *
+ * \param[in] FILE *run
+ *            Run being merged
+ * \param[out] Entry entry
+ *             Next pair of the run
+ * \return boolean false at the end of the run
+ */
+bool Sorter::readEntry(FILE *run, Entry &entry) {
+	uint32_t length; ///Bytes of the key
+	uint64_t row; ///Row of the key
+
+	if (fread(&length, sizeof(length), 1, run) != 1)
+		return false;
+	entry.first.resize(length);
+	if (fread(&entry.first[0], 1, length, run) != length || fread(&row, sizeof(row), 1, run) != 1)
+		return false;
+	entry.second = row;
+	return true;
+}
+/*!
+ * \brief Merge the runs
+ *
+ * This function will hold the next pair of every run and hand out the
+ * lowest of them until every run is read or the limit is reached.
+ *
+ * \param[in] size_t limit
+ *            Most rows handed out
+ * \param[in] function<void(size_t)> emit
+ *            Function given each row in order
+ * \return boolean false if a run could not be read
+ */
+bool Sorter::merge(size_t limit, const function<void(size_t)> &emit) {
+	vector<Entry> heads(runs.size()); ///Next pair of each run
+	auto later = [&heads](size_t a, size_t b) { return heads[b] < heads[a]; }; ///Order of the heap of runs
+	priority_queue<size_t, vector<size_t>, decltype(later)> next(later); ///Runs by their next pair
+
+	for (size_t r = 0; r < runs.size(); r++) {
+		if (readEntry(runs[r], heads[r]))
+			next.push(r);
+	}
+	for (size_t emitted = 0; emitted < limit && !next.empty(); emitted++) {
+		size_t r = next.top(); ///Run holding the lowest pair
+		next.pop();
+		emit(heads[r].second);
+		if (readEntry(runs[r], heads[r]))
+			next.push(r);
+	}
+	bool failed = false; ///Bool if a run could not be read
+	for (FILE *run: runs)
+		failed |= ferror(run) != 0;
+	closeRuns();
+	return !failed;
+}
+/*!
+ * \brief Remove the runs
+ */
+void Sorter::closeRuns() {
+	for (FILE *run: runs)
+		fclose(run);
+	runs.clear();
+}
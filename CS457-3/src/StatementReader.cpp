@@ -0,0 +1,107 @@
+/*!
+ * \file StatementReader.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the StatementReader class. The reader
+ * gathers lines of input until a statement is complete, leaving any text
+ * after the statement for the next call.
+ *
+ */
+
+#include "../include/StatementReader.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the StatementReader class
+ *
+ * \param[in] istream newIn
+ *            Stream to read the statements from
+ */
+StatementReader::StatementReader(istream &newIn) : in(newIn) {
+
+}
+/*!
+ * \brief Deconstructor of the StatementReader class
+ *
+ * This function will deconstruct the StatementReader class. This currently
+ * has no effect on the class.
+ *
+ */
+StatementReader::~StatementReader() {
+
+}
+/*!
+ * \brief Read the next statement
+ *
+ * This function will gather text until a ';' outside of quotes ends the
+ * statement, reading more lines as needed. Comments are dropped as they
+ * are found. Text left without a ';' at the end of the input is still
+ * handed out so the caller can report it.
+ *
+ * \param[out] string statement
+ *             Text of the statement including its ';'
+ * \return boolean false once the input holds no more statements
+ */
+bool StatementReader::next(string &statement) {
+	string line; ///Line read from the input
+	char quote = 0; ///Quote of the string being read, 0 outside of strings
+	bool command = false; ///Bool if the statement is a '.' command
+
+	statement.clear();
+	while (true) {
+		/** Take the text left by the last statement before reading a line **/
+		if (!pending.empty()) {
+			line = pending;
+			pending.clear();
+		}
+		else if (!getline(in, line))
+			break;
+
+		for (size_t i = 0; i < line.size(); i++) {
+			char next = line[i]; ///Character being read
+			if (quote != 0) {
+				if (next == quote)
+					quote = 0;
+				statement += next;
+				continue;
+			}
+			/** A comment runs to the end of the line **/
+			if (next == '-' && i + 1 < line.size() && line[i + 1] == '-')
+				break;
+			if (statement.find_first_not_of(" \t\r\n") == string::npos && next == '.')
+				command = true;
+			if (next == '\'' || next == '"')
+				quote = next;
+			statement += next;
+			if (next == ';') {
+				pending = line.substr(i + 1);
+				if (pending.find_first_not_of(" \t\r") == string::npos)
+					pending.clear();
+				return true;
+			}
+		}
+		if (command)
+			return true;
+		statement += '\n';
+	}
+	return statement.find_first_not_of(" \t\r\n") != string::npos;
+}
+/*!
+ * \brief Check for a statement waiting to be read
+ *
+ * This function will report if the text left by the last statement holds
+ * the end of another statement or the stream has input buffered, so the
+ * next call to next is not expected to wait for more input. The main
+ * parser syncs the logged changes before it would wait.
+ *
+ * \return boolean true if more input is already at hand
+ */
+bool StatementReader::ready() const {
+	return pending.find(';') != string::npos || in.rdbuf()->in_avail() > 0;
+}
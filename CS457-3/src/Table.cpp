@@ -11,20 +11,248 @@
  * and the labels/keys for each row. The class handles read and write of
  * the table to and from its corresponding file.
  *
+ * Tables are stored in a versioned binary file. The file starts with a
+ * header holding the column and row count, followed by the schema of each
+ * column with the offset of its data segment. Every segment holds the typed
+ * column data exactly as it is kept in memory, so a table file is mapped
+ * instead of parsed. The header holds a checksum of the rest of the file,
+ * which is verified when the file is mapped and so reads all of it once.
+ *
+ * Changes to the rows are not written to the table file. They are logged
+ * to the write-ahead log of the database, and the table file is rewritten
+ * only by a checkpoint, which stamps it with the sequence number of the
+ * last record it holds. Loading a table applies the records past it.
+ *
+ * The secondary indexes of a table are stored in an index file next to the
+ * table file, and like the columns their keys are mapped instead of read.
+ * The index file records the size of the table file it was written with, so
+ * indexes that no longer match the table are rebuilt from the columns when
+ * the table is read.
+ *
  */
 
 #include <bits/stdc++.h>
+#include <experimental/filesystem>
 #include <fstream>
 #include <iostream>
 #include <vector>
 #include <algorithm>
 
 #include "../include/Table.h"
+#include "../include/Aggregation.h"
 #include "../include/Column.h"
+#include "../include/CsvLoader.h"
+#include "../include/Filter.h"
+#include "../include/MappedFile.h"
+#include "../include/Output.h"
+#include "../include/ResultSink.h"
+#include "../include/RowCursor.h"
+#include "../include/Sorter.h"
+#include "../include/WriteAheadLog.h"
 
 ///std name space for general use
 using namespace std;
 
+/// Name space for use for shortening the file system name space
+namespace fs = std::experimental::filesystem;
+
+/// Magic bytes at the start of every table file
+static const char TABLE_MAGIC[8] = {'C', 'S', '4', '5', '7', 'T', 'B', 'L'};
+/// Version of the table file format written by this program
+static const uint32_t TABLE_VERSION = 3;
+/// Magic bytes at the start of every index file
+static const char INDEX_MAGIC[8] = {'C', 'S', '4', '5', '7', 'I', 'D', 'X'};
+/// Version of the index file format written by this program
+static const uint32_t INDEX_VERSION = 4;
+/// Sequence number given to indexes that must be rebuilt after replay
+static const uint64_t REBUILD_LSN = (uint64_t)-1;
+
+/*!
+ * \struct TableFileHeader
+ *
+ * \brief Fixed header at the start of a table file
+ *
+ * The header is followed by one schema entry per column. Each entry holds
+ * the length and bytes of the column name, the length and bytes of the
+ * column type, the column size, and the file offset of the column data.
+ */
+struct TableFileHeader {
+	char magic[8]; ///Bytes identifying a table file
+	uint32_t version; ///Version of the file format
+	uint32_t colNum; ///Number of columns in the table
+	uint64_t rowNum; ///Number of rows in the table
+	uint64_t dataOffset; ///Offset of the first column segment
+	uint64_t walLsn; ///Sequence number of the last logged record held by the file
+	uint32_t checksum; ///Checksum of the bytes following the header
+	uint32_t reserved; ///Unused, written as zero
+};
+
+/*!
+ * \struct IndexFileHeader
+ *
+ * \brief Fixed header at the start of an index file
+ *
+ * The header is followed by one directory entry per index. Each entry
+ * holds the length and bytes of the index name, the length and bytes of
+ * the column name, the kind of the index, and the file offset and length of
+ * the packed keys of the index, which are read in place from the mapping.
+ */
+struct IndexFileHeader {
+	char magic[8]; ///Bytes identifying an index file
+	uint32_t version; ///Version of the file format
+	uint32_t indexNum; ///Number of indexes in the file
+	uint64_t rowNum; ///Number of rows covered by the indexes
+	uint64_t tableBytes; ///Size of the table file the indexes were written with
+	uint32_t tableChecksum; ///Checksum of the table file the indexes were written with
+	uint32_t reserved; ///Unused, written as zero
+	uint64_t walLsn; ///Sequence number of the last logged record held by the indexes
+};
+
+/*!
+ * \brief Round a file offset up to the alignment of the column data
+ *
+ * \param[in] size_t offset
+ *            Offset to round
+ * \return size_t offset rounded up to a multiple of eight
+ */
+static size_t alignOffset(size_t offset) {
+	return (offset + 7) & ~(size_t)7;
+}
+/*!
+ * \brief Bounded reader for the table file schema
+ *
+ * This function will copy a field out of the mapped file and move the
+ * cursor past it, failing instead of reading past the end of the file.
+ *
+ * \param[in,out] const char *&cursor
+ *                Current read position in the mapping
+ * \param[in] const char *end
+ *            End of the mapping
+ * \param[out] void *field
+ *             Field receiving the bytes
+ * \param[in] size_t length
+ *            Number of bytes to read
+ * \return boolean true if the field was inside the file
+ */
+static bool readField(const char *&cursor, const char *end, void *field, size_t length) {
+	if ((size_t)(end - cursor) < length)
+		return false;
+	memcpy(field, cursor, length);
+	cursor += length;
+	return true;
+}
+/*!
+ * \brief Bounded string reader for the table file schema
+ *
+ * \param[in,out] const char *&cursor
+ *                Current read position in the mapping
+ * \param[in] const char *end
+ *            End of the mapping
+ * \param[out] string field
+ *             String receiving the length prefixed bytes
+ * \return boolean true if the string was inside the file
+ */
+static bool readString(const char *&cursor, const char *end, string &field) {
+	uint32_t length; ///Length of the string
+
+	if (!readField(cursor, end, &length, sizeof(length)) || (size_t)(end - cursor) < length)
+		return false;
+	field.assign(cursor, length);
+	cursor += length;
+	return true;
+}
+/*!
+ * \brief Length prefixed string writer for the index file
+ *
+ * \param[out] ostream out
+ *             Stream the string is written to
+ * \param[in] string field
+ *            String to write
+ */
+static void writeString(ostream &out, const string &field) {
+	uint32_t length = field.size(); ///Length of the string
+
+	out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+	out.write(field.data(), field.size());
+}
+/*!
+ * \struct IndexDirectoryEntry
+ *
+ * \brief Directory entry of an index in the index file
+ */
+struct IndexDirectoryEntry {
+	string indexName; ///String containing the index name
+	string colName; ///String containing the indexed column name
+	uint32_t kind; ///Kind of the index
+	uint64_t segmentOffset; ///Offset of the packed keys in the file
+	uint64_t segmentLength; ///Bytes of the packed keys
+};
+
+/*!
+ * \brief Directory reader for the index file
+ *
+ * This function will check the header of a mapped index file and read the
+ * directory entry of each index, failing if an entry or its packed keys
+ * lie outside the file.
+ *
+ * \param[in] MappedFile file
+ *            Mapped index file
+ * \param[out] IndexFileHeader header
+ *             Header read from the file
+ * \param[out] vector<IndexDirectoryEntry> directory
+ *             Entry of each index
+ * \return boolean true if the header and directory were read
+ */
+static bool readIndexDirectory(const MappedFile &file, IndexFileHeader &header,
+	vector<IndexDirectoryEntry> &directory) {
+	const char *cursor = file.data(); ///Current read position
+	const char *end = file.data() + file.size(); ///End of the file
+
+	if (!readField(cursor, end, &header, sizeof(header)) ||
+		memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+		header.version != INDEX_VERSION)
+		return false;
+	directory.resize(header.indexNum);
+	for (IndexDirectoryEntry &entry: directory) {
+		if (!readString(cursor, end, entry.indexName) || !readString(cursor, end, entry.colName) ||
+			!readField(cursor, end, &entry.kind, sizeof(entry.kind)) ||
+			!readField(cursor, end, &entry.segmentOffset, sizeof(entry.segmentOffset)) ||
+			!readField(cursor, end, &entry.segmentLength, sizeof(entry.segmentLength)) ||
+			entry.segmentOffset % sizeof(uint64_t) != 0 || entry.segmentOffset > file.size() ||
+			file.size() - entry.segmentOffset < entry.segmentLength)
+			return false;
+	}
+	return true;
+}
+/*!
+ * \brief Put a written file in place of another
+ *
+ * This function will sync a file written next to its destination, rename
+ * it over the destination and sync the directory, so the destination holds
+ * either its old or its new contents whenever the program stops.
+ *
+ * \param[in] string tempPath
+ *            String corresponding to the path of the written file
+ * \param[in] string path
+ *            String corresponding to the path the file replaces
+ * \return boolean true if the file is in place and on disk
+ */
+static bool replaceFile(const string &tempPath, const string &path) {
+	error_code error; ///Error of the rename
+
+	if (!WriteAheadLog::syncFile(tempPath)) {
+		fs::remove(tempPath, error);
+		return false;
+	}
+	fs::rename(tempPath, path, error);
+	if (error) {
+		fs::remove(tempPath, error);
+		return false;
+	}
+	string directory = fs::path(path).parent_path().string(); ///Directory holding the file
+	return WriteAheadLog::syncFile(directory.empty() ? "." : directory);
+}
+
 /*!
  * \brief Constructor of the Table class
  *
@@ -34,22 +262,593 @@ using namespace std;
  * of the table and accelerate file input. The files will also contain a list
  * of each column's information followed by its individual information.
  *
+ * Only the header and schema of a binary table file are read here. The
+ * rows are mapped and the logged changes are applied by load, when a
+ * statement first uses the table. Files ending in .txt are read in the older
+ * whitespace delimited format.
+ *
  * \param[in] string path
  *            String corresponding to the path that the tables file will be at
  */
 Table::Table(string path) {
 	rowNum = 0;
-	rowAdjust = 0;
+	fileBytes = 0;
+	fileChecksum = 0;
+	fileLsn = 0;
+	lastLsn = 0;
+	transaction = nullptr;
+	loaded = true;
+
+	/** Save Path for Later User **/
+	tablePath = path;
+	indexPath = fs::path(path).replace_extension(".idx").string();
+
+	/** Read the file in the format given by its extension **/
+	if (fs::path(path).extension() == ".txt")
+		readText(path);
+	else
+		readSchema(path);
+
+	/** Get and Add Table Path **/
+	path = path.substr(path.find('/') + 1);
+	path = path.substr(path.find('/') + 1);
+	path = path.substr(0,path.find('.'));
+	tableName = path;
+	lowerName = tableName;
+	transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+
+	/** A table without rows to load can be read at once **/
+	if (loaded)
+		publish();
+}
+/*!
+ * \brief Constructor of an empty Table
+ *
+ * This function will construct a table with no columns and no file. It is
+ * filled in by makeView to hold a snapshot of another table.
+ *
+ */
+Table::Table() {
+	rowNum = 0;
+	fileBytes = 0;
+	fileChecksum = 0;
+	fileLsn = 0;
+	lastLsn = 0;
+	transaction = nullptr;
+	loaded = true;
+}
+/*!
+ * \brief Deconstructor of the Table class
+ *
+ * This function will deconstruct the Table class. This currently has no
+ * effect on the class.
+ *
+ */
+Table::~Table() {
+
+}
+/*!
+ * \brief Schema reader for the Table class
+ *
+ * This function will read only the header and schema of a binary table
+ * file, leaving the columns empty until the table is loaded. A missing
+ * file is a new empty table with nothing to load.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the table file
+ */
+void Table::readSchema(string path) {
+	TableFileHeader header; ///Header read from the file
+	string schema; ///Bytes of the schema entries
+	string newColName; ///String containing the columns name
+	string newColType; ///String containing the columns type
+	int32_t newColSize; ///Int containing the column size if applicable
+	uint64_t segmentOffset; ///Offset of the column data in the file
+
+	/** A missing file is a new empty table **/
+	ifstream inputFile(path, ios::binary);
+	if (!inputFile.is_open())
+		return;
+	loaded = false;
+
+	/** Read the header and the schema up to the first segment **/
+	if (!inputFile.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+		memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 ||
+		header.version != TABLE_VERSION || header.dataOffset < sizeof(header)) {
+		Output::stream() << "!Failed to read table file " << path << "." << endl;
+		return;
+	}
+	schema.resize(header.dataOffset - sizeof(header));
+	if (!inputFile.read(&schema[0], schema.size())) {
+		Output::stream() << "!Failed to read table file " << path << "." << endl;
+		return;
+	}
+	const char *cursor = schema.data(); ///Current read position
+	const char *end = schema.data() + schema.size(); ///End of the schema
 
+	/** Input column settings without their data **/
+	for (size_t i = 0; i < header.colNum; i++) {
+		if (!readString(cursor, end, newColName) || !readString(cursor, end, newColType) ||
+			!readField(cursor, end, &newColSize, sizeof(newColSize)) ||
+			!readField(cursor, end, &segmentOffset, sizeof(segmentOffset))) {
+			Output::stream() << "!Failed to read table file " << path << "." << endl;
+			columns.clear();
+			return;
+		}
+		columns.push_back(Column(newColName, newColType, newColSize));
+	}
+	rowNum = header.rowNum;
+	fileLsn = header.walLsn;
+	lastLsn = fileLsn;
+	readIndexNames();
+}
+/*!
+ * \brief Row loader for the Table class
+ *
+ * This function will map the rows of a table read by readSchema, apply the
+ * logged changes and read the indexes. It does nothing for a table that is
+ * already loaded, so every statement calls it before using the table.
+ * Queries load a table without the latch of the database, so the rows are
+ * loaded under the latch of the table, once, by whichever comes first.
+ *
+ */
+void Table::load() {
+	if (loaded)
+		return;
+	lock_guard<mutex> guard(loadLatch); /// Latch held while the rows are loaded
+	if (loaded)
+		return;
+	columns.clear();
+	rowNum = 0;
+	readFile(tablePath);
+	/** The rows read are committed, so they are published even inside a transaction **/
+	atomic_store(&published, makeView(true));
+	loaded = true;
+}
+/*!
+ * \brief Row restorer for the Table class
+ *
+ * This function will put back the columns and indexes of a snapshot taken
+ * before a transaction changed the table, undoing its changes. The columns
+ * read the storage they shared with the snapshot and copy it again only if
+ * the table changes, and the indexes are the ones the snapshot kept, since
+ * the transaction copied any index before changing it. The rows are then
+ * published, as a change inside the transaction may have taken the indexes
+ * from the published snapshot.
+ *
+ * \param[in] Table image
+ *            Snapshot of the table as last committed
+ */
+void Table::revert(const Table &image) {
+	columns = image.columns;
+	indexes = image.indexes;
+	rowNum = image.rowNum;
+	lastLsn = image.lastLsn;
+	publish();
+}
+/*!
+ * \brief Snapshot reader for the Table class
+ *
+ * This function will give the snapshot published by the last change, which
+ * stays as it is however the table changes while it is read.
+ *
+ * \return shared_ptr<Table> snapshot of the table, empty until the rows are loaded
+ */
+shared_ptr<Table> Table::snapshot() {
+	return atomic_load(&published);
+}
+/*!
+ * \brief Snapshot writer for the Table class
+ *
+ * This function will make a snapshot of the rows as they are now and hand
+ * it to the queries starting from now on. Queries already running keep
+ * the snapshot they started with. The changes of a transaction are held
+ * back until it commits, so other sessions never read rows that may still
+ * be rolled back.
+ *
+ */
+void Table::publish() {
+	if (transaction == nullptr)
+		atomic_store(&published, makeView(true));
+}
+/*!
+ * \brief Snapshot maker for the Table class
+ *
+ * This function will build a table holding a read only copy of each column
+ * with the rows it holds now. The copies share their storage with the
+ * columns, so a snapshot costs the number of columns and not of rows.
+ *
+ * \param[in] bool withIndexes
+ *            True if the snapshot shares the indexes of the table
+ * \return shared_ptr<Table> snapshot of the table
+ */
+shared_ptr<Table> Table::makeView(bool withIndexes) const {
+	shared_ptr<Table> view = make_shared<Table>(); ///Snapshot of the table
+
+	view->columns.reserve(columns.size());
+	for (const Column &tableColumn: columns)
+		view->columns.push_back(tableColumn.snapshot());
+	view->lowerName = lowerName;
+	view->tableName = tableName;
+	view->tablePath = tablePath;
+	view->indexPath = indexPath;
+	if (withIndexes)
+		view->indexes = indexes;
+	view->fileLsn = fileLsn;
+	view->lastLsn = lastLsn;
+	view->fileBytes = fileBytes;
+	view->fileChecksum = fileChecksum;
+	view->rowNum = rowNum;
+	return view;
+}
+/*!
+ * \brief Index owner for the Table class
+ *
+ * This function will make the indexes safe to change before a change to
+ * the rows. The published snapshot gives up the indexes, so queries
+ * starting during the change find their rows without them, and an index
+ * still read by a running query is copied. The indexes come back to the
+ * queries with the snapshot published after the change.
+ *
+ */
+void Table::ownIndexes() {
+	if (indexes.empty())
+		return;
+	{
+		shared_ptr<Table> view = atomic_load(&published); ///Snapshot read by new queries
+		if (view && !view->indexes.empty())
+			atomic_store(&published, view->makeView(false));
+	}
+	for (shared_ptr<Index> &tableIndex: indexes) {
+		if (tableIndex.use_count() == 1)
+			continue;
+		tableIndex = make_shared<Index>(*tableIndex);
+	}
+	/** Order the change after the reads of the last snapshot released **/
+	atomic_thread_fence(memory_order_acquire);
+}
+/*!
+ * \brief Binary file reader for the Table class
+ *
+ * This function will map a binary table file and point each column at its
+ * segment. The checksum in the header is checked over the rest of the file
+ * first, so a damaged file is reported instead of read. Verifying the
+ * checksum reads every page of the file; only the header and schema are
+ * parsed, the rows are not copied out of the mapping.
+ * A missing file leaves the table empty.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the table file
+ */
+void Table::readFile(string path) {
+	shared_ptr<MappedFile> file = make_shared<MappedFile>(path); ///Mapped table file
+	TableFileHeader header; ///Header read from the file
+	string newColName; ///String containing the columns name
+	string newColType; ///String containing the columns type
+	int32_t newColSize; ///Int containing the column size if applicable
+	uint64_t segmentOffset; ///Offset of the column data in the file
+
+	/** A missing file is a new empty table **/
+	if (!file->isOpen())
+		return;
+	const char *cursor = file->data(); ///Current read position
+	const char *end = file->data() + file->size(); ///End of the file
+
+	/** Check the header before trusting the schema **/
+	if (!readField(cursor, end, &header, sizeof(header)) ||
+		memcmp(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC)) != 0 ||
+		header.version != TABLE_VERSION ||
+		WriteAheadLog::checksum(cursor, end - cursor) != header.checksum) {
+		Output::stream() << "!Failed to read table file " << path << "." << endl;
+		return;
+	}
+
+	/** Input column settings and point each column at its segment **/
+	for (size_t i = 0; i < header.colNum; i++) {
+		if (!readString(cursor, end, newColName) || !readString(cursor, end, newColType) ||
+			!readField(cursor, end, &newColSize, sizeof(newColSize)) ||
+			!readField(cursor, end, &segmentOffset, sizeof(segmentOffset))) {
+			Output::stream() << "!Failed to read table file " << path << "." << endl;
+			columns.clear();
+			return;
+		}
+		columns.push_back(Column(newColName, newColType, newColSize));
+		/** Check that the segment lies inside the file **/
+		const char *segment = file->data() + segmentOffset; ///Start of the segment
+		size_t indexLength = columns.back().isChar() ? (header.rowNum + 1) * sizeof(uint32_t) : 0;
+		if (segmentOffset > file->size() || file->size() - segmentOffset < indexLength ||
+			file->size() - segmentOffset < Column::segmentLength(columns.back().layout,
+				segment, header.rowNum)) {
+			Output::stream() << "!Failed to read table file " << path << "." << endl;
+			columns.clear();
+			return;
+		}
+		columns.back().map(file, segment, header.rowNum);
+	}
+	rowNum = header.rowNum;
+	fileBytes = file->size();
+	fileChecksum = header.checksum;
+	fileLsn = header.walLsn;
+	lastLsn = fileLsn;
+
+	/** Read the indexes and add the changes made since the files were written **/
+	if (path == tablePath) {
+		uint64_t indexLsn = fileLsn; ///Sequence number of the last record held by the indexes
+		size_t indexRows = rowNum; ///Number of rows held by the indexes
+		readIndexes(indexLsn, indexRows);
+		replayRecords(indexLsn, indexRows);
+	}
+}
+/*!
+ * \brief Write-ahead log reader for the Table class
+ *
+ * This function will apply the records of the write-ahead log made since
+ * the table file was written, in the order they were made. Applying stops
+ * at the first record that does not fit the table, since the records
+ * after it were made against rows it would have changed.
+ *
+ * The indexes are set aside while the records they already hold are
+ * applied, and the later records change them the way the statements that
+ * logged them did. Indexes that do not match the rows when they are
+ * brought back, as when the log ends before the last record they hold, are
+ * rebuilt from the columns.
+ *
+ * \param[in] uint64_t indexLsn
+ *            Sequence number of the last record held by the indexes
+ * \param[in] size_t indexRows
+ *            Number of rows held by the indexes
+ */
+void Table::replayRecords(uint64_t indexLsn, size_t indexRows) {
+	vector<shared_ptr<Index>> heldIndexes; ///Indexes set aside while the records they hold are applied
+	bool held = true; ///Bool while the indexes are set aside
+
+	/** Bring back the indexes, rebuilding them if they do not match the rows **/
+	auto restoreIndexes = [&]() {
+		indexes.swap(heldIndexes);
+		held = false;
+		if (lastLsn != indexLsn || rowNum != indexRows)
+			buildIndexes();
+	};
+	heldIndexes.swap(indexes);
+	for (const WriteAheadLog::Record &record: pending) {
+		const char *cursor = record.payload.data(); ///Start of the record
+		const char *end = cursor + record.payload.size(); ///End of the record
+		bool applied = false; ///Bool if the record fit the table
+		if (held && record.lsn > indexLsn)
+			restoreIndexes();
+		switch (record.kind) {
+		case WriteAheadLog::INSERT_ROWS:
+			applied = replayInsert(cursor, end);
+			break;
+		case WriteAheadLog::UPDATE_ROWS:
+			applied = replayUpdate(cursor, end);
+			break;
+		case WriteAheadLog::DELETE_ROWS:
+			applied = replayDelete(cursor, end);
+			break;
+		default: /// Transaction markers are never handed to a table
+			break;
+		}
+		if (!applied) {
+			Output::stream() << "!Failed to apply the changes to table " << tableName << " logged after record "
+				 << lastLsn << "." << endl;
+			break;
+		}
+		lastLsn = record.lsn;
+	}
+	if (held)
+		restoreIndexes();
+	pending.clear();
+	pending.shrink_to_fit();
+}
+/*!
+ * \brief Insert record reader for the Table class
+ *
+ * This function will append the logged rows to the table. Nothing is
+ * changed unless every row of the record matches the schema.
+ *
+ * \param[in] const char *cursor
+ *            Start of the record
+ * \param[in] const char *end
+ *            End of the record
+ * \return boolean true if the rows were appended
+ */
+bool Table::replayInsert(const char *cursor, const char *end) {
+	size_t appended = 0; ///Number of rows read from the record
+	size_t decoded = columns.size(); ///Number of columns read from the last row
+
+	while (cursor != end && decoded == columns.size() && !columns.empty()) {
+		decoded = 0;
+		while (decoded < columns.size() && columns[decoded].decode(cursor, end))
+			decoded++;
+		if (decoded == columns.size())
+			appended++;
+	}
+	if (decoded < columns.size() || cursor != end) {
+		/** Take back a record that does not match the schema **/
+		for (size_t j = 0; j < decoded; j++)
+			columns[j].popBack();
+		for (size_t i = 0; i < appended; i++) {
+			for (Column &logCol: columns)
+				logCol.popBack();
+		}
+		return false;
+	}
+	rowNum += appended;
+	indexRows(rowNum - appended);
+	return true;
+}
+/*!
+ * \brief Update record reader for the Table class
+ *
+ * This function will repeat a logged update, setting the logged rows of
+ * the logged column to the logged literal. Nothing is changed unless the
+ * whole record fits the table.
+ *
+ * \param[in] const char *cursor
+ *            Start of the record
+ * \param[in] const char *end
+ *            End of the record
+ * \return boolean true if the update was applied
+ */
+bool Table::replayUpdate(const char *cursor, const char *end) {
+	uint32_t col; ///Position of the changed column
+	string literal; ///Literal the rows were set to
+	uint64_t changedNum; ///Number of changed rows
+	Value parsed; ///Literal parsed for the column
+
+	if (!readField(cursor, end, &col, sizeof(col)) || col >= columns.size() ||
+		!readString(cursor, end, literal) || !readField(cursor, end, &changedNum, sizeof(changedNum)) ||
+		(size_t)(end - cursor) != changedNum * sizeof(uint64_t) ||
+		!columns[col].parse(literal, parsed) || !columns[col].fits(parsed))
+		return false;
+	vector<size_t> rows(changedNum); ///Changed rows
+	for (size_t i = 0; i < changedNum; i++) {
+		uint64_t row; ///Changed row
+		readField(cursor, end, &row, sizeof(row));
+		if (row >= rowNum || (i > 0 && row <= rows[i - 1]))
+			return false;
+		rows[i] = row;
+	}
+	assignRows(col, rows, parsed);
+	return true;
+}
+/*!
+ * \brief Delete record reader for the Table class
+ *
+ * This function will repeat a logged delete, removing the logged rows.
+ * Nothing is changed unless every row is in the table.
+ *
+ * \param[in] const char *cursor
+ *            Start of the record
+ * \param[in] const char *end
+ *            End of the record
+ * \return boolean true if the delete was applied
+ */
+bool Table::replayDelete(const char *cursor, const char *end) {
+	uint64_t erasedNum; ///Number of removed rows
+	vector<bool> erased(rowNum, false); ///Rows selected for removal
+
+	if (!readField(cursor, end, &erasedNum, sizeof(erasedNum)) ||
+		(size_t)(end - cursor) != erasedNum * sizeof(uint64_t))
+		return false;
+	for (size_t i = 0; i < erasedNum; i++) {
+		uint64_t row; ///Removed row
+		readField(cursor, end, &row, sizeof(row));
+		if (row >= rowNum || erased[row])
+			return false;
+		erased[row] = true;
+	}
+	eraseRows(erased);
+	return true;
+}
+/*!
+ * \brief Insert log writer for the Table class
+ *
+ * This function will log rows appended to the table instead of rewriting
+ * the table file, so an insert costs the size of its rows. The rows are
+ * written as one record, which is replayed whole or not at all.
+ *
+ * \param[in] size_t first
+ *            Index of the first row to append
+ * \param[in] size_t count
+ *            Number of rows to append
+ */
+void Table::appendRows(size_t first, size_t count) {
+	string record; ///Encoded record
+
+	for (size_t row = first; row < first + count; row++) {
+		for (const Column &outputCol: columns)
+			outputCol.encode(row, record);
+	}
+	appendRecord(WriteAheadLog::INSERT_ROWS, record);
+}
+/*!
+ * \brief Update log writer for the Table class
+ *
+ * This function will log an update instead of rewriting the table file,
+ * so an update costs the number of rows it changes. The record holds the
+ * position of the changed column, the literal it was set to and the
+ * changed rows.
+ *
+ * \param[in] size_t col
+ *            Position of the changed column
+ * \param[in] string literal
+ *            Literal the rows were set to
+ * \param[in] vector<size_t> rows
+ *            Changed rows in ascending order
+ */
+void Table::appendUpdate(size_t col, const string &literal, const vector<size_t> &rows) {
+	string record; ///Encoded record
+	uint32_t position = col; ///Position of the changed column
+	uint32_t length = literal.size(); ///Length of the literal
+	uint64_t changedNum = rows.size(); ///Number of changed rows
+
+	record.append(reinterpret_cast<const char *>(&position), sizeof(position));
+	record.append(reinterpret_cast<const char *>(&length), sizeof(length));
+	record.append(literal);
+	record.append(reinterpret_cast<const char *>(&changedNum), sizeof(changedNum));
+	for (uint64_t row: rows)
+		record.append(reinterpret_cast<const char *>(&row), sizeof(row));
+	appendRecord(WriteAheadLog::UPDATE_ROWS, record);
+}
+/*!
+ * \brief Delete log writer for the Table class
+ *
+ * This function will log a delete instead of rewriting the table file,
+ * so a delete costs the number of rows it removes. The record holds the
+ * removed rows as numbered before the delete.
+ *
+ * \param[in] vector<size_t> rows
+ *            Removed rows in ascending order
+ */
+void Table::appendDelete(const vector<size_t> &rows) {
+	string record; ///Encoded record
+	uint64_t erasedNum = rows.size(); ///Number of removed rows
+
+	record.append(reinterpret_cast<const char *>(&erasedNum), sizeof(erasedNum));
+	for (uint64_t row: rows)
+		record.append(reinterpret_cast<const char *>(&row), sizeof(row));
+	appendRecord(WriteAheadLog::DELETE_ROWS, record);
+}
+/*!
+ * \brief Record writer for the write-ahead log
+ *
+ * This function will append an encoded change of the table to the log of
+ * its database. The record is made durable by the next group commit, and
+ * the table file takes it in at the next checkpoint. Inside a transaction
+ * the record is handed to the transaction instead. A record the log could
+ * not take leaves the last sequence number of the table as it was.
+ *
+ * \param[in] WriteAheadLog::Kind kind
+ *            Change held by the record
+ * \param[in] string payload
+ *            Encoded change
+ */
+void Table::appendRecord(WriteAheadLog::Kind kind, const string &payload) {
+	if (Transaction *owner = transaction)
+		owner->log(*this, kind, payload);
+	else if (wal) {
+		if (uint64_t lsn = wal->append(kind, lowerName, payload))
+			lastLsn = lsn;
+	}
+}
+/*!
+ * \brief Text file reader for the Table class
+ *
+ * This function will read a table in the older whitespace delimited text
+ * format. It is only used to convert such tables to the binary format.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the text table file
+ */
+void Table::readText(string path) {
     string input; ///String containing input from file
 	string newColName; ///String containing the columns name
 	string newColType; ///String containing the columns type
 	int newColSize; ///Int containing the column size if applicable
 	size_t colNum; ///Int containing the number of columns
 
-	/** Save Path for Later User **/
-	tablePath = path;
-
 	/** Create ifstream based on the path parameter **/
 	ifstream inputFile(path);
 
@@ -76,29 +875,32 @@ Table::Table(string path) {
             /**Go through each column pushing info for each row **/
 			for (size_t j = 0; j < colNum; j++) {
 				inputFile >> input;
-				columns[j].colData.push_back(input);
+				columns[j].appendLiteral(input);
 			}
 		}
 		/** Close file **/
 		inputFile.close();
 	}
-	/** Get and Add Table Path **/
-	path = path.substr(path.find('/') + 1);
-	path = path.substr(path.find('/') + 1);
-	path = path.substr(0,path.find('.'));
-	tableName = path;
-	lowerName = tableName;
-	transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
 }
 /*!
- * \brief Deconstructor of the Table class
+ * \brief Converter for text table files
  *
- * This function will deconstruct the Table class. This currently has no
- * effect on the class.
+ * This function will read a table stored in the older text format, write
+ * it next to the original as a binary table file, and remove the text
+ * file once the binary file is written.
  *
+ * \param[in] string textPath
+ *            String corresponding to the path of the text table file
+ * \return string holding the path of the binary table file
  */
-Table::~Table() {
+string Table::convertText(string textPath) {
+	Table textTable(textPath); ///Table read from the text file
+	string binaryPath = fs::path(textPath).replace_extension(".tbl").string(); ///Path of the new file
 
+	textTable.writeTable(binaryPath);
+	if (fs::exists(binaryPath))
+		fs::remove(textPath);
+	return binaryPath;
 }
 /*!
  * \brief File writer for the Table class
@@ -109,47 +911,530 @@ Table::~Table() {
  * existing row and column lists to provide it for the next constructing
  * of the database objects.
  *
+ * The table is written to a temporary file next to the destination, which
+ * is checksummed, synced and renamed over the destination, so a crash at
+ * any point leaves either the old or the new file. Columns still mapped
+ * from the old file keep reading it, since renaming does not change it.
+ * Writing the table to its own path makes it a checkpoint: the file is
+ * stamped with the last record of the write-ahead log, every record of the
+ * table up to it now being part of the file.
+ *
  * \param[in] string path
  *            String corresponding to the path that the tables file will be at
+ * \return boolean true if the file was written and is on disk
  */
-void Table::writeTable(string path) {
-	bool printLine  = true;
+bool Table::writeTable(string path) {
+	TableFileHeader header; ///Header written to the file
+	vector<uint64_t> segmentOffsets; ///Offset of each column segment
+	size_t offset; ///Running offset in the file
+	static const char padding[8] = {}; ///Zero bytes used to align segments
+	string tempPath = path + ".tmp"; ///Path the file is written to before it is renamed
+
+	/** Read the rows of a table not used yet **/
+	load();
+
+	/** Lay out the schema and the column segments **/
+	offset = sizeof(header);
+	for (const Column &outputCol: columns)
+		offset += 3 * sizeof(uint32_t) + outputCol.colName.size() + outputCol.colType.size() + sizeof(uint64_t);
+	offset = alignOffset(offset);
+	memcpy(header.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+	header.version = TABLE_VERSION;
+	header.colNum = columns.size();
+	header.rowNum = rowNum;
+	header.dataOffset = offset;
+	header.walLsn = wal ? wal->lastLsn() : lastLsn;
+	header.checksum = 0;
+	header.reserved = 0;
+	for (const Column &outputCol: columns) {
+		segmentOffsets.push_back(offset);
+		offset = alignOffset(offset + outputCol.segmentLength());
+	}
 
     /** Create ofstream based on the path parameter **/
-	ofstream outputFile(path);
+	ofstream outputFile(tempPath, ios::binary | ios::trunc);
 
 	/** Check if the file exists and open **/
-	if(outputFile.is_open()){
-        /** Output file column and row size **/
-		outputFile << columns.size() << " " << rowNum - rowAdjust<< endl;
-        /** Go through each column and write setting information **/
-		for (auto outputCol: columns) {
-			outputFile << outputCol.colName << " " << outputCol.colType;
-			/** Change output to include size if a char type **/
-			if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-				outputFile << " " <<  outputCol.colSize;
-			}
-			outputFile << " ";
+	if (!outputFile.is_open()) {
+		Output::stream() << "!Failed to write table file " << path << "." << endl;
+		return false;
+	}
+    /** Output file header, written again with the checksum once the rest is known **/
+	outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    /** Go through each column and write setting information **/
+	for (size_t i = 0; i < columns.size(); i++) {
+		uint32_t length = columns[i].colName.size(); ///Length of a schema string
+		int32_t size = columns[i].colSize; ///Size of the column
+		outputFile.write(reinterpret_cast<const char *>(&length), sizeof(length));
+		outputFile << columns[i].colName;
+		length = columns[i].colType.size();
+		outputFile.write(reinterpret_cast<const char *>(&length), sizeof(length));
+		outputFile << columns[i].colType;
+		outputFile.write(reinterpret_cast<const char *>(&size), sizeof(size));
+		outputFile.write(reinterpret_cast<const char *>(&segmentOffsets[i]), sizeof(uint64_t));
+	}
+	/** Go through each column and write its segment **/
+	for (size_t i = 0; i < columns.size(); i++) {
+		outputFile.write(padding, segmentOffsets[i] - outputFile.tellp());
+		columns[i].writeSegment(outputFile);
+	}
+	outputFile.write(padding, offset - outputFile.tellp());
+	outputFile.close();
+
+	/** Checksum the written bytes and fill in the header **/
+	if (outputFile) {
+		MappedFile written(tempPath); ///Mapping of the written file
+		if (written.size() == offset)
+			header.checksum = WriteAheadLog::checksum(written.data() + sizeof(header), offset - sizeof(header));
+		else
+			outputFile.setstate(ios::failbit);
+	}
+	if (outputFile) {
+		outputFile.open(tempPath, ios::binary | ios::in | ios::out);
+		outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		outputFile.close();
+	}
+	if (!outputFile || !replaceFile(tempPath, path)) {
+		fs::remove(tempPath);
+		Output::stream() << "!Failed to write table file " << path << "." << endl;
+		return false;
+	}
+
+	/** Logged rows are now in the table file **/
+	if (path == tablePath) {
+		fileBytes = offset;
+		fileChecksum = header.checksum;
+		fileLsn = header.walLsn;
+		lastLsn = fileLsn;
+		writeIndexes();
+	}
+	return true;
+}
+/*!
+ * \brief Index file reader for the Table class
+ *
+ * This function will map the index file of the table. Indexes written over
+ * the current table file read their packed keys in place, so their pages
+ * are only read by lookups, and replayRecords adds the records logged
+ * after them. Indexes written over another table file are left empty and
+ * marked to be rebuilt from the columns once the records are applied.
+ *
+ * \param[out] uint64_t indexLsn
+ *             Sequence number of the last record held by the indexes
+ * \param[out] size_t indexRows
+ *             Number of rows held by the indexes
+ */
+void Table::readIndexes(uint64_t &indexLsn, size_t &indexRows) {
+	shared_ptr<MappedFile> file = make_shared<MappedFile>(indexPath); ///Mapped index file
+	IndexFileHeader header; ///Header read from the file
+	vector<IndexDirectoryEntry> directory; ///Entry of each index
+
+	/** A missing file is a table without indexes **/
+	indexNames.clear();
+	if (!file->isOpen())
+		return;
+	if (!readIndexDirectory(*file, header, directory)) {
+		Output::stream() << "!Failed to read index file " << indexPath << "." << endl;
+		return;
+	}
+	bool current = header.tableBytes == fileBytes && header.tableChecksum == fileChecksum &&
+		header.walLsn >= fileLsn; ///Bool if the keys were written over the table file
+
+	/** Map the keys of each index only if they match the table **/
+	for (const IndexDirectoryEntry &entry: directory) {
+		if (findColumn(entry.colName) < 0) {
+			Output::stream() << "!Failed to read index file " << indexPath << "." << endl;
+			indexes.clear();
+			return;
 		}
-		outputFile << endl;
-		/** Go through each row and write data at each column **/
-		for (size_t i = 0; i < rowNum; i++) {
-			for (auto outputCol: columns) {
-				/** Adjust printing to not print erased info **/
-				if (outputCol.colData[i] != "ERASE" ) {
-					outputFile << outputCol.colData[i];
-					outputFile << " ";
-				}
-				else
-					printLine = false;
+		indexes.push_back(make_shared<Index>(entry.indexName, entry.colName, entry.kind == Index::HASH_INDEX ?
+			Index::HASH_INDEX : Index::TREE_INDEX));
+		if (current && !indexes.back()->map(file, file->data() + entry.segmentOffset, entry.segmentLength,
+			header.rowNum))
+			current = false;
+	}
+	indexLsn = current ? header.walLsn : REBUILD_LSN;
+	indexRows = header.rowNum;
+}
+/*!
+ * \brief Index name reader for the Table class
+ *
+ * This function will read the names of the indexes from the directory of
+ * the index file, so a table not loaded yet can tell which indexes it
+ * holds without mapping its rows.
+ *
+ */
+void Table::readIndexNames() {
+	MappedFile file(indexPath); ///Mapped index file
+	IndexFileHeader header; ///Header read from the file
+	vector<IndexDirectoryEntry> directory; ///Entry of each index
+
+	indexNames.clear();
+	if (!file.isOpen() || !readIndexDirectory(file, header, directory))
+		return;
+	for (const IndexDirectoryEntry &entry: directory)
+		indexNames.push_back(entry.indexName);
+}
+/*!
+ * \brief Index builder for the Table class
+ *
+ * This function will build every index again from the rows of its column.
+ *
+ */
+void Table::buildIndexes() {
+	ownIndexes();
+	for (const shared_ptr<Index> &tableIndex: indexes)
+		tableIndex->build(columns[findColumn(tableIndex->colName)]);
+}
+/*!
+ * \brief Index file writer for the Table class
+ *
+ * This function will write every index of the table to its index file
+ * along with the size and checksum of the table file and the sequence
+ * number of the last record applied to the table, or remove the index
+ * file if the table has no indexes. The file is written next to the index
+ * file and renamed over it like a table file. The indexes then read their
+ * keys from the new file, dropping the changes they held in memory.
+ *
+ */
+void Table::writeIndexes() {
+	IndexFileHeader header; ///Header written to the file
+	vector<shared_ptr<const void>> owners; ///Mapping or buffer holding the packed keys of each index
+	vector<const char *> segments; ///Packed keys of each index
+	vector<size_t> segmentLengths; ///Bytes of the packed keys of each index
+	vector<uint64_t> segmentOffsets; ///Offset of the packed keys of each index
+	size_t offset; ///Running offset in the file
+	static const char padding[8] = {}; ///Zero bytes used to align segments
+	string tempPath = indexPath + ".tmp"; ///Path the file is written to before it is renamed
+
+	if (indexes.empty()) {
+		fs::remove(indexPath);
+		return;
+	}
+	memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	header.version = INDEX_VERSION;
+	header.indexNum = indexes.size();
+	header.rowNum = rowNum;
+	header.tableBytes = fileBytes;
+	header.tableChecksum = fileChecksum;
+	header.reserved = 0;
+	header.walLsn = lastLsn;
+
+	/** Lay out the directory and the packed keys **/
+	offset = sizeof(header);
+	for (const shared_ptr<Index> &outputIndex: indexes)
+		offset += 3 * sizeof(uint32_t) + outputIndex->indexName.size() + outputIndex->colName.size() +
+			2 * sizeof(uint64_t);
+	offset = alignOffset(offset);
+	for (const shared_ptr<Index> &outputIndex: indexes) {
+		const char *segment; ///Start of the packed keys
+		size_t length; ///Bytes of the packed keys
+		owners.push_back(outputIndex->pack(segment, length));
+		segments.push_back(segment);
+		segmentLengths.push_back(length);
+		segmentOffsets.push_back(offset);
+		offset = alignOffset(offset + length);
+	}
+
+	/** Create ofstream based on the path of the index file **/
+	ofstream outputFile(tempPath, ios::binary | ios::trunc);
+	if (!outputFile.is_open())
+		return;
+	outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	for (size_t i = 0; i < indexes.size(); i++) {
+		uint32_t kind = indexes[i]->kind; ///Kind of the index
+		uint64_t length = segmentLengths[i]; ///Bytes of the packed keys
+		writeString(outputFile, indexes[i]->indexName);
+		writeString(outputFile, indexes[i]->colName);
+		outputFile.write(reinterpret_cast<const char *>(&kind), sizeof(kind));
+		outputFile.write(reinterpret_cast<const char *>(&segmentOffsets[i]), sizeof(uint64_t));
+		outputFile.write(reinterpret_cast<const char *>(&length), sizeof(length));
+	}
+	for (size_t i = 0; i < indexes.size(); i++) {
+		outputFile.write(padding, segmentOffsets[i] - outputFile.tellp());
+		outputFile.write(segments[i], segmentLengths[i]);
+	}
+	outputFile.write(padding, offset - outputFile.tellp());
+	outputFile.close();
+	if (!outputFile || !replaceFile(tempPath, indexPath)) {
+		fs::remove(tempPath);
+		Output::stream() << "!Failed to write index file " << indexPath << "." << endl;
+		return;
+	}
+
+	/** Read the keys back from the file so the buffers and changes are freed **/
+	shared_ptr<MappedFile> file = make_shared<MappedFile>(indexPath); ///Mapping of the written file
+	if (file->size() != offset)
+		return;
+	for (size_t i = 0; i < indexes.size(); i++) {
+		shared_ptr<Index> stored = make_shared<Index>(indexes[i]->indexName, indexes[i]->colName,
+			indexes[i]->kind); ///Index reading the written keys
+		if (stored->map(file, file->data() + segmentOffsets[i], segmentLengths[i], rowNum))
+			indexes[i] = stored;
+	}
+}
+/*!
+ * \brief Column lookup for the Table class
+ *
+ * \param[in] string name
+ *            String corresponding to the name of the column
+ * \return int position of the column, or -1 if the table has no such column
+ */
+int Table::findColumn(const string &name) const {
+	for (size_t i = 0; i < columns.size(); i++) {
+		if (columns[i].colName == name)
+			return i;
+	}
+	return -1;
+}
+/*!
+ * \brief Index name lookup for the Table class
+ *
+ * A table not loaded yet answers from the names read with its schema.
+ *
+ * \param[in] string indexName
+ *            String corresponding to the name of the index
+ * \return boolean true if the table holds the index
+ */
+bool Table::holdsIndex(const string &indexName) const {
+	if (!loaded)
+		return find(indexNames.begin(), indexNames.end(), indexName) != indexNames.end();
+	for (const shared_ptr<Index> &tableIndex: indexes) {
+		if (tableIndex->indexName == indexName)
+			return true;
+	}
+	return false;
+}
+/*!
+ * \brief Method for the create index function
+ *
+ * This function will build an index over a column of the table and store
+ * it in the index file. The write-ahead log is synced first, since the
+ * index file holds every change made to the rows so far.
+ *
+ * \param[in] string indexName
+ *            String corresponding to the name of the index
+ * \param[in] string colName
+ *            String corresponding to the name of the indexed column
+ * \param[in] Kind kind
+ *            Structure used to find the rows of a value
+ * \return boolean true for end of processing
+ */
+bool Table::createIndex(string indexName, string colName, Index::Kind kind) {
+	int col = findColumn(colName); ///Position of the indexed column
+
+	if (col < 0) {
+		Output::stream() << "!Failed to create index "
+			 << indexName
+			 << " because " << colName
+			 << " is not a column of " << tableName << "." << endl;
+		return true;
+	}
+	/** The index file must not hold changes the log could still lose **/
+	if (wal && !wal->commit()) {
+		Output::stream() << "!Failed to create index "
+			 << indexName
+			 << " because the write-ahead log could not be synced." << endl;
+		return true;
+	}
+	indexes.push_back(make_shared<Index>(indexName, colName, kind));
+	indexes.back()->build(columns[col]);
+	writeIndexes();
+	publish();
+	Output::stream() << "Index "
+		 << indexName
+		 << " created." << endl;
+	return true;
+}
+/*!
+ * \brief Method for the drop index function
+ *
+ * This function will remove an index and write the index file without it,
+ * syncing the write-ahead log first like createIndex.
+ *
+ * \param[in] string indexName
+ *            String corresponding to the name of the index
+ * \return boolean true if the table held the index
+ */
+bool Table::dropIndex(string indexName) {
+	for (size_t i = 0; i < indexes.size(); i++) {
+		if (indexes[i]->indexName == indexName) {
+			if (wal && !wal->commit()) {
+				Output::stream() << "!Failed to delete index "
+					 << indexName
+					 << " because the write-ahead log could not be synced." << endl;
+				return true;
 			}
-			if (i != rowNum - 1 && printLine)
-				outputFile << endl;
+			indexes.erase(indexes.begin() + i);
+			writeIndexes();
+			publish();
+			Output::stream() << "Index "
+				 << indexName
+				 << " deleted." << endl;
+			return true;
+		}
+	}
+	return false;
+}
+/*!
+ * \brief Index lookup for the Table class
+ *
+ * This function will find an index on a column that can answer a
+ * comparison. An equality is answered by a hash index, or else a tree
+ * index, and a range only by a tree index.
+ *
+ * \param[in] size_t col
+ *            Position of the column in the comparison
+ * \param[in] Predicate::Op op
+ *            Operator of the comparison
+ * \return const Index* index answering the comparison, null if there is none
+ */
+const Index *Table::findIndex(size_t col, Predicate::Op op) const {
+	const Index *hashIndex = nullptr; ///Hash index on the column
+	const Index *treeIndex = nullptr; ///Tree index on the column
+
+	for (const shared_ptr<Index> &tableIndex: indexes) {
+		if (tableIndex->colName == columns[col].colName) {
+			if (tableIndex->kind == Index::HASH_INDEX)
+				hashIndex = tableIndex.get();
 			else
-				printLine = true;
+				treeIndex = tableIndex.get();
 		}
-		outputFile.close();
 	}
+	if (op == Predicate::EQUAL && hashIndex != nullptr)
+		return hashIndex;
+	if (op == Predicate::NOT_EQUAL)
+		return nullptr;
+	return treeIndex;
+}
+/*!
+ * \brief Comparison evaluation for the Table class
+ *
+ * This function will find the rows of a column that compare to a value as
+ * given by the operator, through an index when one answers the comparison
+ * and otherwise by scanning the column a batch at a time.
+ *
+ * \param[in] size_t col
+ *            Position of the column in the comparison
+ * \param[in] Predicate::Op op
+ *            Operator of the comparison
+ * \param[in] Value value
+ *            Value parsed for the column
+ * \param[out] vector<size_t> rows
+ *             Rows matching the comparison in ascending order
+ */
+void Table::matchRows(size_t col, Predicate::Op op, const Value &value, vector<size_t> &rows) const {
+	uint64_t bits[Filter::BATCH_WORDS]; ///Rows of a batch matching the comparison
+
+	/** Use an index on the column when there is one **/
+	if (const Index *tableIndex = findIndex(col, op)) {
+		string key = Index::key(columns[col], value); ///Key of the value
+		if (op == Predicate::EQUAL) {
+			tableIndex->equal(key, rows);
+			return;
+		}
+		if (op == Predicate::GREATER || op == Predicate::GREATER_EQUAL)
+			tableIndex->greater(key, rows);
+		else
+			tableIndex->less(key, rows);
+		if (op == Predicate::GREATER_EQUAL || op == Predicate::LESS_EQUAL)
+			tableIndex->equal(key, rows);
+		sort(rows.begin(), rows.end());
+		return;
+	}
+
+	/** Scan the column a batch at a time otherwise **/
+	for (size_t first = 0; first < columns[col].size(); first += Filter::BATCH_ROWS) {
+		size_t count = min(Filter::BATCH_ROWS, columns[col].size() - first); ///Rows in the batch
+		Filter::compare(columns[col], first, count, op, value, bits);
+		Filter::appendRows(bits, first, count, rows);
+	}
+}
+/*!
+ * \brief Expression evaluation for the Table class
+ *
+ * This function will bind the expression to the columns of the table and
+ * find the rows it holds for. When every matching row must pass a
+ * comparison of a column with a literal that an index answers, the rows
+ * passing it are found through the index and only those rows are tested
+ * against the rest of the expression. Otherwise the whole expression is
+ * evaluated over the table a batch of rows at a time.
+ *
+ * \param[in] Expression *where
+ *            Expression selecting the rows, null for every row
+ * \param[in] string alias
+ *            Alias the expression may qualify columns with
+ * \param[out] vector<size_t> rows
+ *             Rows matching the expression in ascending order
+ * \param[in] size_t limit
+ *            Most rows found, the first ones in row order
+ * \return boolean false if the expression names an unknown column or has
+ *         a value that is not valid for its column
+ */
+bool Table::findRows(const Expression *where, const string &alias, vector<size_t> &rows, size_t limit) const {
+	Predicate predicate; ///Expression bound to the columns
+	size_t keyCol; ///Column of the comparison used to find the rows
+	Predicate::Op keyOp; ///Operator of the comparison used to find the rows
+	const Value *keyValue; ///Value of the comparison used to find the rows
+
+	rows.clear();
+	if (where == nullptr) {
+		for (size_t i = 0; i < rowNum && i < limit; i++)
+			rows.push_back(i);
+		return true;
+	}
+	if (!predicate.bind(*where, {Predicate::Source{tableName, alias, &columns}}))
+		return false;
+
+	/** Narrow the rows through an index before testing the whole expression **/
+	if (predicate.keyCondition(keyCol, keyOp, keyValue) && findIndex(keyCol, keyOp) != nullptr) {
+		matchRows(keyCol, keyOp, *keyValue, rows);
+		if (!predicate.single())
+			rows.erase(remove_if(rows.begin(), rows.end(),
+				[&predicate](size_t row) { return !predicate.test(row); }), rows.end());
+		if (rows.size() > limit)
+			rows.resize(limit);
+		return true;
+	}
+	predicate.select(rowNum, rows, limit);
+	return true;
+}
+/*!
+ * \brief Describe how the rows matching an expression are found
+ *
+ * This function will make the same choice as findRows without reading any
+ * row, for the plan printed by EXPLAIN.
+ *
+ * \param[in] Expression *where
+ *            Expression selecting the rows, null for every row
+ * \param[in] string alias
+ *            Alias the expression may qualify columns with
+ * \param[out] string access
+ *             Line of the plan reading the table
+ * \return boolean false if the expression names an unknown column or has
+ *         a value that is not valid for its column
+ */
+bool Table::describeAccess(const Expression *where, const string &alias, string &access) const {
+	Predicate predicate; ///Expression bound to the columns
+	size_t keyCol; ///Column of the comparison used to find the rows
+	Predicate::Op keyOp; ///Operator of the comparison used to find the rows
+	const Value *keyValue; ///Value of the comparison used to find the rows
+	const Index *index; ///Index answering the comparison
+
+	access = "SCAN " + tableName;
+	if (where == nullptr)
+		return true;
+	if (!predicate.bind(*where, {Predicate::Source{tableName, alias, &columns}}))
+		return false;
+	if (predicate.keyCondition(keyCol, keyOp, keyValue) && (index = findIndex(keyCol, keyOp)) != nullptr) {
+		access = "SEARCH " + tableName + " USING INDEX " + index->indexName + " (" + columns[keyCol].colName
+			+ " " + Predicate::opName(keyOp) + " ?)";
+		if (!predicate.single())
+			access += " AND FILTER";
+	}
+	else
+		access += " WITH BATCH FILTER";
+	return true;
 }
 /*!
  * \brief Method for the select table function
@@ -157,40 +1442,20 @@ void Table::writeTable(string path) {
  * This function will select the Table class. This function works by
  * reading out the individual settings of each column.
  *
+ * \param[in,out] ResultSink sink
+ *                Sink the rows are written to
  */
-void Table::select() {
-	bool firstInput = true; ///Boolean to adjust parser based on first input
-	string tempInput;
-	/** Iterate Through Each Column and Print **/
-	for (auto inputColumn: columns)
-	{
-		if (firstInput) ///Do not print dividers if first input
-			firstInput = false;
-		else ///Print dividers
-			cout << "|";
-		cout << inputColumn.colName << " " << inputColumn.colType;
-		/** If char print the column size **/
-		if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-			cout << "(" << inputColumn.colSize << ")";
-	}
-	cout << endl;
-	firstInput = true;
+void Table::select(ResultSink &sink) {
+	RowCursor cursor; ///Cursor handing out the values of each row
+
+	/** Print the header and each row straight from the columns **/
+	cursor.projectAll(columns);
+	sink.writeHeader(cursor);
 	for (size_t i = 0; i < rowNum; i++) {
-		for (auto outputCol: columns) {
-			if (firstInput) ///Do not print dividers if first input
-				firstInput = false;
-			else ///Print dividers
-				cout << "|";
-			tempInput = outputCol.colData[i];
-			if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-				tempInput.erase(0,1);
-				tempInput.pop_back();
-			}
-			cout << tempInput;
-		}
-		firstInput = true;
-		cout << endl;
+		cursor.seek(0, i);
+		sink.writeRow(cursor);
 	}
+	sink.finish();
 }
 /*!
  * \brief Method for the alter table function
@@ -198,195 +1463,193 @@ void Table::select() {
  * This function will alter a table in the internal table list and then
  * replicate this creation on a file level. This  function will create
  * a new column including a new name, type, and size and add it to the
- * existing table. If the command fails it outputs back to the main parser
- * as usual.
+ * existing table.
+ *
+ * \param[in] ColumnDef column
+ *            Definition of the added column
  *
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
  *         if the parser cannot interpret the error and will send true in case
  *         of a processed create command if it is created or not.
  */
-bool Table::alter() {
-	string input; ///String containing input from file
-	string newColName; ///String containing the columns name
-	string newColType; ///String containing the columns type
-	int newColSize; ///Int containing the column size if applicable
-
-	/** Receive and Check Input From User **/
-	cin >> newColName;
-	cin >> newColType;
-	if (newColType.back() != ';') ///Unknown command if no ";" at end of function
-		return false;
-
-	/** Process Input to Remove ";" **/
-	newColType.pop_back();
-
-	/** Check if token is of type char or varchar **/
-	if (newColType.substr(0, newColType.find('(')) == "char" ||
-		newColType.substr(0, newColType.find('(')) == "varchar") {
-		/** Process the token to get column type **/
-		input = newColType;
-		newColType = input.substr(0, input.find('('));
-		/** Process token to get the column size **/
-		input = input.substr(input.find('(') + 1);
-		input = input.substr(0, input.find(')'));
-		newColSize = stoi(input);
-	}
-	else if (newColType == "int" || newColType == "float")
-		newColSize = 0;
-	else ///If not valid error
-		return false;
-	/** Add Column onto Table **/
-	columns.push_back(Column(newColName, newColType, newColSize));
+bool Table::alter(const ColumnDef &column) {
+	/** Add Column onto Table with a default value for existing rows **/
+	columns.push_back(Column(column.name, column.type, column.size));
+	for (size_t i = 0; i < rowNum; i++)
+		columns.back().appendLiteral("");
 	/** Add Valid Path to Table **/
 	writeTable(tablePath);
-	cout << "Table "
+	publish();
+	Output::stream() << "Table "
 		 << tableName
 		 << " modified." << endl;
 	return true; ///Return true for end of processing
 }
 /*!
- * \brief Method for the insert table function
+ * \brief Method for storing inserted rows
  *
- * This function will insert into a table in the internal table list and then
- * replicate this creation on a file level. This  function will create
- * a new row including relevant information and add it to the
- * existing table. If the command fails it outputs back to the main parser
- * as usual.
+ * This function will parse each literal of the inserted rows against the
+ * type of its column and append the rows to the table. Every row is
+ * checked before anything is stored so a bad value leaves the table as it
+ * was and prints an error instead. The rows are logged as a single record,
+ * so a statement costs one write however many rows it holds.
+ *
+ * \param[in] vector<vector<string>> rows
+ *            Strings holding the value for each column in order, per row
  *
  * \return boolean true/false
  *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not.
+ *         if the number of values in a row does not match the number of columns.
  */
-bool Table::insert() {
-	string input; ///String containing input from file
-	bool firstInput = true; ///Bool checking if still on intial input
+bool Table::insertRows(const vector<vector<string>> &rows) {
+	vector<Value> values(rows.size() * columns.size()); ///Values parsed for each row and column
+	size_t first = rowNum; ///Position of the first inserted row
 
-	cin >> input;
-	if (input.back() == ';')
-		return insertLine(input);
-	/** Iterate through columns pushing information to each column **/
-	for (size_t i = 0; i < columns.size(); i++) {
-		if (!firstInput)
-			cin >> input; ///Get initial input
-		else
-			firstInput = false;
-		if (i == 0) ///Additional editing on first input
-		{
-			///Remove the "values(" in input
-			if (input.rfind("values(",0) != 0)
-				return false;
-			else {
-				input.erase(0, 7);
-				///After erasing at to column
-				if (input.back() != ',')
-					return false;
-				else {
-					input.pop_back();
-					columns[i].colData.push_back(input);
-				}
-			}
-		}
-		/** Additional editing if last input **/
-		else if (i == columns.size() - 1) {
-			///Check for the  ';' char
-			if (input.back() != ';') {
-				///Remove invalid data
-				for (size_t j = 0; j < i; j++)
-					columns[j].colData.pop_back();
-				return false;
-			}
-			else {
-				///Remove the ; and check for ')'
-				input.pop_back();
-				if (input.back() != ')') {
-					///Remove invalid data
-					for (size_t j = 0; j < i; j++)
-						columns[j].colData.pop_back();
-					return false;
-				}
-				else ///Add correct information to column
-				{
-					input.pop_back();
-					columns[i].colData.push_back(input);
-				}
-			}
-		}
-		/** Checking for standard ',' seperated input **/
-		else {
-			/** Check for ',' **/
-			if (input.back() != ',') {
-				///Remove invalid data
-				for (size_t j = 0; j < i; j++)
-					columns[j].colData.pop_back();
-				return false;
-			}
-			else ///Add correct information to column
-			{
-				input.pop_back();
-				columns[i].colData.push_back(input);
+	/** Check every value before storing the rows **/
+	for (size_t row = 0; row < rows.size(); row++) {
+		if (rows[row].size() != columns.size())
+			return false;
+		for (size_t i = 0; i < columns.size(); i++) {
+			Value &value = values[row * columns.size() + i]; ///Value parsed for the column
+			if (!columns[i].parse(rows[row][i], value) || !columns[i].fits(value)) {
+				Output::stream() << "!Failed to insert into table "
+					 << tableName
+					 << " because " << rows[row][i]
+					 << " is not a valid " << columns[i].colType << "." << endl;
+				return true;
 			}
 		}
 	}
-	/** Increase row amount and print output **/
-	rowNum++;
-	writeTable(tablePath);
-	cout << "1 new record inserted." << endl;
+	for (size_t row = 0; row < rows.size(); row++) {
+		for (size_t i = 0; i < columns.size(); i++)
+			columns[i].append(values[row * columns.size() + i]);
+	}
+
+	/** Index the rows, append them to the log, increase row amount and print output **/
+	rowNum += rows.size();
+	indexRows(first);
+	appendRows(first, rows.size());
+	publish();
+	if (rows.size() == 1)
+		Output::stream() << "1 new record inserted." << endl;
+	else
+		Output::stream() << rows.size() << " new records inserted." << endl;
 	return true; ///Return true for end of processing
 }
 /*!
- * \brief Method for the insert line function
+ * \brief Method for the copy from function
  *
- ** This function will insert into a table in the internal table list and then
- * replicate this creation on a file level. This  function will create
- * a new row including relevant information and add it to the
- * existing table. If the command fails it outputs back to the main parser
- * as usual. This functions different from the insert function due to the
- * parser syntax used.
+ * This function will load the rows of a CSV or TSV file into the table.
+ * The file is mapped and parsed in parallel chunks straight into columns,
+ * and the table is written once at the end instead of logging every row.
+ * Inside a transaction the rows are logged as one record instead, since
+ * the table file must only hold committed rows. Every row is checked before anything is stored so a bad row leaves the
+ * table as it was and prints an error naming its line instead.
  *
- * \param[in] string input
- *            String corresponding to the token input found in orginal
- *            insert parser.
+ * \param[in] string path
+ *            String holding the path of the data file
+ * \param[in] char delimiter
+ *            Character separating the fields of a row
  *
- * \return boolean true/false
- *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not. This function
- *         will additionally detect if the user is selecting all or selecting a
- *         particular column and direct to the correct function.
- */
-bool Table::insertLine (string input) {
-	/** Remove 'values(' in string **/
-	if (input.find("values(") != string::npos)
-		input = input.substr(input.find('(') + 1);
+ * \return boolean true for end of processing
+ */
+bool Table::copyFrom(const string &path, char delimiter) {
+	CsvLoader loader(columns, delimiter); ///Loader parsing the file
+	size_t first = rowNum; ///Position of the first copied row
+
+	/** Map the file, an empty file holds no rows **/
+	if (!fs::is_regular_file(path)) {
+		Output::stream() << "!Failed to copy into table "
+			 << tableName
+			 << " because " << path
+			 << " does not exist." << endl;
+		return true;
+	}
+	MappedFile dataFile(path); ///Mapping of the data file
+	if (dataFile.isOpen() && !loader.parse(dataFile.data(), dataFile.size())) {
+		Output::stream() << "!Failed to copy into table "
+			 << tableName
+			 << " because ";
+		if (loader.failedColumn < 0)
+			Output::stream() << "line " << loader.failedLine
+				 << " does not have " << columns.size() << " values." << endl;
+		else
+			Output::stream() << loader.failedField
+				 << " on line " << loader.failedLine
+				 << " is not a valid " << columns[loader.failedColumn].colType << "." << endl;
+		return true;
+	}
+
+	/** Store the rows and index them **/
+	loader.appendTo(columns);
+	rowNum += loader.rowCount();
+	indexRows(first);
+
+	/** Write the table once, or log the rows if a transaction may still undo them, and print output **/
+	if (rowNum > first && transaction != nullptr)
+		appendRows(first, rowNum - first);
+	else if (rowNum > first)
+		writeTable(tablePath);
+	publish();
+	if (rowNum - first == 1)
+		Output::stream() << "1 new record inserted." << endl;
 	else
-		return false;
-	/** Iterate through columns pushing information to each column **/
-	for (size_t i = 0; i < columns.size(); i++) {
-		if (input.find(',') != string::npos) {
-			columns[i].colData.push_back(input.substr(0,input.find(',')));
-			input = input.substr(input.find(',')+1);
-		}
+		Output::stream() << rowNum - first << " new records inserted." << endl;
+	return true; ///Return true for end of processing
+}
+/*!
+ * \brief Appended row indexer for the Table class
+ *
+ * This function will add the rows appended to the table to every index,
+ * building an index again in bulk when most of its rows are new. Inserts,
+ * copies and replayed insert records all index their rows here.
+ *
+ * \param[in] size_t first
+ *            Position of the first appended row
+ */
+void Table::indexRows(size_t first) {
+	ownIndexes();
+	for (const shared_ptr<Index> &tableIndex: indexes) {
+		const Column &indexed = columns[findColumn(tableIndex->colName)]; ///Column of the index
+		if (rowNum - first > first)
+			tableIndex->build(indexed);
 		else {
-			input.pop_back();
-			if(input.back() != ')') {
-				///Remove invalid data
-				for (size_t j = 0; j < i; j++)
-					columns[j].colData.pop_back();
-				return false;
-			}
-			else {
-				input.pop_back();
-				columns[i].colData.push_back(input);
-			}
+			for (size_t row = first; row < rowNum; row++)
+				tableIndex->insert(Index::key(indexed, row), row);
+		}
+	}
+}
+/*!
+ * \brief Column assigner for the Table class
+ *
+ * This function will set rows of a column to a value and move them to the
+ * key of the value in every index on the column. Updates and replayed
+ * update records both change their rows here.
+ *
+ * \param[in] size_t col
+ *            Position of the changed column
+ * \param[in] vector<size_t> rows
+ *            Changed rows in ascending order
+ * \param[in] Value value
+ *            Value parsed for the column
+ */
+void Table::assignRows(size_t col, const vector<size_t> &rows, const Value &value) {
+	ownIndexes();
+	for (const shared_ptr<Index> &tableIndex: indexes) {
+		if (tableIndex->colName == columns[col].colName) {
+			for (size_t row: rows)
+				tableIndex->erase(Index::key(columns[col], row), row);
+		}
+	}
+	columns[col].assign(rows, value);
+	for (const shared_ptr<Index> &tableIndex: indexes) {
+		if (tableIndex->colName == columns[col].colName) {
+			string key = Index::key(columns[col], value); ///Key of the value
+			for (size_t row: rows)
+				tableIndex->insert(key, row);
 		}
 	}
-	/** Increase row amount and print output **/
-	rowNum++;
-	writeTable(tablePath);
-	cout << "1 new record inserted." << endl;
-	return true; ///Return true for end of processing
 }
 /*!
  * \brief Method for the update table function
@@ -394,76 +1657,56 @@ bool Table::insertLine (string input) {
  * This function will update the table in the internal table list and then
  * replicate this update on a file level. This  function will edit
  * an existing row including chosen information and add it to the
- * existing table. If the command fails it outputs back to the main parser
- * as usual.
+ * existing table. The matching rows are found through an index on the
+ * where column if there is one, and the change is appended to the write-ahead log,
+ * so an update costs the rows it changes rather than the size of the table.
+ *
+ * \param[in] string setName
+ *            String holding the name of the changed column
+ * \param[in] string setValue
+ *            String holding the literal the column is set to
+ * \param[in] Expression where
+ *            Expression selecting the changed rows
  *
  * \return boolean true/false
- *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not.
+ *         True or false value depending on state of function. False sent if
+ *         the parser cannot interpret the error or the where expression names
+ *         an unknown column or has a value that is not valid for its column,
+ *         and true in case of a processed update whether rows changed or not.
  */
-bool Table::update() {
-	string setName; ///String holds the name of what value will be set
-	string whereName; ///String holds the name of where the value will be set
-	string setValue; ///String Holds the value of the information after the change
-	string whereValue; ///String Holds the value of the information to change or compare
-	string input; ///String holds all input
+bool Table::update(const string &setName, const string &setValue, const Expression &where) {
 	int recordCount = 0; ///Int holds the number of records changed
+	Value setParsed; ///Value holds the set value parsed for its column
+	vector<size_t> rows; ///Holds the rows that match the where expression
 
-	/** Get Set Input From User **/
-	cin >> input;
-	if (input != "set") ///Unknown command if no "set"
+	/** Find the rows that match the where expression, failing like a select on an unknown column or invalid value **/
+	if (!findRows(&where, "", rows))
 		return false;
-	cin >> setName;
-	cin >> input;
-	if (input != "=") ///Unknown command if no '='
-		return false;
-	cin >> setValue;
 
-	/** Get Where Input From User **/
-	cin >> input;
-	if (input != "where") ///Unknown command if no "where
-		return false;
-	cin >> whereName;
-	cin >> input;
-	if (input != "=") ///Unknown command if no "="
-		return false;
-	cin >> whereValue;
-	if (whereValue.back() != ';') ///Unknown command if no ";" at end of function
-		return false;
-
-	/** Process Input to Remove ";" **/
-	whereValue.pop_back();
-
-	/** Go through table looking for values and replacing as nessecary **/
-	for (size_t i = 0; i < columns.size(); i++) ///Go through each column
-	{
-		if (columns[i].colName == whereName) ///Continue search if column name matches
-		{
-			for (size_t j = 0; j < columns[i].colData.size(); j++) ///Go through each row
-			{
-				if (columns[i].colData[j] == whereValue) ///Change if column value matches
-				{
-					/** Go Through Each Column Changing Value If Matching and Increase Count **/
-					for (size_t k = 0; k < columns.size(); k++){
-						if (columns[k].colName == setName) {
-							columns[k].colData[j] = setValue;
-							recordCount++;
-						}
-					}
-				}
+	/** Go Through Each Column Changing Value If Matching and Increase Count **/
+	for (size_t k = 0; k < columns.size(); k++) {
+		if (columns[k].colName == setName) {
+			if (!columns[k].parse(setValue, setParsed) || !columns[k].fits(setParsed)) {
+				Output::stream() << "!Failed to update table "
+					 << tableName
+					 << " because " << setValue
+					 << " is not a valid " << columns[k].colType << "." << endl;
+				return true;
 			}
+			assignRows(k, rows, setParsed);
+			/** Log the changed rows instead of rewriting the table **/
+			if (!rows.empty())
+				appendUpdate(k, setValue, rows);
+			recordCount += rows.size();
 		}
 	}
 
-	/** Rewrite Table **/
-	writeTable(tablePath);
-
 	/** Print Output **/
+	publish();
 	if (recordCount == 1)
-		cout << "1 record modified." << endl;
+		Output::stream() << "1 record modified." << endl;
 	else
-		cout << recordCount << " records modified." << endl;
+		Output::stream() << recordCount << " records modified." << endl;
 
 	return true; ///Return true for end of processing
 }
@@ -473,239 +1716,163 @@ bool Table::update() {
  * This function will delete from the table in the internal table list and then
  * replicate this update on a file level. This  function will delete
  * an existing row based on chosen information and remove it from the
- * existing table. If the command fails it outputs back to the main parser
- * as usual.
+ * existing table. The removed rows are logged rather than rewriting the
+ * table file.
+ *
+ * \param[in] Expression where
+ *            Expression selecting the removed rows
  *
  * \return boolean true/false
- *         True or false value depending on state of function. False only sent
- *         if the parser cannot interpret the error and will send true in case
- *         of a processed create command if it is created or not.
+ *         True or false value depending on state of function. False sent if
+ *         the parser cannot interpret the error or the where expression names
+ *         an unknown column or has a value that is not valid for its column,
+ *         and true in case of a processed delete whether rows were removed or not.
  */
-bool Table::deleteFrom() {
-	string whereName; ///String holds the name of where the value will be set
-	string whereValue; ///String Holds the value of the information to change or compare
-	char deleteType; ///Char holds the type of information deleted
-	string input; ///String holds all input
-	int deleteHere = -1; ///Int holds the index of a deleted row
+bool Table::deleteFrom(const Expression &where) {
 	int recordCount = 0; ///Holds the number of records
-	bool deleted = false; ///Holds if something has been deleted
+	vector<size_t> rows; ///Holds the rows that match the expression
+	vector<bool> erased(rowNum, false); ///Holds the rows selected for removal
 
-	/** Get Input **/
-	cin >> input;
-	if (input != "where") ///Unknown command if no "where"
+	/** Evaluate the expression once to select the rows to delete, failing like a select on an unknown column or invalid value **/
+	if (!findRows(&where, "", rows))
 		return false;
-	cin >> whereName;
-	cin >> deleteType;
-	cin >> whereValue;
-	if (whereValue.back() != ';') ///Unknown command if no ";" at end of function
-		return false;
-
-	/** Process Input to Remove ";" **/
-	whereValue.pop_back();
-
-	/** Loop through the system deleting rows when information matches **/
-	do {
-		deleted = false; ///Reset the deleted row status
-		/** Loop through each column **/
-		for (size_t i = 0; i < columns.size(); i++){
-			/** Go to column if name matches **/
-			if (columns[i].colName == whereName) {
-				/** Go through each row **/
-				for (size_t j = 0; j < columns[i].colData.size(); j++){
-					/** Switch based on the delete type **/
-					if (deleteType == '=') {
-						/** Change index and status if a delete row is found **/
-						if (columns[i].colData[j] != "ERASE") {
-							if (columns[i].colData[j] == whereValue) {
-								deleteHere = j;
-								deleted = true;
-								break;
-							}
-						}
-					}
-					/** Change index and status if a delete row is found **/
-					else if (deleteType == '>') {
-						if (columns[i].colData[j] != "ERASE") {
-							if (stof(columns[i].colData[j]) > stof(whereValue)) {
-								deleteHere = j;
-								deleted = true;
-								break;
-							}
-						}
- 					}
-				}
-			}
-		}
-		/** If deleted go through row and change value to "ERASE" and increase count**/
-		if (deleted) {
-			for (size_t i = 0; i < columns.size(); i++) {
-				columns[i].colData[deleteHere] = "ERASE";
-			}
-			recordCount++;
-		}
-	} while (deleted); ///Loop as long as something deletable is found to get all
+	for (size_t row: rows)
+		erased[row] = true;
+	recordCount = rows.size();
 
-	/**Rewrite table and reread into system after a delete **/
-	rowAdjust = recordCount;
-	writeTable(tablePath);
-	reInput();
+	/** Remove the selected rows in place and log them instead of rewriting the table **/
+	if (recordCount > 0) {
+		eraseRows(erased);
+		appendDelete(rows);
+		publish();
+	}
 
 	/** Output information **/
 	if (recordCount == 1)
-		cout << "1 record deleted." << endl;
+		Output::stream() << "1 record deleted." << endl;
 	else
-		cout << recordCount << " records deleted." << endl;
+		Output::stream() << recordCount << " records deleted." << endl;
 	return true; ///Return true for end of processing
 }
 /*!
- * \brief Reinput Method for the Table class
+ * \brief Row removal method for the Table class
  *
- * This function will rewrite the Table class to the database. This
- * function works similar to the Constructor excepts it is rereading from files
- * with an existing database. The function utilizes the sizes of the
- * existing row and column lists to provide it for the next constructing
- * of the database objects.
+ * This function will remove every row selected in the bitmap from each
+ * column, compacting the columns in place in a single pass. The indexes
+ * are renumbered to match.
  *
+ * \param[in] vector<bool> erased
+ *            Bitmap holding true for each row to remove
  */
-void Table::reInput() {
-	rowAdjust = 0; ///Resets the adjustment amount
-	columns.clear(); ///Erases all columns in system
-
-	string input; ///String containing input from file
-	string newColName; ///String containing the columns name
-	string newColType; ///String containing the columns type
-	int newColSize; ///Int containing the column size if applicable
-	size_t colNum; ///Int containing the number of columns
-
-	/** Create ifstream based on the path parameter **/
-	ifstream inputFile(tablePath);
-
-	/** Check if the file exists and open **/
-	if(inputFile.is_open()){
-		/** Get column and row size from file **/
-		inputFile >> colNum;
-		inputFile >> rowNum;
-		/** Input column settings based on number of columns **/
-		for (size_t i = 0; i < colNum; i++) {
-			inputFile >> newColName;
-			inputFile >> newColType;
-				/** Input the individual size of a column if applicable **/
-				if (newColType == "char" || newColType == "varchar") {
-					inputFile >> newColSize;
-				}
-				else ///Set the column size to 0 if an int or float
-					newColSize = 0;
-	            /** Construct a new column and add to list from settings **/
-				columns.push_back(Column(newColName, newColType, newColSize));
-			}
-	        /** Get column information based on the row number **/
-			for (size_t i = 0; i < rowNum; i++) {
-	            /**Go through each column pushing info for each row **/
-				for (size_t j = 0; j < colNum; j++) {
-					inputFile >> input;
-					columns[j].colData.push_back(input);
-				}
-			}
-			/** Close file **/
-			inputFile.close();
-		}
+void Table::eraseRows(const vector<bool> &erased) {
+	for (Column &tableColumn: columns)
+		tableColumn.compact(erased);
+	ownIndexes();
+	for (const shared_ptr<Index> &tableIndex: indexes)
+		tableIndex->eraseRows(erased);
+	rowNum -= count(erased.begin(), erased.end(), true);
 }
 /*!
  * \brief Method for the select types table function
  *
  * This function will select the Table class. This function works by
  * reading out the individual settings of each column that is specified
- * by a passed type.
+ * by a passed type, for the rows matching an optional expression. The
+ * rows are printed in the order of the ORDER BY columns, or in row order
+ * without one, in which case the scan stops once the limit is found.
  *
  * \param[in] vector <string> types
- *            Strings holding the names of columns to print
- */
-bool Table::selectTypes(vector <string> types) {
-	bool firstInput = true; ///Boolean to adjust parser based on first input
-	bool printed = false; ///Boolean holding if something has been printed yet
-	bool printColumn = false; ///Boolean holding if a column should be printed
-	string input; ///String holds all input
-	string tempInput; ///String Temporary input to adjust for char printing
-	string whereName; ///String Name of where information should print
-	string selectType; ///String Holds what type of comparision to make
-	string whereValue; ///String Holds value to compare to
-	int whereIndex; ///Holds index of where a value has been found
-
-	/** Get Input **/
-	cin >> input;
-	if (input != "where") ///Unknown command if no "where"
-		return false;
-	cin >> whereName;
-	cin >> selectType;
-	cin >> whereValue;
-
-	if (whereValue.back() != ';') ///Unknown command if no ";" at end of function
-		return false;
-
-	/** Process Input to Remove ";" **/
-	whereValue.pop_back();
+ *            Strings holding the names of columns to print, empty for all
+ * \param[in] Expression *where
+ *            Expression selecting the printed rows, null for every row
+ * \param[in] string alias
+ *            Alias the expression may qualify columns with
+ * \param[in] vector<OrderItem> orderBy
+ *            Columns the rows are ordered by, empty for row order
+ * \param[in] size_t limit
+ *            Most rows printed
+ * \param[in,out] ResultSink sink
+ *                Sink the rows are written to
+ *
+ * \return boolean true/false
+ *         False if the expression or the order names an unknown column or
+ *         the expression has an invalid value
+ */
+bool Table::selectTypes(const vector <string> &types, const Expression *where, const string &alias,
+	const vector<OrderItem> &orderBy, size_t limit, ResultSink &sink) {
+	RowCursor cursor; ///Cursor handing out the values of the selected columns
+	vector<size_t> rows; ///Holds the rows matching the expression
+	Sorter sorter; ///Order of the printed rows
 
-	/**Go through each column to get index of matching name **/
-	for (size_t i = 0; i < columns.size(); i++) {
-		if (columns[i].colName == whereName)
-			whereIndex = i;
+	/** Find the ordered columns, which need not be printed **/
+	for (const OrderItem &order: orderBy) {
+		int col = order.item.function.empty() ? findColumn(order.item.column) : -1; ///Position of the column
+		if (col == -1)
+			return false;
+		sorter.addKey(columns[col], order.descending);
 	}
 
-	/** Iterate Through Each Column and Print **/
-	for (auto inputColumn: columns) {
-		for (size_t i = 0; i < types.size(); i++) {
-			if (types[i] == inputColumn.colName) ///Print only columns of matching name
-				printColumn = true;
-		}
-		if (printColumn) ///Print only if a printable column
-		{
-			if (firstInput) ///Do not print dividers if first input
-				firstInput = false;
-			else ///Print dividers
-				cout << "|";
-			cout << inputColumn.colName << " " << inputColumn.colType;
-			/** If char print the column size **/
-			if (inputColumn.colType == "char" || inputColumn.colType == "varchar")
-				cout << "(" << inputColumn.colSize << ")";
-			printColumn = false; ///Reset print status
-		}
+	/** Get the rows matching the expression, only the first ones without an order **/
+	if (!findRows(where, alias, rows, orderBy.empty() ? limit : SelectStatement::NO_LIMIT))
+		return false;
+
+	/** Iterate Through Each Column and Project the Printed Ones **/
+	for (const Column &inputColumn: columns) {
+		if (types.empty() || find(types.begin(), types.end(), inputColumn.colName) != types.end())
+			cursor.project(inputColumn); ///Add the column to the printed row
 	}
 
-	cout << endl;
-	firstInput = true; ///Reset first input status
+	/** Print the header and each matching row **/
+	auto writeRow = [&cursor, &sink](size_t row) { cursor.seek(0, row); sink.writeRow(cursor); };
+	sink.writeHeader(cursor);
+	if (orderBy.empty())
+		for_each(rows.begin(), rows.end(), writeRow);
+	else if (!sorter.sort(&rows, rows.size(), limit, writeRow))
+		Output::stream() << "!Failed to order the rows because a temporary file could not be written." << endl;
+	sink.finish();
+	return true; ///Return a sucessful print
+}
+/*!
+ * \brief Method for the aggregate table function
+ *
+ * This function will list the aggregates of the rows matching an optional
+ * expression, one row per group of the GROUP BY columns. Without an
+ * expression the aggregates read the whole columns without a row list.
+ *
+ * \param[in] vector<SelectItem> items
+ *            Selected columns and aggregates in order
+ * \param[in] vector<string> groupBy
+ *            Names of the GROUP BY columns
+ * \param[in] Expression *where
+ *            Expression selecting the aggregated rows, null for every row
+ * \param[in] string alias
+ *            Alias the expression may qualify columns with
+ * \param[in] vector<OrderItem> orderBy
+ *            Selected columns and aggregates the groups are ordered by
+ * \param[in] size_t limit
+ *            Most groups printed
+ * \param[in,out] ResultSink sink
+ *                Sink the rows are written to
+ *
+ * \return boolean true/false
+ *         False if a column is unknown, a plain column is not grouped, a
+ *         char column is summed, the order is not selected or the
+ *         expression is not valid
+ */
+bool Table::aggregate(const vector<SelectItem> &items, const vector<string> &groupBy, const Expression *where,
+	const string &alias, const vector<OrderItem> &orderBy, size_t limit, ResultSink &sink) {
+	Aggregation aggregation(columns); ///Aggregates of the table
+	vector<size_t> rows; ///Holds the rows matching the expression
 
-	/** Iterate Through Each Row and Print **/
-	for (size_t i = 0; i < rowNum; i++) {
-		for (auto outputCol: columns) {
-			for (size_t i = 0; i < types.size(); i++) {
-				if (types[i] == outputCol.colName) ///Print only columns of matching name
-					printColumn = true;
-			}
-			if (printColumn) ///Print only if a printable column
-			{
-				if (firstInput && !printed) ///Do not print dividers if first input
-					firstInput = false;
-				else if (printed)///Print dividers
-					cout << "|";
-				/** Adjust printout if the column is of type char or varchar **/
-				tempInput = outputCol.colData[i];
-				if (outputCol.colType == "char" || outputCol.colType == "varchar") {
-					tempInput.erase(0,1);
-					tempInput.pop_back();
-				}
-				/** Print based on the print type, can be changed in future interations **/
-				if (stoi(columns[whereIndex].colData[i]) != stoi(whereValue)) {
-					cout << tempInput;
-					printed = true; ///Change status to printed if something has passed
-				}
-				printColumn = false; ///Reset printColumn status
-			}
-		}
-		if (printed) ///Only print an endl if something was printed in that row
-			cout << endl;
-		/** Reset variables for a new row **/
-		printed = false;
-		firstInput = true;
+	if (!aggregation.bind(items, groupBy, orderBy))
+		return false;
+	if (where != nullptr) {
+		if (!findRows(where, alias, rows))
+			return false;
+		aggregation.run(&rows, rowNum);
 	}
-	return true; ///Return a sucessful print
+	else
+		aggregation.run(nullptr, rowNum);
+	aggregation.write(sink, limit);
+	return true;
 }
@@ -0,0 +1,135 @@
+/*!
+ * \file Transaction.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the Transaction class. A transaction
+ * only buffers the records of its changes, the changes themselves are
+ * made to the tables as the statements run.
+ *
+ */
+
+#include "../include/Transaction.h"
+#include "../include/Table.h"
+
+///std name space for general use
+using namespace std;
+
+/*!
+ * \brief Constructor of the Transaction class
+ *
+ * A new transaction holds no changes.
+ *
+ */
+Transaction::Transaction() {
+
+}
+/*!
+ * \brief Deconstructor of the Transaction class
+ *
+ * This function will deconstruct the Transaction class. Changes still held
+ * are dropped without being logged.
+ *
+ */
+Transaction::~Transaction() {
+
+}
+/*!
+ * \brief Hold back the record of a change
+ *
+ * \param[in] Table table
+ *            Changed table
+ * \param[in] WriteAheadLog::Kind kind
+ *            Change held by the record
+ * \param[in] string payload
+ *            Encoded change
+ */
+void Transaction::log(Table &table, WriteAheadLog::Kind kind, const string &payload) {
+	changes.push_back(Change{&table, kind, payload});
+}
+/*!
+ * \brief Lock a table for the transaction
+ *
+ * The table holds its changes back for the transaction, and no other
+ * session may change it, until the transaction ends. The rows are loaded
+ * first and a snapshot of them kept as the image a rollback puts back.
+ *
+ * \param[in,out] Table table
+ *                Table about to be changed
+ */
+void Transaction::lock(Table &table) {
+	if (table.transaction == this)
+		return;
+	table.load();
+	table.transaction = this;
+	tables.push_back(&table);
+	images.push_back(table.makeView(true));
+}
+/*!
+ * \brief Commit the transaction
+ *
+ * This function will write every held record to the log in the order the
+ * changes were made and sync the log once for all of them. Several records
+ * are written between a begin record and a commit record carrying the
+ * number of the begin record, so a crash part way through leaves records
+ * that are not replayed. Only once the
+ * records are on disk are the tables unlocked and their rows published to
+ * the readers of other sessions. If a record cannot be written or the sync
+ * fails, the records are taken back out of the log and the transaction is
+ * rolled back, so no session ever reads changes that could be lost.
+ *
+ * \param[in,out] WriteAheadLog wal
+ *                Log of the database the tables belong to
+ * \return boolean true if the changes are on disk, false if they were rolled back
+ */
+bool Transaction::commit(WriteAheadLog &wal) {
+	size_t mark = wal.size(); ///Length of the log before the records
+	uint64_t markLsn = wal.lastLsn(); ///Sequence number of the last record before the records
+	vector<uint64_t> lsns; ///Sequence number of each record
+	uint64_t begin = 0; ///Number of the begin record, 0 for a single record
+	bool written = true; ///Bool if every record reached the log
+
+	if (changes.size() > 1)
+		written = (begin = wal.append(WriteAheadLog::BEGIN_TRANSACTION, "", "")) != 0;
+	for (size_t i = 0; written && i < changes.size(); i++) {
+		lsns.push_back(wal.append(changes[i].kind, changes[i].table->lowerName, changes[i].payload));
+		written = lsns.back() != 0;
+	}
+	if (written && begin != 0)
+		written = wal.append(WriteAheadLog::COMMIT_TRANSACTION, "",
+			string(reinterpret_cast<const char *>(&begin), sizeof(begin))) != 0;
+	if (!written || !wal.commit()) {
+		wal.truncate(mark, markLsn);
+		rollback();
+		return false;
+	}
+	for (size_t i = 0; i < changes.size(); i++)
+		changes[i].table->lastLsn = lsns[i];
+	changes.clear();
+	for (Table *lockedTable: tables) {
+		lockedTable->transaction = nullptr;
+		lockedTable->publish();
+	}
+	tables.clear();
+	images.clear();
+	return true;
+}
+/*!
+ * \brief Roll back the transaction
+ *
+ * This function will drop the held records, unlock the tables and put
+ * back the image of each, which leaves it as the last commit made it.
+ *
+ */
+void Transaction::rollback() {
+	changes.clear();
+	for (size_t i = 0; i < tables.size(); i++) {
+		tables[i]->transaction = nullptr;
+		tables[i]->revert(*images[i]);
+	}
+	tables.clear();
+	images.clear();
+}
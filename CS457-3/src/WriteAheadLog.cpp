@@ -0,0 +1,439 @@
+/*!
+ * \file WriteAheadLog.cpp
+ *
+ * \author Christopher Mollise
+ * \date 5/6/2020
+ *
+ * Project 3 for CS457
+ *
+ * This file is implementation for the WriteAheadLog class. The log is a
+ * file in the database directory starting with a header that holds the
+ * sequence number the log starts from, followed by the records in the
+ * order they were made. A record is read back only if it is whole and
+ * passes its checksum, so a record torn by a crash ends the log. The
+ * records of a transaction sit between a begin and a commit record and are
+ * read back only once its commit record is, so a transaction torn by a
+ * crash is dropped whole.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "../include/WriteAheadLog.h"
+#include "../include/Output.h"
+
+///std name space for general use
+using namespace std;
+
+/// Magic bytes at the start of every write-ahead log
+static const char LOG_MAGIC[8] = {'C', 'S', '4', '5', '7', 'W', 'A', 'L'};
+/// Version of the log format written by this program
+static const uint32_t LOG_VERSION = 2;
+
+/*!
+ * \struct LogFileHeader
+ *
+ * \brief Fixed header at the start of a write-ahead log
+ */
+struct LogFileHeader {
+	char magic[8]; ///Bytes identifying a write-ahead log
+	uint32_t version; ///Version of the log format
+	uint32_t reserved; ///Unused, written as zero
+	uint64_t firstLsn; ///Sequence number the records of the log start from
+};
+
+/*!
+ * \struct LogRecordHeader
+ *
+ * \brief Header in front of every record of the log
+ *
+ * The header is followed by the sequence number and kind of the record,
+ * the length prefixed name of its table and its payload. The checksum
+ * covers those bytes so a record torn by a crash is detected.
+ */
+struct LogRecordHeader {
+	uint32_t length; ///Number of bytes following the header
+	uint32_t checksum; ///Checksum of the bytes following the header
+};
+
+/*!
+ * \brief Constructor of the WriteAheadLog class
+ *
+ * The log is not read or opened until open is called.
+ *
+ * \param[in] string newPath
+ *            String corresponding to the path of the log
+ */
+WriteAheadLog::WriteAheadLog(string newPath) : path(newPath) {
+	fileDescriptor = -1;
+	nextLsn = 1;
+	bytes = 0;
+	unsynced = 0;
+}
+/*!
+ * \brief Deconstructor of the WriteAheadLog class
+ *
+ * This function will sync the records not committed yet and close the log.
+ *
+ */
+WriteAheadLog::~WriteAheadLog() {
+	commit();
+	if (fileDescriptor >= 0)
+		::close(fileDescriptor);
+}
+/*!
+ * \brief Log reader for the WriteAheadLog class
+ *
+ * This function will read back every complete record of the log and open
+ * it for appending. Reading stops at the first record that is cut short,
+ * fails its checksum or is out of sequence, and the log is truncated there
+ * so later records follow the last good one. The records of a transaction
+ * missing its commit record are truncated with it. A missing log is created.
+ *
+ * \param[in] uint64_t after
+ *            Highest sequence number held by a table file, new records are numbered past it
+ * \param[out] vector<Record> records
+ *             Records read back in the order they were made
+ * \return boolean true if the log could be opened for appending
+ */
+bool WriteAheadLog::open(uint64_t after, vector<Record> &records) {
+	uint64_t lastLsn; ///Sequence number of the last record kept
+	size_t logBytes; ///Length of the log as found
+	size_t validBytes = scan(records, lastLsn, logBytes); ///Length of the log up to the last good record
+
+	if (validBytes == 0 && logBytes >= sizeof(LogFileHeader))
+		Output::stream() << "!Failed to read write-ahead log " << path << "." << endl;
+	nextLsn = max(after, lastLsn) + 1;
+
+	/** Open the log, starting it over without a good header or cutting off a torn record **/
+	if (fileDescriptor >= 0)
+		::close(fileDescriptor);
+	fileDescriptor = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (fileDescriptor < 0) {
+		Output::stream() << "!Failed to open write-ahead log " << path << "." << endl;
+		return false;
+	}
+	bytes = validBytes;
+	unsynced = 0;
+	if (validBytes == 0)
+		return reset();
+	if (validBytes < logBytes && (ftruncate(fileDescriptor, validBytes) != 0 || fdatasync(fileDescriptor) != 0)) {
+		Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		return false;
+	}
+	return true;
+}
+/*!
+ * \brief Record writer for the WriteAheadLog class
+ *
+ * This function will number a change and write it at the end of the log.
+ * The record is not synced until commit, which the caller runs between
+ * statements, so a sync never lands part way through the records of one
+ * statement or transaction. A record that cannot be written is cut back
+ * off the log and uses up no sequence number.
+ *
+ * \param[in] Kind kind
+ *            Change held by the record
+ * \param[in] string table
+ *            Lowercase name of the changed table
+ * \param[in] string payload
+ *            Encoded change
+ * \return uint64_t sequence number of the record, 0 if it could not be written
+ */
+uint64_t WriteAheadLog::append(Kind kind, const string &table, const string &payload) {
+	LogRecordHeader header; ///Header of the record
+	uint64_t lsn = nextLsn; ///Sequence number of the record
+	uint32_t kindValue = kind; ///Kind of the record as stored
+	uint32_t nameLength = table.size(); ///Length of the table name
+	string record(sizeof(header), '\0'); ///Encoded record behind room for its header
+
+	record.reserve(sizeof(header) + sizeof(lsn) + sizeof(kindValue) + sizeof(nameLength) + table.size() + payload.size());
+	record.append(reinterpret_cast<const char *>(&lsn), sizeof(lsn));
+	record.append(reinterpret_cast<const char *>(&kindValue), sizeof(kindValue));
+	record.append(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+	record.append(table);
+	record.append(payload);
+	header.length = record.size() - sizeof(header);
+	header.checksum = checksum(record.data() + sizeof(header), header.length);
+	memcpy(&record[0], &header, sizeof(header));
+
+	if (!writeAll(record)) {
+		Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		if (fileDescriptor >= 0 && ftruncate(fileDescriptor, bytes) != 0)
+			Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		return 0;
+	}
+	nextLsn++;
+	return lsn;
+}
+/*!
+ * \brief Group commit for the WriteAheadLog class
+ *
+ * This function will sync every record written since the last commit in
+ * one call, making the changes of all their statements durable together.
+ *
+ * \return boolean true if every record written is on disk
+ */
+bool WriteAheadLog::commit() {
+	if (unsynced == 0)
+		return true;
+	if (fileDescriptor < 0 || fdatasync(fileDescriptor) != 0) {
+		Output::stream() << "!Failed to sync write-ahead log " << path << "." << endl;
+		return false;
+	}
+	unsynced = 0;
+	return true;
+}
+/*!
+ * \brief Record removal for the WriteAheadLog class
+ *
+ * This function will cut the log back to a length it had before, taking
+ * back the records written since, and number the next record after the
+ * last one kept. The cut is synced so the records do not come back after
+ * a crash. It is called when the records of a transaction could not be
+ * written or synced.
+ *
+ * \param[in] size_t length
+ *            Length of the log before the records taken back
+ * \param[in] uint64_t lastKept
+ *            Sequence number of the last record kept
+ * \return boolean true if the shorter log is on disk
+ */
+bool WriteAheadLog::truncate(size_t length, uint64_t lastKept) {
+	if (fileDescriptor < 0 || ftruncate(fileDescriptor, length) != 0 || fdatasync(fileDescriptor) != 0) {
+		Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		return false;
+	}
+	unsynced = 0;
+	bytes = length;
+	nextLsn = lastKept + 1;
+	return true;
+}
+/*!
+ * \brief Log truncation for the WriteAheadLog class
+ *
+ * This function will empty the log, leaving a header that starts the next
+ * record past the last one. It is called once every table file holds the
+ * changes of the records, after those files have been synced.
+ *
+ * \return boolean true if the empty log is on disk
+ */
+bool WriteAheadLog::reset() {
+	LogFileHeader header; ///Header of the empty log
+
+	memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+	header.version = LOG_VERSION;
+	header.reserved = 0;
+	header.firstLsn = nextLsn;
+	if (fileDescriptor < 0 || ftruncate(fileDescriptor, 0) != 0) {
+		Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		return false;
+	}
+	bytes = 0;
+	unsynced = 0;
+	if (!writeAll(string(reinterpret_cast<const char *>(&header), sizeof(header)))) {
+		Output::stream() << "!Failed to write write-ahead log " << path << "." << endl;
+		return false;
+	}
+	return commit();
+}
+/*!
+ * \brief Number of the last record
+ *
+ * \return uint64_t sequence number of the last record made, or of the last
+ *         record held by a table file if none was made since
+ */
+uint64_t WriteAheadLog::lastLsn() const {
+	return nextLsn - 1;
+}
+/*!
+ * \brief Bytes waiting for a sync
+ *
+ * \return size_t number of bytes written since the last commit
+ */
+size_t WriteAheadLog::unsyncedSize() const {
+	return unsynced;
+}
+/*!
+ * \brief Length of the log
+ *
+ * \return size_t number of bytes in the log
+ */
+size_t WriteAheadLog::size() const {
+	return bytes;
+}
+/*!
+ * \brief Checksum of a block of bytes
+ *
+ * This function will compute the 32 bit FNV-1a hash of the bytes.
+ *
+ * \param[in] const char *data
+ *            Start of the bytes
+ * \param[in] size_t length
+ *            Number of bytes
+ * \return uint32_t checksum of the bytes
+ */
+uint32_t WriteAheadLog::checksum(const char *data, size_t length) {
+	uint32_t hash = 2166136261u; ///Running hash value
+
+	for (size_t i = 0; i < length; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+/*!
+ * \brief Flush a written file to disk
+ *
+ * Table and index files are synced before they are renamed into place,
+ * and their directory after, so a checkpoint is on disk before the log is
+ * emptied.
+ *
+ * \param[in] string path
+ *            String corresponding to the path of the file or directory
+ * \return boolean true if the file is on disk
+ */
+bool WriteAheadLog::syncFile(const string &path) {
+	int syncDescriptor = ::open(path.c_str(), O_RDONLY); ///Holds the open file
+
+	if (syncDescriptor < 0)
+		return false;
+	bool synced = fsync(syncDescriptor) == 0; ///Bool if the file reached the disk
+	::close(syncDescriptor);
+	return synced;
+}
+/*!
+ * \brief Read the records of the log
+ *
+ * This function will read the whole log and decode every complete record,
+ * stopping at the first record that is cut short, fails its checksum or is
+ * out of sequence. The records between a begin and a commit record are
+ * held back until the commit record carrying the number of the begin
+ * record is read, and are dropped if the log stops first. The begin and
+ * commit records themselves are not returned.
+ *
+ * \param[out] vector<Record> records
+ *             Records read back in the order they were made
+ * \param[out] uint64_t lastLsn
+ *             Sequence number of the last record kept, or the one before the log starts
+ * \param[out] size_t logBytes
+ *             Length of the log as found
+ * \return size_t length of the log up to the last good record, 0 without a good header
+ */
+size_t WriteAheadLog::scan(vector<Record> &records, uint64_t &lastLsn, size_t &logBytes) const {
+	LogFileHeader header; ///Header read from the log
+	LogRecordHeader recordHeader; ///Header of the current record
+	size_t validBytes = 0; ///Length of the log up to the last good record
+	size_t readBytes = 0; ///Length of the log up to the last record read
+	uint64_t readLsn = 0; ///Sequence number of the last record read
+	uint64_t openTransaction = 0; ///Number of the begin record of the transaction read, 0 outside one
+	vector<Record> held; ///Records of the transaction read, waiting for its commit record
+	string log; ///Log contents
+
+	records.clear();
+	lastLsn = 0;
+
+	/** Read the whole log if there is one **/
+	ifstream logFile(path, ios::binary);
+	if (logFile.is_open())
+		log.assign(istreambuf_iterator<char>(logFile), istreambuf_iterator<char>());
+	logFile.close();
+	logBytes = log.size();
+
+	/** Check the header before trusting the records **/
+	if (log.size() >= sizeof(header)) {
+		memcpy(&header, log.data(), sizeof(header));
+		if (memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 && header.version == LOG_VERSION) {
+			validBytes = readBytes = sizeof(header);
+			lastLsn = readLsn = header.firstLsn - 1;
+		}
+	}
+
+	/** Read each complete record **/
+	while (readBytes > 0 && log.size() - readBytes >= sizeof(recordHeader)) {
+		Record record; ///Record read back
+		uint64_t lsn; ///Sequence number of the record
+		uint32_t kind; ///Kind of the record
+		uint32_t nameLength; ///Length of the table name
+		memcpy(&recordHeader, log.data() + readBytes, sizeof(recordHeader));
+		const char *cursor = log.data() + readBytes + sizeof(recordHeader); ///Start of the record
+		if (log.size() - readBytes - sizeof(recordHeader) < recordHeader.length ||
+			recordHeader.length < sizeof(lsn) + sizeof(kind) + sizeof(nameLength) ||
+			checksum(cursor, recordHeader.length) != recordHeader.checksum)
+			break;
+		const char *end = cursor + recordHeader.length; ///End of the record
+		memcpy(&lsn, cursor, sizeof(lsn));
+		memcpy(&kind, cursor + sizeof(lsn), sizeof(kind));
+		memcpy(&nameLength, cursor + sizeof(lsn) + sizeof(kind), sizeof(nameLength));
+		cursor += sizeof(lsn) + sizeof(kind) + sizeof(nameLength);
+		if (lsn <= readLsn || kind > COMMIT_TRANSACTION || (size_t)(end - cursor) < nameLength)
+			break;
+		record.lsn = lsn;
+		record.kind = static_cast<Kind>(kind);
+		record.table.assign(cursor, nameLength);
+		record.payload.assign(cursor + nameLength, end);
+		readBytes += sizeof(recordHeader) + recordHeader.length;
+		readLsn = lsn;
+
+		/** Hold the records of a transaction back until its commit record **/
+		if (record.kind == BEGIN_TRANSACTION) {
+			if (openTransaction != 0)
+				break;
+			openTransaction = lsn;
+			continue;
+		}
+		if (record.kind == COMMIT_TRANSACTION) {
+			uint64_t committed; ///Number of the begin record of the committed transaction
+			if (openTransaction == 0 || record.payload.size() != sizeof(committed))
+				break;
+			memcpy(&committed, record.payload.data(), sizeof(committed));
+			if (committed != openTransaction)
+				break;
+			move(held.begin(), held.end(), back_inserter(records));
+			held.clear();
+			openTransaction = 0;
+		}
+		else if (openTransaction != 0) {
+			held.push_back(move(record));
+			continue;
+		}
+		else
+			records.push_back(move(record));
+		validBytes = readBytes;
+		lastLsn = lsn;
+	}
+	return validBytes;
+}
+/*!
+ * \brief Write bytes at the end of the log
+ *
+ * \param[in] string data
+ *            Bytes to write
+ * \return boolean true if every byte was written
+ */
+bool WriteAheadLog::writeAll(const string &data) {
+	size_t written = 0; ///Number of bytes written so far
+
+	if (fileDescriptor < 0)
+		return false;
+	while (written < data.size()) {
+		ssize_t result = ::write(fileDescriptor, data.data() + written, data.size() - written); ///Bytes written by the call
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			return false;
+		written += result;
+	}
+	bytes += written;
+	unsynced += written;
+	return true;
+}
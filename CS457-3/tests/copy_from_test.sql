@@ -0,0 +1,19 @@
+--Bulk loading: COPY FROM reads the rows of a comma delimited file
+
+CREATE DATABASE CopyFromTest;
+USE CopyFromTest;
+create table Flight(id int, origin varchar(12), seats int, fare float);
+copy Flight from 'copy_from_test.csv';
+select * from Flight;
+select * from Flight where seats > 50;
+
+--Loading appends to the rows already there
+insert into Flight values(6,'Elko',12,210);
+copy Flight from 'copy_from_test.csv';
+select count(*) from Flight;
+
+--A bad value or a missing file fails without changing the table
+copy Flight from 'copy_from_test_bad.csv';
+copy Flight from 'missing.csv';
+select count(*) from Flight;
+.exit
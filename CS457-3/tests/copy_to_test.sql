@@ -0,0 +1,30 @@
+--Streaming export: COPY TO and SELECT ... INTO OUTFILE write files that load back
+
+CREATE DATABASE CopyToTest;
+USE CopyToTest;
+create table Flight(id int, origin varchar(12), seats int, fare float);
+insert into Flight values(1,'Reno',120,89.5);
+insert into Flight values(2,'Las Vegas',180,59.25);
+insert into Flight values(3,'Elko, NV',40,150);
+insert into Flight values(4,'',0,0);
+
+copy Flight to 'flights.csv';
+create table FlightCopy(id int, origin varchar(12), seats int, fare float);
+copy FlightCopy from 'flights.csv';
+select * from FlightCopy;
+
+--Tab delimited files
+copy Flight to 'flights.tsv' delimiter '\t';
+create table FlightTab(id int, origin varchar(12), seats int, fare float);
+copy FlightTab from 'flights.tsv' delimiter '\t';
+select * from FlightTab where seats > 50;
+
+--A select writes only its columns and rows
+select id, origin from Flight where fare < 100 into outfile 'cheap.csv';
+create table Cheap(id int, origin varchar(12));
+copy Cheap from 'cheap.csv';
+select * from Cheap;
+
+--Binary exports hold the schema and the rows
+copy Flight to 'flights.bin' format binary;
+.exit
@@ -0,0 +1,21 @@
+--Deletes remove every matching row in one pass and keep the rest in order
+
+CREATE DATABASE DeleteTest;
+USE DeleteTest;
+create table Log(id int, level varchar(5));
+insert into Log values(1,'info'), (2,'warn'), (3,'info'), (4,'info'), (5,'error'), (6,'info');
+
+--Neighbouring matches and a match at either end
+delete from Log where level = 'info';
+select * from Log;
+delete from Log where id > 100;
+insert into Log values(7,'info');
+select * from Log;
+delete from Log where id != 0;
+select * from Log;
+
+--A value invalid for its column is an error, as in a select, which ends the input
+insert into Log values(8,'warn');
+delete from Log where id = 'eight';
+select * from Log;
+.exit
@@ -0,0 +1,23 @@
+--Aggregates with and without GROUP BY
+
+CREATE DATABASE GroupTest;
+USE GroupTest;
+create table Sale(store varchar(8), item varchar(8), qty int, price float);
+insert into Sale values('North','pen',10,1.5);
+insert into Sale values('North','ink',2,7.25);
+insert into Sale values('South','pen',4,1.5);
+insert into Sale values('South','pad',6,3);
+insert into Sale values('South','pen',1,1.75);
+insert into Sale values('East','ink',3,7);
+
+select count(*), sum(qty), avg(price), min(qty), max(price) from Sale;
+select store, count(*), sum(qty) from Sale group by store;
+select store, item, sum(qty), max(price) from Sale group by store, item;
+select item, count(*), avg(qty) from Sale where price < 5 group by item;
+select store, count(*) from Sale group by store order by count(*) desc;
+
+--Aggregates of an empty table
+create table Empty(a int);
+select count(*), sum(a), min(a) from Empty;
+select a, count(*) from Empty group by a;
+.exit
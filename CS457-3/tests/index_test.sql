@@ -0,0 +1,37 @@
+--Indexes: create, use, keep up to date and drop
+
+CREATE DATABASE IndexTest;
+USE IndexTest;
+create table Product(id int, name varchar(10), price float);
+insert into Product values(1,'Gizmo',19.99);
+insert into Product values(2,'PowerGizmo',29.99);
+insert into Product values(3,'OneTouch',149.99);
+insert into Product values(4,'MultiTouch',199.99);
+insert into Product values(5,'SuperGizmo',49.99);
+
+create index ProductId on Product(id);
+create index ProductName on Product(name) using hash;
+--Names are unique across the tables of the database
+create index ProductId on Product(price);
+--The column must exist
+create index ProductCost on Product(cost);
+
+select * from Product where id = 3;
+select * from Product where id > 3;
+select * from Product where id <= 2;
+select * from Product where name = 'Gizmo';
+
+--The indexes follow updates, deletes and inserts
+update Product set id = 10 where name = 'Gizmo';
+delete from Product where id = 2;
+insert into Product values(6,'Gadget',9.99);
+select * from Product where id > 4;
+select * from Product where name = 'PowerGizmo';
+select * from Product where name = 'Gadget';
+
+drop index ProductName;
+drop index ProductName;
+select * from Product where name = 'Gadget';
+drop index ProductId;
+select * from Product where id >= 5;
+.exit
@@ -0,0 +1,30 @@
+--Joins of two and more tables, inner and outer
+
+CREATE DATABASE JoinTest;
+USE JoinTest;
+create table Employee(id int, name varchar(10), dept int);
+create table Dept(id int, title varchar(10));
+create table Sales(employeeID int, productID int);
+insert into Employee values(1,'Joe',10);
+insert into Employee values(2,'Jack',20);
+insert into Employee values(3,'Gill',30);
+insert into Dept values(10,'Toys');
+insert into Dept values(20,'Tools');
+insert into Dept values(40,'Books');
+insert into Sales values(1,344);
+insert into Sales values(1,355);
+insert into Sales values(2,544);
+
+select * from Employee E, Sales S where E.id = S.employeeID;
+select * from Employee E inner join Sales S on E.id = S.employeeID;
+select * from Employee E left outer join Sales S on E.id = S.employeeID;
+select * from Sales S right outer join Employee E on E.id = S.employeeID;
+select * from Employee E full outer join Dept D on E.dept = D.id;
+
+--Three tables, with commas and with joins
+select * from Employee E, Dept D, Sales S where E.dept = D.id and E.id = S.employeeID;
+select * from Employee E inner join Dept D on E.dept = D.id inner join Sales S on E.id = S.employeeID;
+select * from Employee E left outer join Dept D on E.dept = D.id left outer join Sales S on E.id = S.employeeID;
+select * from Employee E inner join Sales S on E.id = S.employeeID where S.productID > 350;
+select * from Dept D cross join Sales S where S.employeeID = 2;
+.exit
@@ -0,0 +1,23 @@
+--ORDER BY with and without LIMIT
+
+CREATE DATABASE OrderTest;
+USE OrderTest;
+create table Player(name varchar(8), team int, score float);
+insert into Player values('Ann',2,31.5);
+insert into Player values('Bob',1,12);
+insert into Player values('Cal',2,-4);
+insert into Player values('Dee',1,31.5);
+insert into Player values('Eve',3,0);
+insert into Player values('Fay',3,18.25);
+
+select * from Player order by score;
+select * from Player order by score desc, name;
+select name, team from Player order by team desc, score asc;
+select * from Player order by name desc limit 2;
+select * from Player order by score desc limit 3;
+select * from Player where team != 2 order by score limit 2;
+select * from Player limit 2;
+select * from Player order by score limit 0;
+--A limit too large to hold is a syntax error, which ends the input
+select * from Player limit 99999999999999999999999;
+.exit
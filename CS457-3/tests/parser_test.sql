@@ -0,0 +1,30 @@
+--Statements are read by the lexer and parser whatever their case, spacing and comments
+
+CREATE DATABASE ParserTest;
+use ParserTest;
+CREATE TABLE Item (id INT, name VARCHAR(6), code CHAR(3), price FLOAT);
+insert
+	into Item
+	values (1, 'pen', 'p1', 1.5), (2, 'it''s', 'p2', -2);
+INSERT INTO Item VALUES(3,'ink','p3',.5); -- a comment after a statement
+SELECT id, name FROM Item WHERE price > 0 AND NOT (name = 'ink');
+select * from Item where name = 'it''s' or id >= 3;
+--Values that do not fit their column
+insert into Item values(4, 'notebook', 'p4', 1);
+insert into Item values(4, 'pad', 'p4', 'cheap');
+.exit
+--@restart
+USE ParserTest;
+--A size of zero is a syntax error, which ends the input
+create table Zero(name char(0));
+--@restart
+USE ParserTest;
+--So is a size too large for a column
+create table Huge(name char(99999999999));
+--@restart
+USE ParserTest;
+create table Negative(name varchar(-4));
+--@restart
+USE ParserTest;
+select * from Item;
+.exit
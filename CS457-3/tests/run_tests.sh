@@ -0,0 +1,72 @@
+#!/bin/bash
+#
+# Runs every <name>_test.sql script in this directory and compares what the
+# program prints with <name>_test.expected.
+#
+# Usage: ./run_tests.sh [program]
+#        The program defaults to ../Debug/CS457-3.
+#
+# Each script runs in a directory of its own, holding only the data files
+# named after it, <name>_test*.csv. A script may be split into several runs
+# of the program with comment lines:
+#   --@restart                  starts the program again on the same files
+#   --@truncate database bytes  also cuts bytes off the end of the
+#                               write-ahead log of database first, as a
+#                               crash part way through a write would
+#
+
+TESTS=$(cd "$(dirname "$0")" && pwd)
+PROGRAM=$(realpath "${1:-$TESTS/../Debug/CS457-3}")
+FAILED=0
+
+if [ ! -x "$PROGRAM" ]; then
+	echo "!Failed to find the program $PROGRAM."
+	exit 1
+fi
+
+for script in "$TESTS"/*_test.sql; do
+	name=$(basename "$script" .sql)
+	work=$(mktemp -d)
+	segment=0
+	cp "$TESTS/$name"*.csv "$work" 2>/dev/null
+
+	# Split the script into one file per run of the program
+	while IFS= read -r line; do
+		case "$line" in
+		--@restart*|--@truncate*)
+			segment=$((segment + 1))
+			echo "$line" > "$work/marker$segment"
+			;;
+		*)
+			echo "$line" >> "$work/run$segment.sql"
+			;;
+		esac
+	done < "$script"
+
+	for run in $(seq 0 $segment); do
+		if [ -f "$work/marker$run" ]; then
+			read -r marker database bytes < "$work/marker$run"
+			if [ "$marker" = "--@truncate" ]; then
+				log="$work/Databases/$database/database.wal"
+				truncate -s "$(( $(stat -c %s "$log") - bytes ))" "$log"
+			fi
+			echo "--restart--" >> "$work/output"
+		fi
+		(cd "$work" && "$PROGRAM" < "run$run.sql" >> output 2>&1)
+	done
+
+	if diff -u "$TESTS/$name.expected" "$work/output" > "$work/diff"; then
+		echo "PASS $name"
+	else
+		echo "FAIL $name"
+		cat "$work/diff"
+		FAILED=$((FAILED + 1))
+	fi
+	rm -rf "$work"
+done
+
+if [ $FAILED -ne 0 ]; then
+	echo "$FAILED test(s) failed."
+	exit 1
+fi
+echo "All tests passed."
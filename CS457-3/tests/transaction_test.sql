@@ -0,0 +1,50 @@
+--Transactions: changes are kept by COMMIT and undone by ROLLBACK
+
+CREATE DATABASE TransactionTest;
+USE TransactionTest;
+create table Flights(seat int, status int);
+insert into Flights values(22,0);
+insert into Flights values(23,1);
+
+begin transaction;
+update Flights set status = 1 where seat = 22;
+select * from Flights;
+commit;
+select * from Flights;
+
+begin transaction;
+update Flights set status = 0 where seat = 23;
+insert into Flights values(24,0);
+delete from Flights where seat = 22;
+select * from Flights;
+rollback;
+select * from Flights;
+
+--Only one transaction is open at a time
+begin transaction;
+begin transaction;
+insert into Flights values(25,1);
+commit;
+commit;
+rollback;
+select * from Flights;
+
+--A rollback puts back the rows and the indexes as they were
+create index FlightSeat on Flights(seat);
+begin transaction;
+insert into Flights values(26,0);
+update Flights set seat = 30 where seat = 22;
+delete from Flights where seat = 23;
+select * from Flights where seat >= 22;
+rollback;
+select * from Flights where seat = 22;
+select * from Flights where seat > 22;
+insert into Flights values(27,0);
+update Flights set status = 0 where seat = 25;
+select * from Flights where seat >= 25;
+.exit
+--@restart
+USE TransactionTest;
+select * from Flights;
+select * from Flights where seat = 23;
+.exit
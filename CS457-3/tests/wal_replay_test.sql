@@ -0,0 +1,30 @@
+--Changes in the write-ahead log are replayed after a restart
+
+CREATE DATABASE ReplayTest;
+USE ReplayTest;
+create table Account(id int, owner varchar(8), balance float);
+create index AccountId on Account(id);
+insert into Account values(1,'Ann',100);
+insert into Account values(2,'Bob',50);
+checkpoint;
+insert into Account values(3,'Cal',75);
+update Account set balance = 125 where id = 1;
+delete from Account where id = 2;
+begin transaction;
+update Account set balance = 0 where id = 3;
+commit;
+begin transaction;
+insert into Account values(4,'Dee',10);
+.exit
+--@restart
+--The open transaction was never committed, so its insert is lost
+USE ReplayTest;
+select * from Account;
+select * from Account where id >= 3;
+insert into Account values(5,'Eve',60);
+.exit
+--@restart
+USE ReplayTest;
+select * from Account where id = 5;
+select * from Account;
+.exit
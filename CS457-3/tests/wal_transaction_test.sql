@@ -0,0 +1,32 @@
+--A transaction is replayed whole or not at all after a crash
+
+CREATE DATABASE TornTest;
+USE TornTest;
+create table A(id int, v int);
+create table B(id int, v int);
+insert into A values(1,0);
+insert into B values(1,0);
+begin transaction;
+update A set v = 1 where id = 1;
+update B set v = 1 where id = 1;
+commit;
+begin transaction;
+update A set v = 2 where id = 1;
+update B set v = 2 where id = 1;
+commit;
+.exit
+--@truncate TornTest 5
+--The commit record of the second transaction is torn, so neither update is replayed
+USE TornTest;
+select * from A;
+select * from B;
+begin transaction;
+update A set v = 3 where id = 1;
+insert into B values(2,3);
+commit;
+.exit
+--@restart
+USE TornTest;
+select * from A;
+select * from B;
+.exit
@@ -0,0 +1,23 @@
+--A log cut short by a crash replays the records that are whole
+
+CREATE DATABASE TruncatedTest;
+USE TruncatedTest;
+create table Account(id int, owner varchar(8), balance float);
+create index AccountId on Account(id);
+insert into Account values(1,'Ann',100);
+checkpoint;
+insert into Account values(2,'Bob',50);
+insert into Account values(3,'Cal',75);
+update Account set balance = 25 where id = 1;
+.exit
+--@truncate TruncatedTest 5
+--The update was the last record and is torn, so it is dropped
+USE TruncatedTest;
+select * from Account;
+select * from Account where id > 1;
+update Account set balance = 30 where id = 1;
+.exit
+--@restart
+USE TruncatedTest;
+select * from Account;
+.exit
@@ -0,0 +1,22 @@
+--Where clauses: comparisons combined with AND, OR, NOT and parentheses
+
+CREATE DATABASE WhereTest;
+USE WhereTest;
+create table Part(id int, name varchar(8), weight float, stock int);
+insert into Part values(1,'bolt',0.5,100), (2,'nut',0.25,250), (3,'gear',4,12), (4,'axle',12.5,3), (5,'cog',4,0);
+
+select * from Part where weight = 4;
+select * from Part where weight <> 4;
+select * from Part where stock <= 12 and not name = 'cog';
+select * from Part where (weight > 10 or stock > 200) and id != 4;
+select * from Part where not (id < 2 or id > 4);
+select * from Part where stock > id and weight < 1;
+
+update Part set stock = 50 where weight >= 4 and stock < 10;
+select * from Part;
+update Part set stock = 1 where name = 'none';
+
+--An unknown column is an error, as in a select, which ends the input
+update Part set stock = 0 where size > 1;
+select * from Part;
+.exit